@@ -0,0 +1,2234 @@
+// (c) Copyright 2017, Sean Connelly (@voidqk), http://syntheti.cc
+// MIT License
+// Project Home: https://github.com/voidqk/nvqm
+
+//
+// This file is used to run performance benchmarks against the NVQM C library
+//
+// It links against "nvqm.c", so compile with:
+//
+// $ clang -O2 -Wall -o bench bench.c nvqm.c -lm
+//
+// (optimization level 2, warn on anything, output to `bench`, the benchmark driver, the library,
+// and the math library)
+//
+// To measure the header-only mode, build without "nvqm.c" instead:
+//
+// $ clang -O2 -Wall -DNVQM_INLINE_ALL -o bench_inline bench.c -lm
+//
+
+#include "nvqm.h"
+#include "nvqm_ref.h"
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+static volatile float sink; // results are written here so the optimizer can't drop the work
+
+static double now(){
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static float rnd(){
+	return (float)rand() / RAND_MAX * 200.0f - 100.0f;
+}
+
+static void report(const char *name, double sec, size_t ops){
+	double ns = sec * 1e9 / ops;
+	printf("  %-28s %8.3f ns/op  %10.2f Mops/s\n", name, ns, ops / sec / 1e6);
+}
+
+static int bench_applymat4(){
+	const size_t count = 200000;
+	const int rounds = 200;
+	vec3 *pts = malloc(sizeof(vec3) * count);
+	vec3 *out1 = malloc(sizeof(vec3) * count);
+	vec3 *out2 = malloc(sizeof(vec3) * count);
+	if (pts == NULL || out1 == NULL || out2 == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++)
+		pts[i] = vec3_new(rnd(), rnd(), rnd());
+	mat4 m, p;
+	mat4_perspective(&p, TAU / 6.0f, 1920.0f, 1080.0f, 0.1f, 1000.0f);
+	mat4_lookat(&m, vec3_new(10.0f, 20.0f, 30.0f), vec3_new(0.0f, 0.0f, 0.0f), vec3_new(0.0f, 1.0f, 0.0f));
+	mat4_mul(&m, &p, &m);
+
+	printf("vec3_applymat4 over %d x %d points\n", rounds, (int)count);
+
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			out1[i] = vec3_applymat4(pts[i], &m);
+		sink = out1[r].v[0];
+	}
+	report("vec3_applymat4 (loop)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3_applymat4_array(out2, pts, &m, count);
+		sink = out2[r].v[0];
+	}
+	report("vec3_applymat4_array", now() - t, count * rounds);
+
+	size_t mismatch = 0;
+	for (size_t i = 0; i < count; i++){
+		if (memcmp(&out1[i], &out2[i], sizeof(vec3)) != 0)
+			mismatch++;
+	}
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3_applymat4affine_array(out2, pts, &m, count);
+		sink = out2[r].v[0];
+	}
+	report("vec3_applymat4affine_array", now() - t, count * rounds);
+
+	printf("\nMismatched results: %d\n", (int)mismatch);
+	free(pts);
+	free(out1);
+	free(out2);
+	return mismatch == 0 ? 0 : 1;
+}
+
+static int bench_mat4_mul(){
+	const int count = 1000;
+	const int rounds = 20000;
+	mat4 *ms = malloc(sizeof(mat4) * count);
+	if (ms == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (int i = 0; i < count; i++){
+		for (int j = 0; j < 16; j++)
+			ms[i].v[j] = rnd() * 0.01f;
+	}
+
+	printf("mat4_mul over %d x %d matrices\n", rounds, count);
+
+	// independent multiplies, like building world matrices for many objects
+	mat4 out;
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (int i = 1; i < count; i++){
+			mat4_mul(&out, &ms[i - 1], &ms[i]);
+			sink = out.v[i & 15];
+		}
+	}
+	report("mat4_mul (independent)", now() - t, (size_t)(count - 1) * rounds);
+
+	// dependent chain, like concatenating a hierarchy
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		mat4_identity(&out);
+		for (int i = 0; i < count; i++)
+			mat4_mul(&out, &out, &ms[i]);
+		sink = out.v[r & 15];
+	}
+	report("mat4_mul (chain, out == a)", now() - t, (size_t)count * rounds);
+
+	free(ms);
+	return 0;
+}
+
+static int bench_soa(){
+	const size_t count = 100000;
+	const int rounds = 500;
+	vec3 *pos = malloc(sizeof(vec3) * count);
+	vec3 *vel = malloc(sizeof(vec3) * count);
+	float *lanes = malloc(sizeof(float) * count * 6);
+	if (pos == NULL || vel == NULL || lanes == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		pos[i] = vec3_new(rnd(), rnd(), rnd());
+		vel[i] = vec3_new(rnd(), rnd(), rnd());
+	}
+	vec3soa spos = { lanes, lanes + count, lanes + count * 2 };
+	vec3soa svel = { lanes + count * 3, lanes + count * 4, lanes + count * 5 };
+	vec3soa_fromvec3(&spos, pos, count);
+	vec3soa_fromvec3(&svel, vel, count);
+	quat q = quat_axisang(vec3_new(1.0f, 2.0f, 3.0f), 0.001f);
+	mat4 m;
+	mat4_rottrans(&m, q, vec3_new(0.1f, 0.2f, 0.3f));
+
+	printf("AoS vs SoA over %d x %d elements\n", rounds, (int)count);
+
+	// particle step: pos += vel
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			pos[i] = vec3_add(pos[i], vel[i]);
+		sink = pos[r].v[0];
+	}
+	report("vec3_add (AoS)", now() - t, count * rounds);
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3soa_add(&spos, &spos, &svel, count);
+		sink = spos.x[r];
+	}
+	report("vec3soa_add", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			pos[i] = vec3_applyquat(pos[i], q);
+		sink = pos[r].v[0];
+	}
+	report("vec3_applyquat (AoS)", now() - t, count * rounds);
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3soa_applyquat(&spos, &spos, q, count);
+		sink = spos.x[r];
+	}
+	report("vec3soa_applyquat", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			pos[i] = vec3_applymat4(pos[i], &m);
+		sink = pos[r].v[0];
+	}
+	report("vec3_applymat4 (AoS)", now() - t, count * rounds);
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3soa_applymat4(&spos, &spos, &m, count);
+		sink = spos.x[r];
+	}
+	report("vec3soa_applymat4", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			vel[i] = vec3_normal(vel[i]);
+		sink = vel[r].v[0];
+	}
+	report("vec3_normal (AoS)", now() - t, count * rounds);
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3soa_normal(&svel, &svel, count);
+		sink = svel.x[r];
+	}
+	report("vec3soa_normal", now() - t, count * rounds);
+
+	free(pos);
+	free(vel);
+	free(lanes);
+	return 0;
+}
+
+static int bench_chain(){
+	const int count = 10000;
+	const int rounds = 1000;
+	vec3 *pos = malloc(sizeof(vec3) * count);
+	quat *rot = malloc(sizeof(quat) * count);
+	mat4 *world = malloc(sizeof(mat4) * count);
+	if (pos == NULL || rot == NULL || world == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (int i = 0; i < count; i++){
+		pos[i] = vec3_new(rnd(), rnd(), rnd());
+		rot[i] = quat_axisang(vec3_new(rnd(), rnd(), rnd()), rnd());
+	}
+	mat4 view, proj, vp;
+	mat4_perspective(&proj, TAU / 6.0f, 1920.0f, 1080.0f, 0.1f, 1000.0f);
+	mat4_lookat(&view, vec3_new(10.0f, 20.0f, 30.0f), vec3_new(0.0f, 0.0f, 0.0f),
+		vec3_new(0.0f, 1.0f, 0.0f));
+	mat4_mul(&vp, &proj, &view);
+
+#ifdef NVQM_INLINE_ALL
+	printf("transform chain over %d x %d objects (NVQM_INLINE_ALL)\n", rounds, count);
+#else
+	printf("transform chain over %d x %d objects (nvqm.c)\n", rounds, count);
+#endif
+
+	// each object: rotate, translate, scale, then parent to the previous object and project
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		mat4 parent;
+		mat4_identity(&parent);
+		for (int i = 0; i < count; i++){
+			mat4 local;
+			mat4_rottrans(&local, rot[i], pos[i]);
+			mat4_scale(&local, &local, vec3_new(1.0f, 1.0f, 1.0f));
+			mat4_mul(&parent, &parent, &local);
+			mat4_mul(&world[i], &vp, &parent);
+			if (i % 16 == 15)
+				mat4_identity(&parent); // keep values from growing without bound
+		}
+		sink = world[r % count].v[0];
+	}
+	report("rottrans/scale/mul x2", now() - t, (size_t)count * rounds);
+
+	free(pos);
+	free(rot);
+	free(world);
+	return 0;
+}
+
+static int bench_invert(){
+	const int count = 1000;
+	const int rounds = 20000;
+	mat4 *ms = malloc(sizeof(mat4) * count);
+	if (ms == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (int i = 0; i < count; i++){
+		quat q = quat_axisang(vec3_new(rnd(), rnd(), rnd()), rnd());
+		mat4_rottrans(&ms[i], q, vec3_new(rnd(), rnd(), rnd()));
+	}
+
+	printf("mat4 inverse of %d x %d rigid matrices\n", rounds, count);
+
+	#define BENCH_INVERT(name, func)                   \
+		do {                                           \
+			mat4 out;                                  \
+			double t = now();                          \
+			for (int r = 0; r < rounds; r++){          \
+				for (int i = 0; i < count; i++){       \
+					func(&out, &ms[i]);                \
+					sink = out.v[i & 15];              \
+				}                                      \
+			}                                          \
+			report(name, now() - t, (size_t)count * rounds); \
+		} while (0)
+	BENCH_INVERT("mat4_invert"       , mat4_invert       );
+	BENCH_INVERT("mat4_invert_affine", mat4_invert_affine);
+	BENCH_INVERT("mat4_invert_rigid" , mat4_invert_rigid );
+	BENCH_INVERT("mat4_invert_fast"  , mat4_invert_fast  );
+	#undef BENCH_INVERT
+
+	free(ms);
+	return 0;
+}
+
+static int bench_affine(){
+	const int count = 1000;
+	const int rounds = 20000;
+	mat4 *ms = malloc(sizeof(mat4) * count);
+	mat4x3 *m3 = malloc(sizeof(mat4x3) * count);
+	if (ms == NULL || m3 == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (int i = 0; i < count; i++){
+		quat q = quat_axisang(vec3_new(rnd(), rnd(), rnd()), rnd());
+		mat4_rottrans(&ms[i], q, vec3_new(rnd() * 0.01f, rnd() * 0.01f, rnd() * 0.01f));
+		mat4x3_mat4(&m3[i], &ms[i]);
+	}
+
+	printf("affine multiplies over %d x %d matrices\n", rounds, count);
+
+	mat4 out;
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (int i = 1; i < count; i++){
+			mat4_mul(&out, &ms[i - 1], &ms[i]);
+			sink = out.v[i & 15];
+		}
+	}
+	report("mat4_mul", now() - t, (size_t)(count - 1) * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (int i = 1; i < count; i++){
+			mat4_mul_affine(&out, &ms[i - 1], &ms[i]);
+			sink = out.v[i & 15];
+		}
+	}
+	report("mat4_mul_affine", now() - t, (size_t)(count - 1) * rounds);
+
+	mat4x3 out3;
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (int i = 1; i < count; i++){
+			mat4x3_mul(&out3, &m3[i - 1], &m3[i]);
+			sink = out3.v[i % 12];
+		}
+	}
+	report("mat4x3_mul", now() - t, (size_t)(count - 1) * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (int i = 0; i < count; i++){
+			mat4x3_invert(&out3, &m3[i]);
+			sink = out3.v[i % 12];
+		}
+	}
+	report("mat4x3_invert", now() - t, (size_t)count * rounds);
+
+	free(ms);
+	free(m3);
+	return 0;
+}
+
+static int bench_slerp(){
+	const size_t count = 10000; // bones
+	const int rounds = 2000;
+	quat *a = malloc(sizeof(quat) * count);
+	quat *b = malloc(sizeof(quat) * count);
+	quat *out = malloc(sizeof(quat) * count);
+	float *t = malloc(sizeof(float) * count);
+	if (a == NULL || b == NULL || out == NULL || t == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		a[i] = quat_axisang(vec3_normal(vec3_new(rnd(), rnd(), rnd())), rnd());
+		b[i] = quat_axisang(vec3_normal(vec3_new(rnd(), rnd(), rnd())), rnd());
+		t[i] = (rnd() + 100.0f) / 200.0f;
+	}
+
+	printf("quaternion blends over %d x %d pairs\n", rounds, (int)count);
+
+	double tm = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			out[i] = quat_slerp(a[i], b[i], t[i]);
+		sink = out[r].v[0];
+	}
+	report("quat_slerp (loop)", now() - tm, count * rounds);
+
+	tm = now();
+	for (int r = 0; r < rounds; r++){
+		quat_slerpv_array(out, a, b, t, count);
+		sink = out[r].v[0];
+	}
+	report("quat_slerpv_array", now() - tm, count * rounds);
+
+	tm = now();
+	for (int r = 0; r < rounds; r++){
+		quat_slerp_array(out, a, b, 0.3f, count);
+		sink = out[r].v[0];
+	}
+	report("quat_slerp_array", now() - tm, count * rounds);
+
+	tm = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			out[i] = quat_nlerp(a[i], b[i], t[i]);
+		sink = out[r].v[0];
+	}
+	report("quat_nlerp (loop)", now() - tm, count * rounds);
+
+	tm = now();
+	for (int r = 0; r < rounds; r++){
+		quat_nlerpv_array(out, a, b, t, count);
+		sink = out[r].v[0];
+	}
+	report("quat_nlerpv_array", now() - tm, count * rounds);
+
+	free(a);
+	free(b);
+	free(out);
+	free(t);
+	return 0;
+}
+
+static int bench_normal(){
+	const size_t count = 100000;
+	const int rounds = 500;
+	vec3 *a = malloc(sizeof(vec3) * count);
+	vec3 *out = malloc(sizeof(vec3) * count);
+	float *lanes = malloc(sizeof(float) * count * 3);
+	if (a == NULL || out == NULL || lanes == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++)
+		a[i] = vec3_new(rnd(), rnd(), rnd());
+	vec3soa sa = { lanes, lanes + count, lanes + count * 2 };
+
+	printf("vec3 normalization over %d x %d vectors\n", rounds, (int)count);
+
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			out[i] = vec3_normal(a[i]);
+		sink = out[r].v[0];
+	}
+	report("vec3_normal (loop)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			out[i] = vec3_fnormal(a[i]);
+		sink = out[r].v[0];
+	}
+	report("vec3_fnormal (loop)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3_fnormal_array(out, a, count);
+		sink = out[r].v[0];
+	}
+	report("vec3_fnormal_array", now() - t, count * rounds);
+
+	vec3soa_fromvec3(&sa, a, count);
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3soa_normal(&sa, &sa, count);
+		sink = sa.x[r];
+	}
+	report("vec3soa_normal", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		vec3soa_fnormal(&sa, &sa, count);
+		sink = sa.x[r];
+	}
+	report("vec3soa_fnormal", now() - t, count * rounds);
+
+	free(a);
+	free(out);
+	free(lanes);
+	return 0;
+}
+
+static int bench_hierarchy(){
+	const int count = 100000;
+	const int rounds = 200;
+	int *parent = malloc(sizeof(int) * count);
+	float *lanes = malloc(sizeof(float) * count * 10);
+	mat4 *world = malloc(sizeof(mat4) * count);
+	unsigned char *dirty = calloc(count, 1);
+	if (parent == NULL || lanes == NULL || world == NULL || dirty == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	hierarchy h = {
+		count, parent,
+		{ lanes            , lanes + count    , lanes + count * 2 },
+		{ lanes + count * 3, lanes + count * 4, lanes + count * 5, lanes + count * 6 },
+		{ lanes + count * 7, lanes + count * 8, lanes + count * 9 },
+		world, dirty
+	};
+	srand(1);
+	for (int i = 0; i < count; i++){
+		// a forest of 8-ary trees in breadth first order, about 6 levels deep
+		parent[i] = i < 8 ? -1 : i / 8 - 1;
+		quat q = quat_axisang(vec3_new(rnd(), rnd(), rnd()), rnd());
+		h.pos.x[i] = rnd();
+		h.pos.y[i] = rnd();
+		h.pos.z[i] = rnd();
+		h.rot.x[i] = q.v[0];
+		h.rot.y[i] = q.v[1];
+		h.rot.z[i] = q.v[2];
+		h.rot.w[i] = q.v[3];
+		h.scale.x[i] = h.scale.y[i] = h.scale.z[i] = 1.0f;
+	}
+
+	printf("transform hierarchy over %d x %d nodes\n", rounds, count);
+
+	// what a scene graph does without the hierarchy module: rebuild every node every frame
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (int i = 0; i < count; i++){
+			mat4 local;
+			mat4_rottrans(&local,
+				quat_new(h.rot.x[i], h.rot.y[i], h.rot.z[i], h.rot.w[i]),
+				vec3_new(h.pos.x[i], h.pos.y[i], h.pos.z[i]));
+			mat4_scale(&local, &local, vec3_new(h.scale.x[i], h.scale.y[i], h.scale.z[i]));
+			if (parent[i] < 0)
+				world[i] = local;
+			else
+				mat4_mul(&world[i], &world[parent[i]], &local);
+		}
+		sink = world[r].v[0];
+	}
+	report("rottrans/scale/mul (all)", now() - t, (size_t)count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		hierarchy_updateall(&h);
+		sink = world[r].v[0];
+	}
+	report("hierarchy_updateall", now() - t, (size_t)count * rounds);
+
+	// move a random selection of nodes each frame, and report the time per node in the hierarchy
+	static const int percent[] = { 5, 1 };
+	for (int p = 0; p < 2; p++){
+		int moved = count / 100 * percent[p];
+		size_t recomputed = 0;
+		double work = 0;
+		for (int r = 0; r < rounds; r++){
+			for (int j = 0; j < moved; j++){
+				int i = rand() % count;
+				h.pos.x[i] = rnd();
+				dirty[i] = 1;
+			}
+			// count what the update will touch, outside of the timing
+			for (int i = 0; i < count; i++){
+				if (dirty[i] || (parent[i] >= 0 && dirty[parent[i]] == 2))
+					dirty[i] = 2, recomputed++;
+			}
+			t = now();
+			hierarchy_update(&h);
+			work += now() - t;
+			sink = world[r].v[0];
+		}
+		char name[64];
+		sprintf(name, "hierarchy_update (%d%% moved)", percent[p]);
+		report(name, work, (size_t)count * rounds);
+		printf("    %.1f%% of nodes recomputed, including descendants\n",
+			100.0 * recomputed / ((double)count * rounds));
+	}
+
+	free(parent);
+	free(lanes);
+	free(world);
+	free(dirty);
+	return 0;
+}
+
+static int bench_cull(){
+	const size_t count = 500000;
+	const int rounds = 200;
+	float *lanes = malloc(sizeof(float) * count * 6);
+	uint32_t *mask = malloc(sizeof(uint32_t) * (count + 31) / 32);
+	if (lanes == NULL || mask == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	vec3soa center = { lanes, lanes + count, lanes + count * 2 };
+	vec3soa bmax = { lanes + count * 3, lanes + count * 4, lanes + count * 5 };
+	float *radius = lanes + count * 3;
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		center.x[i] = rnd();
+		center.y[i] = rnd();
+		center.z[i] = rnd();
+	}
+	mat4 view, proj, vp;
+	mat4_perspective(&proj, TAU / 6.0f, 1920.0f, 1080.0f, 0.1f, 1000.0f);
+	mat4_lookat(&view, vec3_new(10.0f, 20.0f, 30.0f), vec3_new(0.0f, 0.0f, 0.0f),
+		vec3_new(0.0f, 1.0f, 0.0f));
+	mat4_mul(&vp, &proj, &view);
+	frustum f;
+	frustum_frommat4(&f, &vp);
+
+	printf("frustum culling over %d x %d objects\n", rounds, (int)count);
+
+	for (size_t i = 0; i < count; i++)
+		radius[i] = (float)rand() / RAND_MAX * 5.0f;
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		frustum_cullspheres(mask, &f, &center, radius, count);
+		sink = (float)mask[r % ((count + 31) / 32)];
+	}
+	double sec = now() - t;
+	report("frustum_cullspheres", sec, count * rounds);
+	printf("    %.3f ms per %d objects\n", sec * 1e3 / rounds, (int)count);
+
+	// boxes from the centers to the centers plus a random size
+	for (size_t i = 0; i < count; i++){
+		bmax.x[i] = center.x[i] + (float)rand() / RAND_MAX * 5.0f;
+		bmax.y[i] = center.y[i] + (float)rand() / RAND_MAX * 5.0f;
+		bmax.z[i] = center.z[i] + (float)rand() / RAND_MAX * 5.0f;
+	}
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		frustum_cullaabbs(mask, &f, &center, &bmax, count);
+		sink = (float)mask[r % ((count + 31) / 32)];
+	}
+	sec = now() - t;
+	report("frustum_cullaabbs", sec, count * rounds);
+	printf("    %.3f ms per %d objects\n", sec * 1e3 / rounds, (int)count);
+
+	free(lanes);
+	free(mask);
+	return 0;
+}
+
+static int bench_sqrt(){
+	const size_t count = 100000;
+	const int rounds = 200;
+	xint *a = malloc(sizeof(xint) * count);
+	xvec3 *v = malloc(sizeof(xvec3) * count);
+	if (a == NULL || v == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		a[i] = (xint)(((uint32_t)rand() << 16 ^ (uint32_t)rand()) & 0x7FFFFFFF) >> (rand() % 24);
+		v[i] = xvec3_new(rand() % XINT(100) - XINT(50), rand() % XINT(100) - XINT(50),
+			rand() % XINT(100) - XINT(50));
+	}
+
+	printf("fixed point square roots over %d x %d values\n", rounds, (int)count);
+
+	uint32_t acc = 0; // unsigned so the sums can wrap
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)ref_xint_sqrt(a[i]);
+	}
+	report("bitwise search (old)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc -= (uint32_t)xint_sqrt(a[i]);
+	}
+	report("xint_sqrt", now() - t, count * rounds);
+	if (acc != 0)
+		printf("  results differ!\n");
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xvec3_len(v[i]);
+	}
+	report("xvec3_len", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xint_div(XINT1, xint_sqrt(a[i] | 1));
+	}
+	report("xint_div(XINT1, xint_sqrt)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xint_rsqrt(a[i] | 1);
+	}
+	report("xint_rsqrt", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xvec3_normal(v[i]).v[0];
+	}
+	report("xvec3_normal", now() - t, count * rounds);
+	sink = (float)acc;
+
+	free(a);
+	free(v);
+	return 0;
+}
+
+static xang old_xint_atan2(xint y, xint x){
+	// the polynomial xint_atan2 used before, with two divides, for comparison
+	static const xint c1 = XANG45, c2 = XANG135, c3 = 0x0080 << XANG__SHIFT,
+		c4 = 0x0280 << XANG__SHIFT;
+	if (y == 0 && x == 0)
+		return 0;
+	if (x == XINT1){
+		/* hard-code some atan2(y, 1) values at the limits */
+		if (y <= -42722234) return XANG270 + 1;
+		if (y >=  42722235) return XANG90 - 1;
+	}
+	xint abs_y = xint_abs(y);
+	xang angle;
+	if (x >= 0){
+		xint d = xint_add(x, abs_y);
+		if (d == 0)
+			return 0;
+		xint r = xint_div(xint_sub(x, abs_y), d);
+		xint r3 = xint_mul(xint_mul(r, r), r);
+		angle = (xang)xint_add(xint_sub(xint_mul(c3, r3), xint_mul(c4, r)), c1);
+	}
+	else{
+		xint d = xint_sub(abs_y, x);
+		if (d == 0)
+			return 0;
+		xint r = xint_div(xint_add(x, abs_y), d);
+		xint r3 = xint_mul(xint_mul(r, r), r);
+		angle = (xang)xint_add(xint_sub(xint_mul(c3, r3), xint_mul(c4, r)), c2);
+	}
+	if (y < 0)
+		return angle == 0 ? 0 : XANG360 - angle;
+	return angle;
+}
+
+static int bench_atan2(){
+	const size_t count = 100000;
+	const int rounds = 200;
+	xint *a = malloc(sizeof(xint) * count);
+	xint *b = malloc(sizeof(xint) * count);
+	if (a == NULL || b == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		a[i] = (xint)((uint32_t)rand() << 16 ^ (uint32_t)rand()) >> (rand() % 24);
+		b[i] = (xint)((uint32_t)rand() << 16 ^ (uint32_t)rand()) >> (rand() % 24);
+	}
+
+	printf("fixed point inverse trig over %d x %d values\n", rounds, (int)count);
+
+	uint32_t acc = 0;
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)old_xint_atan2(a[i], b[i]);
+	}
+	report("polynomial with divides (old)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xint_atan2(a[i], b[i]);
+	}
+	report("xint_atan2", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xint_acos(a[i] % XINT1);
+	}
+	report("xint_acos", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xint_asin(a[i] % XINT1);
+	}
+	report("xint_asin", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)num_atan2(xint_tofloat(a[i]), xint_tofloat(b[i]));
+	}
+	report("num_atan2 (float)", now() - t, count * rounds);
+	sink = (float)acc;
+
+	free(a);
+	free(b);
+	return 0;
+}
+
+static int bench_pow(){
+	// the time per call should not depend on the exponent
+	const size_t count = 100000;
+	const int rounds = 100;
+	xint *a = malloc(sizeof(xint) * count);
+	xint *b = malloc(sizeof(xint) * count * 3);
+	if (a == NULL || b == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		a[i] = XINT1 + rand() % XINT(2) - XINT1 / 2;
+		b[i] = rand() % XINT1;                     // fractions, like easing curves
+		b[count + i] = rand() % XINT(32);          // small whole and fractional exponents
+		b[count * 2 + i] = rand() % XINT(30000);   // huge exponents
+	}
+
+	printf("xint_pow over %d x %d values\n", rounds, (int)count);
+
+	static const char *names[3] = { "xint_pow, b in [0, 1)", "xint_pow, b in [0, 32)",
+		"xint_pow, b in [0, 30000)" };
+	uint32_t acc = 0;
+	for (int k = 0; k < 3; k++){
+		xint *e = b + count * k;
+		double t = now();
+		for (int r = 0; r < rounds; r++){
+			for (size_t i = 0; i < count; i++)
+				acc += (uint32_t)xint_pow(a[i], e[i]);
+		}
+		report(names[k], now() - t, count * rounds);
+	}
+	sink = (float)acc;
+
+	free(a);
+	free(b);
+	return 0;
+}
+
+static int bench_lut(){
+	// a dependent walk through a working set near the L1 size, with a sin/cos lookup of a random
+	// angle at each step: the lookups aren't on the walk's critical path, so the time per step
+	// shows how much the tables evict the working set, compare with -DNVQM_QUARTER_LUT
+	const size_t steps = 1 << 24;
+	const size_t sizes[4] = { 16, 32, 40, 64 }; // KB, in 64 byte lines
+	const size_t maxlines = 64 * 1024 / 64;
+	size_t *next = malloc(64 * maxlines);
+	size_t *order = malloc(sizeof(size_t) * maxlines);
+	xang *ang = malloc(sizeof(xang) * steps);
+	if (next == NULL || order == NULL || ang == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < steps; i++)
+		ang[i] = rand() % XANG360;
+
+#ifdef NVQM_QUARTER_LUT
+	size_t footprint = sizeof(xint_sin__qlut) + sizeof(xint_tan__qlut) + sizeof(xint_tan__pole);
+	const char *lut = "quarter wave";
+#else
+	size_t footprint = sizeof(xint_sin__lut) + sizeof(xint_tan__lut);
+	const char *lut = "full";
+#endif
+	printf("%s sin/tan tables, %d bytes, %d steps\n", lut, (int)footprint, (int)steps);
+
+	char name[64];
+	uint32_t acc = 0;
+	for (int k = 0; k < 4; k++){
+		// link the lines in a random cycle, 8 words per line
+		size_t lines = sizes[k] * 1024 / 64;
+		for (size_t i = 0; i < lines; i++)
+			order[i] = i;
+		for (size_t i = lines - 1; i > 0; i--){
+			size_t j = (size_t)rand() % (i + 1);
+			size_t tmp = order[i];
+			order[i] = order[j];
+			order[j] = tmp;
+		}
+		for (size_t i = 0; i < lines; i++)
+			next[order[i] * 8] = order[(i + 1) % lines] * 8;
+
+		for (int trig = 0; trig < 2; trig++){
+			size_t p = 0;
+			double t = now();
+			if (trig){
+				for (size_t i = 0; i < steps; i++){
+					p = next[p];
+					acc += (uint32_t)xint_sin(ang[i]) + (uint32_t)xint_cos(ang[i]);
+				}
+			}
+			else{
+				for (size_t i = 0; i < steps; i++){
+					p = next[p];
+					acc += (uint32_t)ang[i];
+				}
+			}
+			snprintf(name, sizeof(name), "walk %d KB%s", (int)sizes[k], trig ? " + sin/cos" : "");
+			report(name, now() - t, steps);
+			acc += (uint32_t)p;
+		}
+	}
+	sink = (float)acc;
+
+	free(next);
+	free(order);
+	free(ang);
+	return 0;
+}
+
+static int bench_xdot(){
+	// fixed-point matrix multiplies and transforms, compare with -DNVQM_XINT_ROUND_EACH
+	const size_t count = 10000;
+	const int rounds = 200;
+	xmat4 *m = malloc(sizeof(xmat4) * count);
+	xmat4 *out = malloc(sizeof(xmat4) * count);
+	xvec3 *v = malloc(sizeof(xvec3) * count);
+	if (m == NULL || out == NULL || v == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		for (int j = 0; j < 16; j++)
+			m[i].v[j] = rand() % XINT(4) - XINT(2);
+		v[i] = xvec3_new(rand() % XINT(100) - XINT(50), rand() % XINT(100) - XINT(50),
+			rand() % XINT(100) - XINT(50));
+	}
+
+#ifdef NVQM_XINT_ROUND_EACH
+	printf("fixed point sums of products, rounding each product, %d x %d\n", rounds, (int)count);
+#else
+	printf("fixed point sums of products, rounding once, %d x %d\n", rounds, (int)count);
+#endif
+
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			xmat4_mul(&out[i], &m[i], &m[(i + 1) % count]);
+	}
+	report("xmat4_mul", now() - t, count * rounds);
+
+	uint32_t acc = 0;
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++){
+			xvec3 p = xvec3_applymat4(v[i], &m[r % count]);
+			acc += (uint32_t)p.v[0] + (uint32_t)p.v[1] + (uint32_t)p.v[2];
+		}
+	}
+	report("xvec3_applymat4", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xvec3_dot(v[i], v[(i + r) % count]);
+	}
+	report("xvec3_dot", now() - t, count * rounds);
+	sink = (float)acc + (float)out[count / 2].v[5];
+
+	free(m);
+	free(out);
+	free(v);
+	return 0;
+}
+
+static int bench_xarray(){
+	// a lockstep tick over 50k entities: rotate each velocity by its orientation, scale it by the
+	// time step, and add it to the position
+	const size_t count = 50000;
+	const int rounds = 200;
+	const xint dt = XINT1 / 60;
+	xvec3 *pos = malloc(sizeof(xvec3) * count);
+	xvec3 *vel = malloc(sizeof(xvec3) * count);
+	xvec3 *tmp = malloc(sizeof(xvec3) * count);
+	xquat *rot = malloc(sizeof(xquat) * count);
+	xquat *spin = malloc(sizeof(xquat) * count);
+	if (pos == NULL || vel == NULL || tmp == NULL || rot == NULL || spin == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		pos[i] = xvec3_new(rand() % XINT(100) - XINT(50), rand() % XINT(100) - XINT(50),
+			rand() % XINT(100) - XINT(50));
+		vel[i] = xvec3_new(rand() % XINT(10) - XINT(5), rand() % XINT(10) - XINT(5),
+			rand() % XINT(10) - XINT(5));
+		rot[i] = xquat_naxisang(xvec3_new(0, XINT1, 0), (xang)(rand() % XANG360));
+		spin[i] = xquat_naxisang(xvec3_new(XINT1, 0, 0), (xang)(rand() % XANG45));
+	}
+
+	printf("fixed point entity update, %d x %d\n", rounds, (int)count);
+
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			pos[i] = xvec3_add(pos[i], xvec3_scale(xvec3_applyquat(vel[i], rot[i]), dt));
+	}
+	report("per-call tick", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		xvec3_applyquatv_array(tmp, vel, rot, count);
+		xvec3_scale_array(tmp, tmp, dt, count);
+		xvec3_add_array(pos, pos, tmp, count);
+	}
+	report("array tick", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			tmp[i] = xvec3_applyquat(vel[i], rot[i]);
+	}
+	report("xvec3_applyquat", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++)
+		xvec3_applyquatv_array(tmp, vel, rot, count);
+	report("xvec3_applyquatv_array", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			tmp[i] = xvec3_scale(vel[i], dt);
+	}
+	report("xvec3_scale", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++)
+		xvec3_scale_array(tmp, vel, dt, count);
+	report("xvec3_scale_array", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			rot[i] = xquat_mul(rot[i], spin[i]);
+	}
+	report("xquat_mul", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++)
+		xquat_mul_array(rot, rot, spin, count);
+	report("xquat_mul_array", now() - t, count * rounds);
+	sink = (float)pos[count / 2].v[0] + (float)tmp[count / 3].v[1] + (float)rot[count / 4].v[2];
+
+	free(pos);
+	free(vel);
+	free(tmp);
+	free(rot);
+	free(spin);
+	return 0;
+}
+
+static int bench_xdiv(){
+	// dividing many values by one divisor, with xint_div vs a prepared xrecip
+	const size_t count = 50000;
+	const int rounds = 200;
+	xvec3 *v = malloc(sizeof(xvec3) * count);
+	xvec3 *out = malloc(sizeof(xvec3) * count);
+	if (v == NULL || out == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		v[i] = xvec3_new(rand() % XINT(1000) - XINT(500), rand() % XINT(1000) - XINT(500),
+			rand() % XINT(1000) - XINT(500));
+	}
+	xint d = XINT(3) + rand() % XINT1; // not a constant, so the compiler can't do this itself
+
+	printf("fixed point division by a shared divisor, %d x %d\n", rounds, (int)count);
+
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			out[i] = xvec3_new(xint_div(v[i].v[0], d), xint_div(v[i].v[1], d), xint_div(v[i].v[2], d));
+	}
+	report("xint_div", now() - t, count * rounds * 3);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		xrecip rd = xrecip_new(d);
+		for (size_t i = 0; i < count; i++){
+			out[i] = xvec3_new(xint_div_by(v[i].v[0], &rd), xint_div_by(v[i].v[1], &rd),
+				xint_div_by(v[i].v[2], &rd));
+		}
+	}
+	report("xint_div_by", now() - t, count * rounds * 3);
+
+	t = now();
+	for (int r = 0; r < rounds; r++)
+		xvec3_divs_array(out, v, d, count);
+	report("xvec3_divs_array", now() - t, count * rounds * 3);
+
+	uint32_t acc = 0;
+	t = now();
+	for (int r = 0; r < rounds * 100; r++){
+		xrecip rd = xrecip_new(d + r);
+		acc += rd.mlo;
+	}
+	report("xrecip_new", now() - t, rounds * 100);
+	sink = (float)acc + (float)out[count / 2].v[1];
+
+	free(v);
+	free(out);
+	return 0;
+}
+
+static int bench_xlong(){
+	// wide fixed point distances and determinants vs the xint versions
+	const size_t count = 10000;
+	const int rounds = 200;
+	xvec3 *v = malloc(sizeof(xvec3) * count);
+	xmat4 *m = malloc(sizeof(xmat4) * count);
+	if (v == NULL || m == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (size_t i = 0; i < count; i++){
+		v[i] = xvec3_new(rand() % XINT(8000) - XINT(4000), rand() % XINT(8000) - XINT(4000),
+			rand() % XINT(8000) - XINT(4000));
+		for (int j = 0; j < 16; j++)
+			m[i].v[j] = rand() % XINT(4) - XINT(2);
+	}
+
+	printf("fixed point Q32.32 functions, %d x %d\n", rounds, (int)count);
+
+	uint64_t acc = 0;
+	double t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xvec3_dist(v[i], v[(i + r) % count]);
+	}
+	report("xvec3_dist (overflows)", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint64_t)xvec3_dist2l(v[i], v[(i + r) % count]);
+	}
+	report("xvec3_dist2l", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint64_t)xvec3_distl(v[i], v[(i + r) % count]);
+	}
+	report("xvec3_distl", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint64_t)xlong_mul(xvec3_len2l(v[i]), xvec3_len2l(v[(i + r) % count]));
+	}
+	report("xlong_mul", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint64_t)xlong_div(xvec3_len2l(v[i]), xvec3_len2l(v[(i + r) % count]) | 1);
+	}
+	report("xlong_div", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint32_t)xmat4_det(&m[i]);
+	}
+	report("xmat4_det", now() - t, count * rounds);
+
+	t = now();
+	for (int r = 0; r < rounds; r++){
+		for (size_t i = 0; i < count; i++)
+			acc += (uint64_t)xmat4_detl(&m[i]);
+	}
+	report("xmat4_detl", now() - t, count * rounds);
+	sink = (float)acc;
+
+	free(v);
+	free(m);
+	return 0;
+}
+
+// micro benchmarks of every function, one at a time, on MICRO_N random inputs that stay in cache
+// each call reads input i and a second input j that shifts every round, and writes its whole result
+// to out[i], so calls are independent of each other, and rounds can't be folded together
+// array functions are called once per round on all MICRO_N elements, and timed per element
+// the float inputs are the fixed-point inputs converted exactly, so each float/fixed pair of
+// functions sees the same values, and `bench pairs` can compare their results
+#define MICRO_N    1024
+#define MICRO_MASK (MICRO_N - 1)
+
+static struct {
+	float   f[MICRO_N], u[MICRO_N], p[MICRO_N], t[MICRO_N], s[MICRO_N]; // any, [-1, 1], > 0, [0, 1], small
+	float   fa[MICRO_N];              // the angles in `a`, in radians
+	double  d[MICRO_N];
+	int     n[MICRO_N];
+	vec2    v2[MICRO_N];
+	vec3    v3[MICRO_N], n3[MICRO_N]; // n3 is normalized
+	vec3    e3[MICRO_N];              // euler angles in radians
+	vec4    v4[MICRO_N];
+	quat    q[MICRO_N], qb[MICRO_N];
+	mat2    m2[MICRO_N];
+	mat3x2  m32[MICRO_N];
+	mat3    m3[MICRO_N];
+	mat4    m4[MICRO_N];
+	mat4x3  m43[MICRO_N];
+	frustum fr[MICRO_N];
+	xint    x[MICRO_N], xu[MICRO_N], xp[MICRO_N], xt[MICRO_N], xs[MICRO_N]; // like the floats
+	xang    a[MICRO_N];
+	xlong   l[MICRO_N];
+	xrecip  r[MICRO_N];
+	xvec2   xv2[MICRO_N];
+	xvec3   xv3[MICRO_N], xv3b[MICRO_N], xn3[MICRO_N];
+	xvec3   xe3[MICRO_N];             // euler angles as xang
+	xvec4   xv4[MICRO_N];
+	xquat   xq[MICRO_N], xqb[MICRO_N];
+	xmat2   xm2[MICRO_N];
+	xmat3x2 xm32[MICRO_N];
+	xmat3   xm3[MICRO_N];
+	xmat4   xm4[MICRO_N];
+} in;
+
+static union {
+	float    f[MICRO_N];
+	double   d[MICRO_N];
+	int      n[MICRO_N];
+	uint32_t u[MICRO_N];
+	vec2     v2[MICRO_N];
+	vec3     v3[MICRO_N];
+	vec4     v4[MICRO_N];
+	quat     q[MICRO_N];
+	mat2     m2[MICRO_N];
+	mat3x2   m32[MICRO_N];
+	mat3     m3[MICRO_N];
+	mat4     m4[MICRO_N];
+	mat4x3   m43[MICRO_N];
+	frustum  fr[MICRO_N];
+	xint     x[MICRO_N];
+	xang     a[MICRO_N];
+	xlong    l[MICRO_N];
+	xrecip   r[MICRO_N];
+	xvec2    xv2[MICRO_N];
+	xvec3    xv3[MICRO_N];
+	xvec4    xv4[MICRO_N];
+	xquat    xq[MICRO_N];
+	xmat2    xm2[MICRO_N];
+	xmat3x2  xm32[MICRO_N];
+	xmat3    xm3[MICRO_N];
+	xmat4    xm4[MICRO_N];
+} out;
+
+static float soa_in[8][MICRO_N], soa_out[4][MICRO_N];
+static vec3soa in_s3a, in_s3b, out_s3;
+static vec4soa in_s4a, in_s4b, out_s4;
+static quatsoa in_sqa, in_sqb, out_sq;
+
+static xint rndx(){
+	// nonzero, and small enough that sums of squares of 4 still fit
+	return xint_fromfloat(rnd() * 0.5f) | 1;
+}
+
+static void micro_init(){
+	// the fixed-point values are picked first, and the float values are converted from them
+	srand(1);
+	mat4 proj, vp;
+	mat4_perspective(&proj, TAU / 6.0f, 1920.0f, 1080.0f, 0.1f, 1000.0f);
+	for (int i = 0; i < MICRO_N; i++){
+		in.x[i] = rndx();
+		in.xu[i] = rand() % (2 * XINT1 + 1) - XINT1;
+		in.xp[i] = xint_fromfloat(num_abs(rnd()) * 0.5f) | 1;
+		in.xt[i] = rand() % (XINT1 + 1);
+		in.xs[i] = xint_fromfloat(rnd() * 0.04f);
+		in.a[i] = rand() % XANG360;
+		in.f[i] = xint_tofloat(in.x[i]);
+		in.u[i] = xint_tofloat(in.xu[i]);
+		in.p[i] = xint_tofloat(in.xp[i]);
+		in.t[i] = xint_tofloat(in.xt[i]);
+		in.s[i] = xint_tofloat(in.xs[i]);
+		in.fa[i] = xang_tofloat(in.a[i]);
+		in.d[i] = in.f[i];
+		in.n[i] = xint_toint(in.x[i]);
+		in.l[i] = xlong_fromdouble(rnd() * 1000.0) | 1;
+		in.r[i] = xrecip_new(in.xp[i]);
+
+		in.xv2[i] = xvec2_new(rndx(), rndx());
+		in.xv3[i] = xvec3_new(rndx(), rndx(), rndx());
+		in.xv3b[i] = xvec3_new(rndx(), rndx(), rndx());
+		in.xv4[i] = xvec4_new(rndx(), rndx(), rndx(), rndx());
+		in.xe3[i] = xvec3_new(rand() % XANG360, rand() % XANG360, rand() % XANG360);
+		in.xn3[i] = xvec3_fromvec3(vec3_normal(vec3_new(rnd(), rnd(), rnd())));
+		in.xq[i] = xquat_fromquat(quat_normal(quat_new(rnd(), rnd(), rnd(), rnd())));
+		in.xqb[i] = xquat_fromquat(quat_normal(quat_new(rnd(), rnd(), rnd(), rnd())));
+		in.v2[i] = xvec2_tovec2(in.xv2[i]);
+		in.v3[i] = xvec3_tovec3(in.xv3[i]);
+		in.v4[i] = xvec4_tovec4(in.xv4[i]);
+		in.n3[i] = xvec3_tovec3(in.xn3[i]);
+		in.q[i] = xquat_toquat(in.xq[i]);
+		in.qb[i] = xquat_toquat(in.xqb[i]);
+		for (int k = 0; k < 3; k++)
+			in.e3[i].v[k] = xang_tofloat(in.xe3[i].v[k]);
+
+		// well conditioned transforms: rotation, scale in [0.5, 2], and translation, rounded to
+		// fixed-point
+		vec3 scale = vec3_new(1.25f + rnd() * 0.0075f, 1.25f + rnd() * 0.0075f, 1.25f + rnd() * 0.0075f);
+		vec2 scale2 = vec2_new(scale.v[0], scale.v[1]);
+		in.xm2[i] = xmat2_frommat2(mat2_scale(mat2_rotation(in.fa[i]), scale2));
+		in.xm32[i] = xmat3x2_frommat3x2(
+			mat3x2_translate(mat3x2_scale(mat3x2_rotation(in.fa[i]), scale2), in.v2[i]));
+		mat3_translate(&in.m3[i], mat3_scale(&in.m3[i], mat3_rotation(&in.m3[i], in.fa[i]), scale2),
+			in.v2[i]);
+		mat4_scale(&in.m4[i], mat4_rottrans(&in.m4[i], in.q[i], in.v3[i]), scale);
+		for (int k = 0; k < 9; k++)
+			in.xm3[i].v[k] = xint_fromfloat(in.m3[i].v[k]);
+		for (int k = 0; k < 16; k++)
+			in.xm4[i].v[k] = xint_fromfloat(in.m4[i].v[k]);
+		in.m2[i] = xmat2_tomat2(in.xm2[i]);
+		in.m32[i] = xmat3x2_tomat3x2(in.xm32[i]);
+		for (int k = 0; k < 9; k++)
+			in.m3[i].v[k] = xint_tofloat(in.xm3[i].v[k]);
+		for (int k = 0; k < 16; k++)
+			in.m4[i].v[k] = xint_tofloat(in.xm4[i].v[k]);
+		mat4x3_mat4(&in.m43[i], &in.m4[i]);
+		mat4_mul(&vp, &proj, &in.m4[i]);
+		frustum_frommat4(&in.fr[i], &vp);
+
+		for (int k = 0; k < 4; k++){
+			soa_in[k][i] = in.q[i].v[k];
+			soa_in[k + 4][i] = in.qb[i].v[k];
+		}
+	}
+	in_s3a = (vec3soa){ soa_in[0], soa_in[1], soa_in[2] };
+	in_s3b = (vec3soa){ soa_in[4], soa_in[5], soa_in[6] };
+	out_s3 = (vec3soa){ soa_out[0], soa_out[1], soa_out[2] };
+	in_s4a = (vec4soa){ soa_in[0], soa_in[1], soa_in[2], soa_in[3] };
+	in_s4b = (vec4soa){ soa_in[4], soa_in[5], soa_in[6], soa_in[7] };
+	out_s4 = (vec4soa){ soa_out[0], soa_out[1], soa_out[2], soa_out[3] };
+	in_sqa = (quatsoa){ soa_in[0], soa_in[1], soa_in[2], soa_in[3] };
+	in_sqb = (quatsoa){ soa_in[4], soa_in[5], soa_in[6], soa_in[7] };
+	out_sq = (quatsoa){ soa_out[0], soa_out[1], soa_out[2], soa_out[3] };
+}
+
+// X(name, result, statement) is called for each input i, where `out.result` is written, and
+// Y(name, statement) is called once per round r
+// the hierarchy functions need a scene, so they're left to `bench hierarchy`
+#define MICRO_FUNCS(X, Y) \
+	X(vec2_add                  , v2,   out.v2[i] = vec2_add(in.v2[i], in.v2[j])) \
+	X(vec2_applymat2            , v2,   out.v2[i] = vec2_applymat2(in.v2[i], in.m2[j])) \
+	X(vec2_applymat3            , v2,   out.v2[i] = vec2_applymat3(in.v2[i], &in.m3[j])) \
+	X(vec2_applymat3x2          , v2,   out.v2[i] = vec2_applymat3x2(in.v2[i], in.m32[j])) \
+	X(vec2_applymat4            , v2,   out.v2[i] = vec2_applymat4(in.v2[i], &in.m4[j])) \
+	X(vec2_clamp                , v2,   out.v2[i] = vec2_clamp(in.v2[i], in.v2[j], in.v2[i ^ 1])) \
+	X(vec2_cross                , f,    out.f[i] = vec2_cross(in.v2[i], in.v2[j])) \
+	X(vec2_dist                 , f,    out.f[i] = vec2_dist(in.v2[i], in.v2[j])) \
+	X(vec2_dist2                , f,    out.f[i] = vec2_dist2(in.v2[i], in.v2[j])) \
+	X(vec2_div                  , v2,   out.v2[i] = vec2_div(in.v2[i], in.v2[j])) \
+	X(vec2_dot                  , f,    out.f[i] = vec2_dot(in.v2[i], in.v2[j])) \
+	X(vec2_fnormal              , v2,   out.v2[i] = vec2_fnormal(in.v2[i])) \
+	X(vec2_inverse              , v2,   out.v2[i] = vec2_inverse(in.v2[i])) \
+	X(vec2_len                  , f,    out.f[i] = vec2_len(in.v2[i])) \
+	X(vec2_len2                 , f,    out.f[i] = vec2_len2(in.v2[i])) \
+	X(vec2_lerp                 , v2,   out.v2[i] = vec2_lerp(in.v2[i], in.v2[j], in.t[i ^ 1])) \
+	X(vec2_max                  , v2,   out.v2[i] = vec2_max(in.v2[i], in.v2[j])) \
+	X(vec2_min                  , v2,   out.v2[i] = vec2_min(in.v2[i], in.v2[j])) \
+	X(vec2_mul                  , v2,   out.v2[i] = vec2_mul(in.v2[i], in.v2[j])) \
+	X(vec2_neg                  , v2,   out.v2[i] = vec2_neg(in.v2[i])) \
+	X(vec2_new                  , v2,   out.v2[i] = vec2_new(in.f[i], in.f[j])) \
+	X(vec2_normal               , v2,   out.v2[i] = vec2_normal(in.v2[i])) \
+	X(vec2_scale                , v2,   out.v2[i] = vec2_scale(in.v2[i], in.f[j])) \
+	X(vec2_sub                  , v2,   out.v2[i] = vec2_sub(in.v2[i], in.v2[j])) \
+	X(vec3_add                  , v3,   out.v3[i] = vec3_add(in.v3[i], in.v3[j])) \
+	X(vec3_angle                , f,    out.f[i] = vec3_angle(in.v3[i], in.v3[j])) \
+	X(vec3_applymat3            , v3,   out.v3[i] = vec3_applymat3(in.v3[i], &in.m3[j])) \
+	X(vec3_applymat3x2          , v3,   out.v3[i] = vec3_applymat3x2(in.v3[i], in.m32[j])) \
+	X(vec3_applymat4            , v3,   out.v3[i] = vec3_applymat4(in.v3[i], &in.m4[j])) \
+	Y(vec3_applymat4_array      , vec3_applymat4_array(out.v3, in.v3, &in.m4[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(vec3_applymat4affine_array, vec3_applymat4affine_array(out.v3, in.v3, \
+			&in.m4[r & MICRO_MASK], MICRO_N)) \
+	X(vec3_applymat4x3          , v3,   out.v3[i] = vec3_applymat4x3(in.v3[i], &in.m43[j])) \
+	X(vec3_applyquat            , v3,   out.v3[i] = vec3_applyquat(in.v3[i], in.q[j])) \
+	X(vec3_clamp                , v3,   out.v3[i] = vec3_clamp(in.v3[i], in.v3[j], in.v3[i ^ 1])) \
+	X(vec3_cross                , v3,   out.v3[i] = vec3_cross(in.v3[i], in.v3[j])) \
+	X(vec3_dist                 , f,    out.f[i] = vec3_dist(in.v3[i], in.v3[j])) \
+	X(vec3_dist2                , f,    out.f[i] = vec3_dist2(in.v3[i], in.v3[j])) \
+	X(vec3_div                  , v3,   out.v3[i] = vec3_div(in.v3[i], in.v3[j])) \
+	X(vec3_dot                  , f,    out.f[i] = vec3_dot(in.v3[i], in.v3[j])) \
+	X(vec3_fnormal              , v3,   out.v3[i] = vec3_fnormal(in.v3[i])) \
+	Y(vec3_fnormal_array        , vec3_fnormal_array(out.v3, in.v3, MICRO_N)) \
+	X(vec3_inverse              , v3,   out.v3[i] = vec3_inverse(in.v3[i])) \
+	X(vec3_len                  , f,    out.f[i] = vec3_len(in.v3[i])) \
+	X(vec3_len2                 , f,    out.f[i] = vec3_len2(in.v3[i])) \
+	X(vec3_lerp                 , v3,   out.v3[i] = vec3_lerp(in.v3[i], in.v3[j], in.t[i ^ 1])) \
+	X(vec3_max                  , v3,   out.v3[i] = vec3_max(in.v3[i], in.v3[j])) \
+	X(vec3_min                  , v3,   out.v3[i] = vec3_min(in.v3[i], in.v3[j])) \
+	X(vec3_mul                  , v3,   out.v3[i] = vec3_mul(in.v3[i], in.v3[j])) \
+	X(vec3_nangle               , f,    out.f[i] = vec3_nangle(in.n3[i], in.n3[j])) \
+	X(vec3_neg                  , v3,   out.v3[i] = vec3_neg(in.v3[i])) \
+	X(vec3_new                  , v3,   out.v3[i] = vec3_new(in.f[i], in.f[j], in.f[i ^ 1])) \
+	X(vec3_normal               , v3,   out.v3[i] = vec3_normal(in.v3[i])) \
+	X(vec3_orthogonal           , v3,   out.v3[i] = vec3_orthogonal(in.v3[i], in.v3[j])) \
+	X(vec3_scale                , v3,   out.v3[i] = vec3_scale(in.v3[i], in.f[j])) \
+	X(vec3_sub                  , v3,   out.v3[i] = vec3_sub(in.v3[i], in.v3[j])) \
+	X(vec4_add                  , v4,   out.v4[i] = vec4_add(in.v4[i], in.v4[j])) \
+	X(vec4_applymat4            , v4,   out.v4[i] = vec4_applymat4(in.v4[i], &in.m4[j])) \
+	X(vec4_applyquat            , v4,   out.v4[i] = vec4_applyquat(in.v4[i], in.q[j])) \
+	X(vec4_clamp                , v4,   out.v4[i] = vec4_clamp(in.v4[i], in.v4[j], in.v4[i ^ 1])) \
+	X(vec4_dist                 , f,    out.f[i] = vec4_dist(in.v4[i], in.v4[j])) \
+	X(vec4_dist2                , f,    out.f[i] = vec4_dist2(in.v4[i], in.v4[j])) \
+	X(vec4_div                  , v4,   out.v4[i] = vec4_div(in.v4[i], in.v4[j])) \
+	X(vec4_dot                  , f,    out.f[i] = vec4_dot(in.v4[i], in.v4[j])) \
+	X(vec4_fnormal              , v4,   out.v4[i] = vec4_fnormal(in.v4[i])) \
+	Y(vec4_fnormal_array        , vec4_fnormal_array(out.v4, in.v4, MICRO_N)) \
+	X(vec4_inverse              , v4,   out.v4[i] = vec4_inverse(in.v4[i])) \
+	X(vec4_len                  , f,    out.f[i] = vec4_len(in.v4[i])) \
+	X(vec4_len2                 , f,    out.f[i] = vec4_len2(in.v4[i])) \
+	X(vec4_lerp                 , v4,   out.v4[i] = vec4_lerp(in.v4[i], in.v4[j], in.t[i ^ 1])) \
+	X(vec4_max                  , v4,   out.v4[i] = vec4_max(in.v4[i], in.v4[j])) \
+	X(vec4_min                  , v4,   out.v4[i] = vec4_min(in.v4[i], in.v4[j])) \
+	X(vec4_mul                  , v4,   out.v4[i] = vec4_mul(in.v4[i], in.v4[j])) \
+	X(vec4_neg                  , v4,   out.v4[i] = vec4_neg(in.v4[i])) \
+	X(vec4_new                  , v4,   out.v4[i] = vec4_new(in.f[i], in.f[j], in.f[i ^ 1], \
+			in.f[j ^ 1])) \
+	X(vec4_normal               , v4,   out.v4[i] = vec4_normal(in.v4[i])) \
+	X(vec4_scale                , v4,   out.v4[i] = vec4_scale(in.v4[i], in.f[j])) \
+	X(vec4_sub                  , v4,   out.v4[i] = vec4_sub(in.v4[i], in.v4[j])) \
+	X(quat_axisang              , q,    out.q[i] = quat_axisang(in.v3[i], in.fa[j])) \
+	X(quat_between              , q,    out.q[i] = quat_between(in.v3[i], in.v3[j])) \
+	X(quat_dot                  , f,    out.f[i] = quat_dot(in.q[i], in.q[j])) \
+	X(quat_euler_xyz            , q,    out.q[i] = quat_euler_xyz(in.e3[i])) \
+	X(quat_euler_xzy            , q,    out.q[i] = quat_euler_xzy(in.e3[i])) \
+	X(quat_euler_yxz            , q,    out.q[i] = quat_euler_yxz(in.e3[i])) \
+	X(quat_euler_yzx            , q,    out.q[i] = quat_euler_yzx(in.e3[i])) \
+	X(quat_euler_zxy            , q,    out.q[i] = quat_euler_zxy(in.e3[i])) \
+	X(quat_euler_zyx            , q,    out.q[i] = quat_euler_zyx(in.e3[i])) \
+	X(quat_fnormal              , q,    out.q[i] = quat_fnormal(in.q[i])) \
+	Y(quat_fnormal_array        , quat_fnormal_array(out.q, in.q, MICRO_N)) \
+	X(quat_identity             , q,    out.q[i] = quat_identity()) \
+	X(quat_invert               , q,    out.q[i] = quat_invert(in.q[i])) \
+	X(quat_lerp                 , q,    out.q[i] = quat_lerp(in.q[i], in.q[j], in.t[i ^ 1])) \
+	X(quat_mul                  , q,    out.q[i] = quat_mul(in.q[i], in.q[j])) \
+	X(quat_naxisang             , q,    out.q[i] = quat_naxisang(in.n3[i], in.fa[j])) \
+	X(quat_nbetween             , q,    out.q[i] = quat_nbetween(in.n3[i], in.n3[j])) \
+	X(quat_neg                  , q,    out.q[i] = quat_neg(in.q[i])) \
+	X(quat_new                  , q,    out.q[i] = quat_new(in.f[i], in.f[j], in.f[i ^ 1], \
+			in.f[j ^ 1])) \
+	X(quat_nlerp                , q,    out.q[i] = quat_nlerp(in.q[i], in.q[j], in.t[i ^ 1])) \
+	Y(quat_nlerp_array          , quat_nlerp_array(out.q, in.q, in.qb, in.t[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(quat_nlerpv_array         , quat_nlerpv_array(out.q, in.q, in.qb, in.t, MICRO_N)) \
+	X(quat_normal               , q,    out.q[i] = quat_normal(in.q[i])) \
+	X(quat_slerp                , q,    out.q[i] = quat_slerp(in.q[i], in.q[j], in.t[i ^ 1])) \
+	Y(quat_slerp_array          , quat_slerp_array(out.q, in.q, in.qb, in.t[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(quat_slerpv_array         , quat_slerpv_array(out.q, in.q, in.qb, in.t, MICRO_N)) \
+	X(mat2_add                  , m2,   out.m2[i] = mat2_add(in.m2[i], in.m2[j])) \
+	X(mat2_adjoint              , m2,   out.m2[i] = mat2_adjoint(in.m2[i])) \
+	X(mat2_compmul              , m2,   out.m2[i] = mat2_compmul(in.m2[i], in.m2[j])) \
+	X(mat2_det                  , f,    out.f[i] = mat2_det(in.m2[i])) \
+	X(mat2_identity             , m2,   out.m2[i] = mat2_identity()) \
+	X(mat2_invert               , m2,   out.m2[i] = mat2_invert(in.m2[i])) \
+	X(mat2_mul                  , m2,   out.m2[i] = mat2_mul(in.m2[i], in.m2[j])) \
+	X(mat2_new                  , m2,   out.m2[i] = mat2_new(in.f[i], in.f[j], in.f[i ^ 1], \
+			in.f[j ^ 1])) \
+	X(mat2_rotate               , m2,   out.m2[i] = mat2_rotate(in.m2[i], in.fa[j])) \
+	X(mat2_rotation             , m2,   out.m2[i] = mat2_rotation(in.fa[i])) \
+	X(mat2_scale                , m2,   out.m2[i] = mat2_scale(in.m2[i], in.v2[j])) \
+	X(mat2_scaling              , m2,   out.m2[i] = mat2_scaling(in.v2[i])) \
+	X(mat2_sub                  , m2,   out.m2[i] = mat2_sub(in.m2[i], in.m2[j])) \
+	X(mat2_transpose            , m2,   out.m2[i] = mat2_transpose(in.m2[i])) \
+	X(mat3x2_add                , m32,  out.m32[i] = mat3x2_add(in.m32[i], in.m32[j])) \
+	X(mat3x2_compmul            , m32,  out.m32[i] = mat3x2_compmul(in.m32[i], in.m32[j])) \
+	X(mat3x2_det                , f,    out.f[i] = mat3x2_det(in.m32[i])) \
+	X(mat3x2_identity           , m32,  out.m32[i] = mat3x2_identity()) \
+	X(mat3x2_invert             , m32,  out.m32[i] = mat3x2_invert(in.m32[i])) \
+	X(mat3x2_mul                , m32,  out.m32[i] = mat3x2_mul(in.m32[i], in.m32[j])) \
+	X(mat3x2_new                , m32,  out.m32[i] = mat3x2_new(in.f[i], in.f[j], in.f[i ^ 1], \
+			in.f[j ^ 1], in.f[i ^ 2], in.f[j ^ 2])) \
+	X(mat3x2_rotate             , m32,  out.m32[i] = mat3x2_rotate(in.m32[i], in.fa[j])) \
+	X(mat3x2_rotation           , m32,  out.m32[i] = mat3x2_rotation(in.fa[i])) \
+	X(mat3x2_scale              , m32,  out.m32[i] = mat3x2_scale(in.m32[i], in.v2[j])) \
+	X(mat3x2_scaling            , m32,  out.m32[i] = mat3x2_scaling(in.v2[i])) \
+	X(mat3x2_sub                , m32,  out.m32[i] = mat3x2_sub(in.m32[i], in.m32[j])) \
+	X(mat3x2_translate          , m32,  out.m32[i] = mat3x2_translate(in.m32[i], in.v2[j])) \
+	X(mat3x2_translation        , m32,  out.m32[i] = mat3x2_translation(in.v2[i])) \
+	X(mat3_add                  , m3,   mat3_add(&out.m3[i], &in.m3[i], &in.m3[j])) \
+	X(mat3_adjoint              , m3,   mat3_adjoint(&out.m3[i], &in.m3[i])) \
+	X(mat3_compmul              , m3,   mat3_compmul(&out.m3[i], &in.m3[i], &in.m3[j])) \
+	X(mat3_copy                 , m3,   mat3_copy(&out.m3[i], &in.m3[i])) \
+	X(mat3_det                  , f,    out.f[i] = mat3_det(&in.m3[i])) \
+	X(mat3_identity             , m3,   mat3_identity(&out.m3[i])) \
+	X(mat3_invert               , m3,   mat3_invert(&out.m3[i], &in.m3[i])) \
+	X(mat3_mul                  , m3,   mat3_mul(&out.m3[i], &in.m3[i], &in.m3[j])) \
+	X(mat3_new                  , m3,   out.m3[i] = mat3_new(in.f[i], in.f[j], in.f[i ^ 1], \
+			in.f[j ^ 1], in.f[i ^ 2], in.f[j ^ 2], in.f[i ^ 3], in.f[j ^ 3], in.f[i ^ 4])) \
+	X(mat3_quat                 , m3,   mat3_quat(&out.m3[i], in.q[i])) \
+	X(mat3_rotate               , m3,   mat3_rotate(&out.m3[i], &in.m3[i], in.fa[j])) \
+	X(mat3_rotation             , m3,   mat3_rotation(&out.m3[i], in.fa[i])) \
+	X(mat3_scale                , m3,   mat3_scale(&out.m3[i], &in.m3[i], in.v2[j])) \
+	X(mat3_scaling              , m3,   mat3_scaling(&out.m3[i], in.v2[i])) \
+	X(mat3_sub                  , m3,   mat3_sub(&out.m3[i], &in.m3[i], &in.m3[j])) \
+	X(mat3_translate            , m3,   mat3_translate(&out.m3[i], &in.m3[i], in.v2[j])) \
+	X(mat3_translation          , m3,   mat3_translation(&out.m3[i], in.v2[i])) \
+	X(mat3_transpose            , m3,   mat3_transpose(&out.m3[i], &in.m3[i])) \
+	X(mat4_add                  , m4,   mat4_add(&out.m4[i], &in.m4[i], &in.m4[j])) \
+	X(mat4_adjoint              , m4,   mat4_adjoint(&out.m4[i], &in.m4[i])) \
+	X(mat4_compmul              , m4,   mat4_compmul(&out.m4[i], &in.m4[i], &in.m4[j])) \
+	X(mat4_copy                 , m4,   mat4_copy(&out.m4[i], &in.m4[i])) \
+	X(mat4_det                  , f,    out.f[i] = mat4_det(&in.m4[i])) \
+	X(mat4_frustum              , m4,   mat4_frustum(&out.m4[i], -in.p[i], in.p[i], -in.p[j], \
+			in.p[j], 0.125f, 1000.0f)) \
+	X(mat4_identity             , m4,   mat4_identity(&out.m4[i])) \
+	X(mat4_invert               , m4,   mat4_invert(&out.m4[i], &in.m4[i])) \
+	X(mat4_invert_affine        , m4,   mat4_invert_affine(&out.m4[i], &in.m4[i])) \
+	X(mat4_invert_fast          , m4,   mat4_invert_fast(&out.m4[i], &in.m4[i])) \
+	X(mat4_invert_rigid         , m4,   mat4_invert_rigid(&out.m4[i], &in.m4[i])) \
+	X(mat4_lookat               , m4,   mat4_lookat(&out.m4[i], in.v3[i], in.v3[j], vec3_new(0.0f, \
+			1.0f, 0.0f))) \
+	X(mat4_mat4x3               , m4,   mat4_mat4x3(&out.m4[i], &in.m43[i])) \
+	X(mat4_mul                  , m4,   mat4_mul(&out.m4[i], &in.m4[i], &in.m4[j])) \
+	X(mat4_mul_affine           , m4,   mat4_mul_affine(&out.m4[i], &in.m4[i], &in.m4[j])) \
+	X(mat4_new                  , m4,   out.m4[i] = mat4_new(in.f[i], in.f[j], in.f[i ^ 1], \
+			in.f[j ^ 1], in.f[i ^ 2], in.f[j ^ 2], in.f[i ^ 3], in.f[j ^ 3], in.f[i ^ 4], \
+			in.f[j ^ 4], in.f[i ^ 5], in.f[j ^ 5], in.f[i ^ 6], in.f[j ^ 6], in.f[i ^ 7], \
+			in.f[j ^ 7])) \
+	X(mat4_orthogonal           , m4,   mat4_orthogonal(&out.m4[i], in.p[i], in.p[j], 0.125f, \
+			1000.0f)) \
+	X(mat4_perspective          , m4,   mat4_perspective(&out.m4[i], TAU / 8.0f, in.p[i], in.p[j], \
+			0.125f, 1000.0f)) \
+	X(mat4_quat                 , m4,   mat4_quat(&out.m4[i], in.q[i])) \
+	X(mat4_rotate               , m4,   mat4_rotate(&out.m4[i], &in.m4[i], in.v3[j], in.fa[i ^ 1])) \
+	X(mat4_rotation             , m4,   mat4_rotation(&out.m4[i], in.v3[i], in.fa[j])) \
+	X(mat4_rottrans             , m4,   mat4_rottrans(&out.m4[i], in.q[i], in.v3[j])) \
+	X(mat4_rottransorigin       , m4,   mat4_rottransorigin(&out.m4[i], in.q[i], in.v3[j], \
+			in.v3[i ^ 1])) \
+	X(mat4_scale                , m4,   mat4_scale(&out.m4[i], &in.m4[i], in.v3[j])) \
+	X(mat4_scaling              , m4,   mat4_scaling(&out.m4[i], in.v3[i])) \
+	X(mat4_sub                  , m4,   mat4_sub(&out.m4[i], &in.m4[i], &in.m4[j])) \
+	X(mat4_translate            , m4,   mat4_translate(&out.m4[i], &in.m4[i], in.v3[j])) \
+	X(mat4_translation          , m4,   mat4_translation(&out.m4[i], in.v3[i])) \
+	X(mat4_transpose            , m4,   mat4_transpose(&out.m4[i], &in.m4[i])) \
+	X(num_abs                   , f,    out.f[i] = num_abs(in.f[i])) \
+	X(num_acos                  , f,    out.f[i] = num_acos(in.u[i])) \
+	X(num_asin                  , f,    out.f[i] = num_asin(in.u[i])) \
+	X(num_atan                  , f,    out.f[i] = num_atan(in.f[i])) \
+	X(num_atan2                 , f,    out.f[i] = num_atan2(in.f[i], in.f[j])) \
+	X(num_ceil                  , f,    out.f[i] = num_ceil(in.f[i])) \
+	X(num_clamp                 , f,    out.f[i] = num_clamp(in.f[i], -25.0f, 25.0f)) \
+	X(num_cos                   , f,    out.f[i] = num_cos(in.fa[i])) \
+	X(num_exp                   , f,    out.f[i] = num_exp(in.s[i])) \
+	X(num_floor                 , f,    out.f[i] = num_floor(in.f[i])) \
+	X(num_frsqrt                , f,    out.f[i] = num_frsqrt(in.p[i])) \
+	X(num_lerp                  , f,    out.f[i] = num_lerp(in.f[i], in.f[j], in.t[i ^ 1])) \
+	X(num_log                   , f,    out.f[i] = num_log(in.p[i])) \
+	X(num_max                   , f,    out.f[i] = num_max(in.f[i], in.f[j])) \
+	X(num_min                   , f,    out.f[i] = num_min(in.f[i], in.f[j])) \
+	X(num_mod                   , f,    out.f[i] = num_mod(in.f[i], in.p[j])) \
+	X(num_pow                   , f,    out.f[i] = num_pow(in.p[i], in.s[j])) \
+	X(num_round                 , f,    out.f[i] = num_round(in.f[i])) \
+	X(num_sin                   , f,    out.f[i] = num_sin(in.fa[i])) \
+	X(num_sqrt                  , f,    out.f[i] = num_sqrt(in.p[i])) \
+	X(num_tan                   , f,    out.f[i] = num_tan(in.fa[i])) \
+	X(mat4x3_copy               , m43,  mat4x3_copy(&out.m43[i], &in.m43[i])) \
+	X(mat4x3_identity           , m43,  mat4x3_identity(&out.m43[i])) \
+	X(mat4x3_invert             , m43,  mat4x3_invert(&out.m43[i], &in.m43[i])) \
+	X(mat4x3_mat4               , m43,  mat4x3_mat4(&out.m43[i], &in.m4[i])) \
+	X(mat4x3_mul                , m43,  mat4x3_mul(&out.m43[i], &in.m43[i], &in.m43[j])) \
+	X(mat4x3_rottrans           , m43,  mat4x3_rottrans(&out.m43[i], in.q[i], in.v3[j])) \
+	Y(vec3soa_add               , vec3soa_add(&out_s3, &in_s3a, &in_s3b, MICRO_N)) \
+	Y(vec3soa_applymat4         , vec3soa_applymat4(&out_s3, &in_s3a, &in.m4[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(vec3soa_applyquat         , vec3soa_applyquat(&out_s3, &in_s3a, in.q[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(vec3soa_cross             , vec3soa_cross(&out_s3, &in_s3a, &in_s3b, MICRO_N)) \
+	Y(vec3soa_dot               , vec3soa_dot(out.f, &in_s3a, &in_s3b, MICRO_N)) \
+	Y(vec3soa_fnormal           , vec3soa_fnormal(&out_s3, &in_s3a, MICRO_N)) \
+	Y(vec3soa_fromvec3          , vec3soa_fromvec3(&out_s3, in.v3, MICRO_N)) \
+	Y(vec3soa_lerp              , vec3soa_lerp(&out_s3, &in_s3a, &in_s3b, in.t[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(vec3soa_normal            , vec3soa_normal(&out_s3, &in_s3a, MICRO_N)) \
+	Y(vec3soa_scale             , vec3soa_scale(&out_s3, &in_s3a, in.f[r & MICRO_MASK], MICRO_N)) \
+	Y(vec3soa_sub               , vec3soa_sub(&out_s3, &in_s3a, &in_s3b, MICRO_N)) \
+	Y(vec3soa_tovec3            , vec3soa_tovec3(out.v3, &in_s3a, MICRO_N)) \
+	Y(vec4soa_add               , vec4soa_add(&out_s4, &in_s4a, &in_s4b, MICRO_N)) \
+	Y(vec4soa_applymat4         , vec4soa_applymat4(&out_s4, &in_s4a, &in.m4[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(vec4soa_dot               , vec4soa_dot(out.f, &in_s4a, &in_s4b, MICRO_N)) \
+	Y(vec4soa_fnormal           , vec4soa_fnormal(&out_s4, &in_s4a, MICRO_N)) \
+	Y(vec4soa_fromvec4          , vec4soa_fromvec4(&out_s4, in.v4, MICRO_N)) \
+	Y(vec4soa_lerp              , vec4soa_lerp(&out_s4, &in_s4a, &in_s4b, in.t[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(vec4soa_normal            , vec4soa_normal(&out_s4, &in_s4a, MICRO_N)) \
+	Y(vec4soa_scale             , vec4soa_scale(&out_s4, &in_s4a, in.f[r & MICRO_MASK], MICRO_N)) \
+	Y(vec4soa_sub               , vec4soa_sub(&out_s4, &in_s4a, &in_s4b, MICRO_N)) \
+	Y(vec4soa_tovec4            , vec4soa_tovec4(out.v4, &in_s4a, MICRO_N)) \
+	Y(quatsoa_dot               , quatsoa_dot(out.f, &in_sqa, &in_sqb, MICRO_N)) \
+	Y(quatsoa_fnormal           , quatsoa_fnormal(&out_sq, &in_sqa, MICRO_N)) \
+	Y(quatsoa_fromquat          , quatsoa_fromquat(&out_sq, in.q, MICRO_N)) \
+	Y(quatsoa_lerp              , quatsoa_lerp(&out_sq, &in_sqa, &in_sqb, in.t[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(quatsoa_mul               , quatsoa_mul(&out_sq, &in_sqa, &in_sqb, MICRO_N)) \
+	Y(quatsoa_nlerp             , quatsoa_nlerp(&out_sq, &in_sqa, &in_sqb, in.t[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(quatsoa_normal            , quatsoa_normal(&out_sq, &in_sqa, MICRO_N)) \
+	Y(quatsoa_toquat            , quatsoa_toquat(out.q, &in_sqa, MICRO_N)) \
+	Y(frustum_cullaabbs         , frustum_cullaabbs(out.u, &in.fr[r & MICRO_MASK], &in_s3a, \
+			&in_s3b, MICRO_N)) \
+	Y(frustum_cullspheres       , frustum_cullspheres(out.u, &in.fr[r & MICRO_MASK], &in_s3a, \
+			in.p, MICRO_N)) \
+	X(frustum_frommat4          , fr,   frustum_frommat4(&out.fr[i], &in.m4[i])) \
+	X(xvec2_add                 , xv2,  out.xv2[i] = xvec2_add(in.xv2[i], in.xv2[j])) \
+	X(xvec2_applymat2           , xv2,  out.xv2[i] = xvec2_applymat2(in.xv2[i], in.xm2[j])) \
+	X(xvec2_applymat3           , xv2,  out.xv2[i] = xvec2_applymat3(in.xv2[i], &in.xm3[j])) \
+	X(xvec2_applymat3x2         , xv2,  out.xv2[i] = xvec2_applymat3x2(in.xv2[i], in.xm32[j])) \
+	X(xvec2_applymat4           , xv2,  out.xv2[i] = xvec2_applymat4(in.xv2[i], &in.xm4[j])) \
+	X(xvec2_clamp               , xv2,  out.xv2[i] = xvec2_clamp(in.xv2[i], in.xv2[j], \
+			in.xv2[i ^ 1])) \
+	X(xvec2_cross               , x,    out.x[i] = xvec2_cross(in.xv2[i], in.xv2[j])) \
+	X(xvec2_dist                , x,    out.x[i] = xvec2_dist(in.xv2[i], in.xv2[j])) \
+	X(xvec2_dist2               , x,    out.x[i] = xvec2_dist2(in.xv2[i], in.xv2[j])) \
+	X(xvec2_dist2l              , l,    out.l[i] = xvec2_dist2l(in.xv2[i], in.xv2[j])) \
+	X(xvec2_distl               , l,    out.l[i] = xvec2_distl(in.xv2[i], in.xv2[j])) \
+	X(xvec2_div                 , xv2,  out.xv2[i] = xvec2_div(in.xv2[i], in.xv2[j])) \
+	X(xvec2_dot                 , x,    out.x[i] = xvec2_dot(in.xv2[i], in.xv2[j])) \
+	X(xvec2_dotl                , l,    out.l[i] = xvec2_dotl(in.xv2[i], in.xv2[j])) \
+	X(xvec2_fromvec2            , xv2,  out.xv2[i] = xvec2_fromvec2(in.v2[i])) \
+	X(xvec2_inverse             , xv2,  out.xv2[i] = xvec2_inverse(in.xv2[i])) \
+	X(xvec2_len                 , x,    out.x[i] = xvec2_len(in.xv2[i])) \
+	X(xvec2_len2                , x,    out.x[i] = xvec2_len2(in.xv2[i])) \
+	X(xvec2_len2l               , l,    out.l[i] = xvec2_len2l(in.xv2[i])) \
+	X(xvec2_lenl                , l,    out.l[i] = xvec2_lenl(in.xv2[i])) \
+	X(xvec2_lerp                , xv2,  out.xv2[i] = xvec2_lerp(in.xv2[i], in.xv2[j], in.xt[i ^ 1])) \
+	X(xvec2_max                 , xv2,  out.xv2[i] = xvec2_max(in.xv2[i], in.xv2[j])) \
+	X(xvec2_min                 , xv2,  out.xv2[i] = xvec2_min(in.xv2[i], in.xv2[j])) \
+	X(xvec2_mul                 , xv2,  out.xv2[i] = xvec2_mul(in.xv2[i], in.xv2[j])) \
+	X(xvec2_neg                 , xv2,  out.xv2[i] = xvec2_neg(in.xv2[i])) \
+	X(xvec2_new                 , xv2,  out.xv2[i] = xvec2_new(in.x[i], in.x[j])) \
+	X(xvec2_normal              , xv2,  out.xv2[i] = xvec2_normal(in.xv2[i])) \
+	X(xvec2_scale               , xv2,  out.xv2[i] = xvec2_scale(in.xv2[i], in.x[j])) \
+	X(xvec2_sub                 , xv2,  out.xv2[i] = xvec2_sub(in.xv2[i], in.xv2[j])) \
+	X(xvec2_tovec2              , v2,   out.v2[i] = xvec2_tovec2(in.xv2[i])) \
+	X(xvec3_add                 , xv3,  out.xv3[i] = xvec3_add(in.xv3[i], in.xv3[j])) \
+	Y(xvec3_add_array           , xvec3_add_array(out.xv3, in.xv3, in.xv3b, MICRO_N)) \
+	X(xvec3_angle               , x,    out.x[i] = xvec3_angle(in.xv3[i], in.xv3[j])) \
+	X(xvec3_applymat3           , xv3,  out.xv3[i] = xvec3_applymat3(in.xv3[i], &in.xm3[j])) \
+	X(xvec3_applymat3x2         , xv3,  out.xv3[i] = xvec3_applymat3x2(in.xv3[i], in.xm32[j])) \
+	X(xvec3_applymat4           , xv3,  out.xv3[i] = xvec3_applymat4(in.xv3[i], &in.xm4[j])) \
+	X(xvec3_applyquat           , xv3,  out.xv3[i] = xvec3_applyquat(in.xv3[i], in.xq[j])) \
+	Y(xvec3_applyquat_array     , xvec3_applyquat_array(out.xv3, in.xv3, in.xq[r & MICRO_MASK], \
+			MICRO_N)) \
+	Y(xvec3_applyquatv_array    , xvec3_applyquatv_array(out.xv3, in.xv3, in.xq, MICRO_N)) \
+	X(xvec3_clamp               , xv3,  out.xv3[i] = xvec3_clamp(in.xv3[i], in.xv3[j], \
+			in.xv3[i ^ 1])) \
+	X(xvec3_cross               , xv3,  out.xv3[i] = xvec3_cross(in.xv3[i], in.xv3[j])) \
+	X(xvec3_dist                , x,    out.x[i] = xvec3_dist(in.xv3[i], in.xv3[j])) \
+	X(xvec3_dist2               , x,    out.x[i] = xvec3_dist2(in.xv3[i], in.xv3[j])) \
+	X(xvec3_dist2l              , l,    out.l[i] = xvec3_dist2l(in.xv3[i], in.xv3[j])) \
+	X(xvec3_distl               , l,    out.l[i] = xvec3_distl(in.xv3[i], in.xv3[j])) \
+	X(xvec3_div                 , xv3,  out.xv3[i] = xvec3_div(in.xv3[i], in.xv3[j])) \
+	Y(xvec3_divs_array          , xvec3_divs_array(out.xv3, in.xv3, in.xp[r & MICRO_MASK], MICRO_N)) \
+	X(xvec3_dot                 , x,    out.x[i] = xvec3_dot(in.xv3[i], in.xv3[j])) \
+	X(xvec3_dotl                , l,    out.l[i] = xvec3_dotl(in.xv3[i], in.xv3[j])) \
+	X(xvec3_fromvec3            , xv3,  out.xv3[i] = xvec3_fromvec3(in.v3[i])) \
+	X(xvec3_inverse             , xv3,  out.xv3[i] = xvec3_inverse(in.xv3[i])) \
+	X(xvec3_len                 , x,    out.x[i] = xvec3_len(in.xv3[i])) \
+	X(xvec3_len2                , x,    out.x[i] = xvec3_len2(in.xv3[i])) \
+	X(xvec3_len2l               , l,    out.l[i] = xvec3_len2l(in.xv3[i])) \
+	X(xvec3_lenl                , l,    out.l[i] = xvec3_lenl(in.xv3[i])) \
+	X(xvec3_lerp                , xv3,  out.xv3[i] = xvec3_lerp(in.xv3[i], in.xv3[j], in.xt[i ^ 1])) \
+	X(xvec3_max                 , xv3,  out.xv3[i] = xvec3_max(in.xv3[i], in.xv3[j])) \
+	X(xvec3_min                 , xv3,  out.xv3[i] = xvec3_min(in.xv3[i], in.xv3[j])) \
+	X(xvec3_mul                 , xv3,  out.xv3[i] = xvec3_mul(in.xv3[i], in.xv3[j])) \
+	X(xvec3_nangle              , x,    out.x[i] = xvec3_nangle(in.xn3[i], in.xn3[j])) \
+	X(xvec3_neg                 , xv3,  out.xv3[i] = xvec3_neg(in.xv3[i])) \
+	X(xvec3_new                 , xv3,  out.xv3[i] = xvec3_new(in.x[i], in.x[j], in.x[i ^ 1])) \
+	X(xvec3_normal              , xv3,  out.xv3[i] = xvec3_normal(in.xv3[i])) \
+	X(xvec3_orthogonal          , xv3,  out.xv3[i] = xvec3_orthogonal(in.xv3[i], in.xv3[j])) \
+	X(xvec3_scale               , xv3,  out.xv3[i] = xvec3_scale(in.xv3[i], in.x[j])) \
+	Y(xvec3_scale_array         , xvec3_scale_array(out.xv3, in.xv3, in.xt[r & MICRO_MASK], \
+			MICRO_N)) \
+	X(xvec3_sub                 , xv3,  out.xv3[i] = xvec3_sub(in.xv3[i], in.xv3[j])) \
+	Y(xvec3_sub_array           , xvec3_sub_array(out.xv3, in.xv3, in.xv3b, MICRO_N)) \
+	X(xvec3_tovec3              , v3,   out.v3[i] = xvec3_tovec3(in.xv3[i])) \
+	X(xvec4_add                 , xv4,  out.xv4[i] = xvec4_add(in.xv4[i], in.xv4[j])) \
+	X(xvec4_applymat4           , xv4,  out.xv4[i] = xvec4_applymat4(in.xv4[i], &in.xm4[j])) \
+	X(xvec4_applyquat           , xv4,  out.xv4[i] = xvec4_applyquat(in.xv4[i], in.xq[j])) \
+	X(xvec4_clamp               , xv4,  out.xv4[i] = xvec4_clamp(in.xv4[i], in.xv4[j], \
+			in.xv4[i ^ 1])) \
+	X(xvec4_dist                , x,    out.x[i] = xvec4_dist(in.xv4[i], in.xv4[j])) \
+	X(xvec4_dist2               , x,    out.x[i] = xvec4_dist2(in.xv4[i], in.xv4[j])) \
+	X(xvec4_dist2l              , l,    out.l[i] = xvec4_dist2l(in.xv4[i], in.xv4[j])) \
+	X(xvec4_distl               , l,    out.l[i] = xvec4_distl(in.xv4[i], in.xv4[j])) \
+	X(xvec4_div                 , xv4,  out.xv4[i] = xvec4_div(in.xv4[i], in.xv4[j])) \
+	X(xvec4_dot                 , x,    out.x[i] = xvec4_dot(in.xv4[i], in.xv4[j])) \
+	X(xvec4_dotl                , l,    out.l[i] = xvec4_dotl(in.xv4[i], in.xv4[j])) \
+	X(xvec4_fromvec4            , xv4,  out.xv4[i] = xvec4_fromvec4(in.v4[i])) \
+	X(xvec4_inverse             , xv4,  out.xv4[i] = xvec4_inverse(in.xv4[i])) \
+	X(xvec4_len                 , x,    out.x[i] = xvec4_len(in.xv4[i])) \
+	X(xvec4_len2                , x,    out.x[i] = xvec4_len2(in.xv4[i])) \
+	X(xvec4_len2l               , l,    out.l[i] = xvec4_len2l(in.xv4[i])) \
+	X(xvec4_lenl                , l,    out.l[i] = xvec4_lenl(in.xv4[i])) \
+	X(xvec4_lerp                , xv4,  out.xv4[i] = xvec4_lerp(in.xv4[i], in.xv4[j], in.xt[i ^ 1])) \
+	X(xvec4_max                 , xv4,  out.xv4[i] = xvec4_max(in.xv4[i], in.xv4[j])) \
+	X(xvec4_min                 , xv4,  out.xv4[i] = xvec4_min(in.xv4[i], in.xv4[j])) \
+	X(xvec4_mul                 , xv4,  out.xv4[i] = xvec4_mul(in.xv4[i], in.xv4[j])) \
+	X(xvec4_neg                 , xv4,  out.xv4[i] = xvec4_neg(in.xv4[i])) \
+	X(xvec4_new                 , xv4,  out.xv4[i] = xvec4_new(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1])) \
+	X(xvec4_normal              , xv4,  out.xv4[i] = xvec4_normal(in.xv4[i])) \
+	X(xvec4_scale               , xv4,  out.xv4[i] = xvec4_scale(in.xv4[i], in.x[j])) \
+	X(xvec4_sub                 , xv4,  out.xv4[i] = xvec4_sub(in.xv4[i], in.xv4[j])) \
+	X(xvec4_tovec4              , v4,   out.v4[i] = xvec4_tovec4(in.xv4[i])) \
+	X(xquat_axisang             , xq,   out.xq[i] = xquat_axisang(in.xv3[i], in.a[j])) \
+	X(xquat_between             , xq,   out.xq[i] = xquat_between(in.xv3[i], in.xv3[j])) \
+	X(xquat_dot                 , x,    out.x[i] = xquat_dot(in.xq[i], in.xq[j])) \
+	X(xquat_euler_xyz           , xq,   out.xq[i] = xquat_euler_xyz(in.xe3[i])) \
+	X(xquat_euler_xzy           , xq,   out.xq[i] = xquat_euler_xzy(in.xe3[i])) \
+	X(xquat_euler_yxz           , xq,   out.xq[i] = xquat_euler_yxz(in.xe3[i])) \
+	X(xquat_euler_yzx           , xq,   out.xq[i] = xquat_euler_yzx(in.xe3[i])) \
+	X(xquat_euler_zxy           , xq,   out.xq[i] = xquat_euler_zxy(in.xe3[i])) \
+	X(xquat_euler_zyx           , xq,   out.xq[i] = xquat_euler_zyx(in.xe3[i])) \
+	X(xquat_fromquat            , xq,   out.xq[i] = xquat_fromquat(in.q[i])) \
+	X(xquat_identity            , xq,   out.xq[i] = xquat_identity()) \
+	X(xquat_invert              , xq,   out.xq[i] = xquat_invert(in.xq[i])) \
+	X(xquat_lerp                , xq,   out.xq[i] = xquat_lerp(in.xq[i], in.xq[j], in.xt[i ^ 1])) \
+	X(xquat_mul                 , xq,   out.xq[i] = xquat_mul(in.xq[i], in.xq[j])) \
+	Y(xquat_mul_array           , xquat_mul_array(out.xq, in.xq, in.xqb, MICRO_N)) \
+	X(xquat_naxisang            , xq,   out.xq[i] = xquat_naxisang(in.xn3[i], in.a[j])) \
+	X(xquat_nbetween            , xq,   out.xq[i] = xquat_nbetween(in.xn3[i], in.xn3[j])) \
+	X(xquat_neg                 , xq,   out.xq[i] = xquat_neg(in.xq[i])) \
+	X(xquat_new                 , xq,   out.xq[i] = xquat_new(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1])) \
+	X(xquat_nlerp               , xq,   out.xq[i] = xquat_nlerp(in.xq[i], in.xq[j], in.xt[i ^ 1])) \
+	X(xquat_normal              , xq,   out.xq[i] = xquat_normal(in.xq[i])) \
+	X(xquat_slerp               , xq,   out.xq[i] = xquat_slerp(in.xq[i], in.xq[j], in.xt[i ^ 1])) \
+	X(xquat_toquat              , q,    out.q[i] = xquat_toquat(in.xq[i])) \
+	X(xmat2_add                 , xm2,  out.xm2[i] = xmat2_add(in.xm2[i], in.xm2[j])) \
+	X(xmat2_adjoint             , xm2,  out.xm2[i] = xmat2_adjoint(in.xm2[i])) \
+	X(xmat2_compmul             , xm2,  out.xm2[i] = xmat2_compmul(in.xm2[i], in.xm2[j])) \
+	X(xmat2_det                 , x,    out.x[i] = xmat2_det(in.xm2[i])) \
+	X(xmat2_detl                , l,    out.l[i] = xmat2_detl(in.xm2[i])) \
+	X(xmat2_frommat2            , xm2,  out.xm2[i] = xmat2_frommat2(in.m2[i])) \
+	X(xmat2_identity            , xm2,  out.xm2[i] = xmat2_identity()) \
+	X(xmat2_invert              , xm2,  out.xm2[i] = xmat2_invert(in.xm2[i])) \
+	X(xmat2_mul                 , xm2,  out.xm2[i] = xmat2_mul(in.xm2[i], in.xm2[j])) \
+	X(xmat2_new                 , xm2,  out.xm2[i] = xmat2_new(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1])) \
+	X(xmat2_rotate              , xm2,  out.xm2[i] = xmat2_rotate(in.xm2[i], in.a[j])) \
+	X(xmat2_rotation            , xm2,  out.xm2[i] = xmat2_rotation(in.a[i])) \
+	X(xmat2_scale               , xm2,  out.xm2[i] = xmat2_scale(in.xm2[i], in.xv2[j])) \
+	X(xmat2_scaling             , xm2,  out.xm2[i] = xmat2_scaling(in.xv2[i])) \
+	X(xmat2_sub                 , xm2,  out.xm2[i] = xmat2_sub(in.xm2[i], in.xm2[j])) \
+	X(xmat2_tomat2              , m2,   out.m2[i] = xmat2_tomat2(in.xm2[i])) \
+	X(xmat2_transpose           , xm2,  out.xm2[i] = xmat2_transpose(in.xm2[i])) \
+	X(xmat3x2_add               , xm32, out.xm32[i] = xmat3x2_add(in.xm32[i], in.xm32[j])) \
+	X(xmat3x2_compmul           , xm32, out.xm32[i] = xmat3x2_compmul(in.xm32[i], in.xm32[j])) \
+	X(xmat3x2_det               , x,    out.x[i] = xmat3x2_det(in.xm32[i])) \
+	X(xmat3x2_frommat3x2        , xm32, out.xm32[i] = xmat3x2_frommat3x2(in.m32[i])) \
+	X(xmat3x2_identity          , xm32, out.xm32[i] = xmat3x2_identity()) \
+	X(xmat3x2_invert            , xm32, out.xm32[i] = xmat3x2_invert(in.xm32[i])) \
+	X(xmat3x2_mul               , xm32, out.xm32[i] = xmat3x2_mul(in.xm32[i], in.xm32[j])) \
+	X(xmat3x2_new               , xm32, out.xm32[i] = xmat3x2_new(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1], in.x[i ^ 2], in.x[j ^ 2])) \
+	X(xmat3x2_rotate            , xm32, out.xm32[i] = xmat3x2_rotate(in.xm32[i], in.a[j])) \
+	X(xmat3x2_rotation          , xm32, out.xm32[i] = xmat3x2_rotation(in.a[i])) \
+	X(xmat3x2_scale             , xm32, out.xm32[i] = xmat3x2_scale(in.xm32[i], in.xv2[j])) \
+	X(xmat3x2_scaling           , xm32, out.xm32[i] = xmat3x2_scaling(in.xv2[i])) \
+	X(xmat3x2_sub               , xm32, out.xm32[i] = xmat3x2_sub(in.xm32[i], in.xm32[j])) \
+	X(xmat3x2_tomat3x2          , m32,  out.m32[i] = xmat3x2_tomat3x2(in.xm32[i])) \
+	X(xmat3x2_translate         , xm32, out.xm32[i] = xmat3x2_translate(in.xm32[i], in.xv2[j])) \
+	X(xmat3x2_translation       , xm32, out.xm32[i] = xmat3x2_translation(in.xv2[i])) \
+	X(xmat3_add                 , xm3,  xmat3_add(&out.xm3[i], &in.xm3[i], &in.xm3[j])) \
+	X(xmat3_adjoint             , xm3,  xmat3_adjoint(&out.xm3[i], &in.xm3[i])) \
+	X(xmat3_compmul             , xm3,  xmat3_compmul(&out.xm3[i], &in.xm3[i], &in.xm3[j])) \
+	X(xmat3_copy                , xm3,  xmat3_copy(&out.xm3[i], &in.xm3[i])) \
+	X(xmat3_det                 , x,    out.x[i] = xmat3_det(&in.xm3[i])) \
+	X(xmat3_detl                , l,    out.l[i] = xmat3_detl(&in.xm3[i])) \
+	X(xmat3_identity            , xm3,  xmat3_identity(&out.xm3[i])) \
+	X(xmat3_invert              , xm3,  xmat3_invert(&out.xm3[i], &in.xm3[i])) \
+	X(xmat3_mul                 , xm3,  xmat3_mul(&out.xm3[i], &in.xm3[i], &in.xm3[j])) \
+	X(xmat3_new                 , xm3,  out.xm3[i] = xmat3_new(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1], in.x[i ^ 2], in.x[j ^ 2], in.x[i ^ 3], in.x[j ^ 3], in.x[i ^ 4])) \
+	X(xmat3_quat                , xm3,  xmat3_quat(&out.xm3[i], in.xq[i])) \
+	X(xmat3_rotate              , xm3,  xmat3_rotate(&out.xm3[i], &in.xm3[i], in.a[j])) \
+	X(xmat3_rotation            , xm3,  xmat3_rotation(&out.xm3[i], in.a[i])) \
+	X(xmat3_scale               , xm3,  xmat3_scale(&out.xm3[i], &in.xm3[i], in.xv2[j])) \
+	X(xmat3_scaling             , xm3,  xmat3_scaling(&out.xm3[i], in.xv2[i])) \
+	X(xmat3_sub                 , xm3,  xmat3_sub(&out.xm3[i], &in.xm3[i], &in.xm3[j])) \
+	X(xmat3_translate           , xm3,  xmat3_translate(&out.xm3[i], &in.xm3[i], in.xv2[j])) \
+	X(xmat3_translation         , xm3,  xmat3_translation(&out.xm3[i], in.xv2[i])) \
+	X(xmat3_transpose           , xm3,  xmat3_transpose(&out.xm3[i], &in.xm3[i])) \
+	X(xmat4_add                 , xm4,  xmat4_add(&out.xm4[i], &in.xm4[i], &in.xm4[j])) \
+	X(xmat4_adjoint             , xm4,  xmat4_adjoint(&out.xm4[i], &in.xm4[i])) \
+	X(xmat4_compmul             , xm4,  xmat4_compmul(&out.xm4[i], &in.xm4[i], &in.xm4[j])) \
+	X(xmat4_copy                , xm4,  xmat4_copy(&out.xm4[i], &in.xm4[i])) \
+	X(xmat4_det                 , x,    out.x[i] = xmat4_det(&in.xm4[i])) \
+	X(xmat4_detl                , l,    out.l[i] = xmat4_detl(&in.xm4[i])) \
+	X(xmat4_frustum             , xm4,  xmat4_frustum(&out.xm4[i], -in.xp[i], in.xp[i], -in.xp[j], \
+			in.xp[j], XINT1 / 8, XINT(1000))) \
+	X(xmat4_identity            , xm4,  xmat4_identity(&out.xm4[i])) \
+	X(xmat4_invert              , xm4,  xmat4_invert(&out.xm4[i], &in.xm4[i])) \
+	X(xmat4_lookat              , xm4,  xmat4_lookat(&out.xm4[i], in.xv3[i], in.xv3[j], \
+			xvec3_new(0, XINT1, 0))) \
+	X(xmat4_mul                 , xm4,  xmat4_mul(&out.xm4[i], &in.xm4[i], &in.xm4[j])) \
+	X(xmat4_new                 , xm4,  out.xm4[i] = xmat4_new(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1], in.x[i ^ 2], in.x[j ^ 2], in.x[i ^ 3], in.x[j ^ 3], in.x[i ^ 4], \
+			in.x[j ^ 4], in.x[i ^ 5], in.x[j ^ 5], in.x[i ^ 6], in.x[j ^ 6], in.x[i ^ 7], \
+			in.x[j ^ 7])) \
+	X(xmat4_orthogonal          , xm4,  xmat4_orthogonal(&out.xm4[i], in.xp[i], in.xp[j], \
+			XINT1 / 8, XINT(1000))) \
+	X(xmat4_perspective         , xm4,  xmat4_perspective(&out.xm4[i], XANG45, in.xp[i], in.xp[j], \
+			XINT1 / 8, XINT(1000))) \
+	X(xmat4_quat                , xm4,  xmat4_quat(&out.xm4[i], in.xq[i])) \
+	X(xmat4_rotate              , xm4,  xmat4_rotate(&out.xm4[i], &in.xm4[i], in.xv3[j], \
+			in.a[i ^ 1])) \
+	X(xmat4_rotation            , xm4,  xmat4_rotation(&out.xm4[i], in.xv3[i], in.a[j])) \
+	X(xmat4_rottrans            , xm4,  xmat4_rottrans(&out.xm4[i], in.xq[i], in.xv3[j])) \
+	X(xmat4_rottransorigin      , xm4,  xmat4_rottransorigin(&out.xm4[i], in.xq[i], in.xv3[j], \
+			in.xv3[i ^ 1])) \
+	X(xmat4_scale               , xm4,  xmat4_scale(&out.xm4[i], &in.xm4[i], in.xv3[j])) \
+	X(xmat4_scaling             , xm4,  xmat4_scaling(&out.xm4[i], in.xv3[i])) \
+	X(xmat4_sub                 , xm4,  xmat4_sub(&out.xm4[i], &in.xm4[i], &in.xm4[j])) \
+	X(xmat4_translate           , xm4,  xmat4_translate(&out.xm4[i], &in.xm4[i], in.xv3[j])) \
+	X(xmat4_translation         , xm4,  xmat4_translation(&out.xm4[i], in.xv3[i])) \
+	X(xmat4_transpose           , xm4,  xmat4_transpose(&out.xm4[i], &in.xm4[i])) \
+	X(xint_abs                  , x,    out.x[i] = xint_abs(in.x[i])) \
+	X(xint_acos                 , a,    out.a[i] = xint_acos(in.xu[i])) \
+	X(xint_add                  , x,    out.x[i] = xint_add(in.x[i], in.x[j])) \
+	X(xint_asin                 , a,    out.a[i] = xint_asin(in.xu[i])) \
+	X(xint_atan                 , a,    out.a[i] = xint_atan(in.x[i])) \
+	X(xint_atan2                , a,    out.a[i] = xint_atan2(in.x[i], in.x[j])) \
+	X(xint_ceil                 , x,    out.x[i] = xint_ceil(in.x[i])) \
+	X(xint_clamp                , x,    out.x[i] = xint_clamp(in.x[i], -XINT(25), XINT(25))) \
+	X(xint_cos                  , x,    out.x[i] = xint_cos(in.a[i])) \
+	X(xint_div                  , x,    out.x[i] = xint_div(in.x[i], in.xp[j])) \
+	Y(xint_div_array            , xint_div_array(out.x, in.x, in.xp[r & MICRO_MASK], MICRO_N)) \
+	X(xint_div_by               , x,    out.x[i] = xint_div_by(in.x[i], &in.r[j])) \
+	X(xint_dot2                 , x,    out.x[i] = xint_dot2(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1])) \
+	X(xint_dot3                 , x,    out.x[i] = xint_dot3(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1], in.x[i ^ 2], in.x[j ^ 2])) \
+	X(xint_dot4                 , x,    out.x[i] = xint_dot4(in.x[i], in.x[j], in.x[i ^ 1], \
+			in.x[j ^ 1], in.x[i ^ 2], in.x[j ^ 2], in.x[i ^ 3], in.x[j ^ 3])) \
+	X(xint_exp                  , x,    out.x[i] = xint_exp(in.xs[i])) \
+	X(xint_floor                , x,    out.x[i] = xint_floor(in.x[i])) \
+	X(xint_fromdouble           , x,    out.x[i] = xint_fromdouble(in.d[i])) \
+	X(xint_fromfloat            , x,    out.x[i] = xint_fromfloat(in.f[i])) \
+	X(xint_fromint              , x,    out.x[i] = xint_fromint(in.n[i])) \
+	X(xint_lerp                 , x,    out.x[i] = xint_lerp(in.x[i], in.x[j], in.xt[i ^ 1])) \
+	X(xint_log                  , x,    out.x[i] = xint_log(in.xp[i])) \
+	X(xint_max                  , x,    out.x[i] = xint_max(in.x[i], in.x[j])) \
+	X(xint_min                  , x,    out.x[i] = xint_min(in.x[i], in.x[j])) \
+	X(xint_mod                  , x,    out.x[i] = xint_mod(in.x[i], in.xp[j])) \
+	X(xint_mul                  , x,    out.x[i] = xint_mul(in.x[i], in.x[j])) \
+	X(xint_pow                  , x,    out.x[i] = xint_pow(in.xp[i], in.xs[j])) \
+	X(xint_round                , x,    out.x[i] = xint_round(in.x[i])) \
+	X(xint_rsqrt                , x,    out.x[i] = xint_rsqrt(in.xp[i])) \
+	X(xint_sin                  , x,    out.x[i] = xint_sin(in.a[i])) \
+	X(xint_sqrt                 , x,    out.x[i] = xint_sqrt(in.xp[i])) \
+	X(xint_sub                  , x,    out.x[i] = xint_sub(in.x[i], in.x[j])) \
+	X(xint_tan                  , x,    out.x[i] = xint_tan(in.a[i])) \
+	X(xint_todouble             , d,    out.d[i] = xint_todouble(in.x[i])) \
+	X(xint_tofloat              , f,    out.f[i] = xint_tofloat(in.x[i])) \
+	X(xint_toint                , n,    out.n[i] = xint_toint(in.x[i])) \
+	X(xang_fromdouble           , a,    out.a[i] = xang_fromdouble(in.d[i])) \
+	X(xang_fromfloat            , a,    out.a[i] = xang_fromfloat(in.fa[i])) \
+	X(xang_todouble             , d,    out.d[i] = xang_todouble(in.a[i])) \
+	X(xang_tofloat              , f,    out.f[i] = xang_tofloat(in.a[i])) \
+	X(xang_wrap                 , a,    out.a[i] = xang_wrap(in.a[i])) \
+	X(xrecip_new                , r,    out.r[i] = xrecip_new(in.xp[i])) \
+	X(xlong_add                 , l,    out.l[i] = xlong_add(in.l[i], in.l[j])) \
+	X(xlong_div                 , l,    out.l[i] = xlong_div(in.l[i], in.l[j])) \
+	X(xlong_fromdouble          , l,    out.l[i] = xlong_fromdouble(in.d[i])) \
+	X(xlong_fromint             , l,    out.l[i] = xlong_fromint(in.n[i])) \
+	X(xlong_fromxint            , l,    out.l[i] = xlong_fromxint(in.x[i])) \
+	X(xlong_mul                 , l,    out.l[i] = xlong_mul(in.l[i], in.l[j])) \
+	X(xlong_sqrt                , l,    out.l[i] = xlong_sqrt(in.l[i])) \
+	X(xlong_sub                 , l,    out.l[i] = xlong_sub(in.l[i], in.l[j])) \
+	X(xlong_todouble            , d,    out.d[i] = xlong_todouble(in.l[i])) \
+	X(xlong_toint               , n,    out.n[i] = xlong_toint(in.l[i])) \
+	X(xlong_toxint              , x,    out.x[i] = xlong_toxint(in.l[i]))
+
+#define X(name, kind, stmt)                          \
+	static void micro_##name(int rounds){            \
+		for (int r = 0; r < rounds; r++){            \
+			for (int i = 0; i < MICRO_N; i++){       \
+				int j = (i + r + 1) & MICRO_MASK;    \
+				(void)j;                             \
+				stmt;                                \
+			}                                        \
+		}                                            \
+	}
+#define Y(name, stmt)                                \
+	static void micro_##name(int rounds){            \
+		for (int r = 0; r < rounds; r++)             \
+			stmt;                                    \
+	}
+MICRO_FUNCS(X, Y)
+#undef X
+#undef Y
+
+typedef struct {
+	const char *name;
+	void (*run)(int rounds);
+	const char *kind; // member of `out` holding the results, or "" for array functions
+	size_t size;
+} micro_func;
+
+#define X(name, kind, stmt) { #name, micro_##name, #kind, sizeof(out.kind[0]) },
+#define Y(name, stmt)       { #name, micro_##name, "", 0 },
+static const micro_func micro_funcs[] = { MICRO_FUNCS(X, Y) };
+#undef X
+#undef Y
+
+static double micro_time(void (*run)(int rounds), size_t *ops){
+	// returns the best of 3 runs, each long enough for clock() to be accurate, after a warm up
+	// that also lets the SIMD dispatch pick its kernels
+	run(1);
+	int rounds = 1;
+	for (;;){
+		double t = now();
+		run(rounds);
+		double sec = now() - t;
+		if (sec >= 0.01 || rounds >= (1 << 24))
+			break;
+		rounds *= sec < 0.001 ? 16 : 2;
+	}
+	double best = 0;
+	for (int k = 0; k < 3; k++){
+		double t = now();
+		run(rounds);
+		double sec = now() - t;
+		if (k == 0 || sec < best)
+			best = sec;
+	}
+	*ops = (size_t)rounds * MICRO_N;
+	return best;
+}
+
+static void json_config(FILE *fp, const char *name, bool on, bool last){
+	fprintf(fp, "    \"%s\": %s%s\n", name, on ? "true" : "false", last ? "" : ",");
+}
+
+static int bench_micro(int argc, char **argv){
+	const char *filter = NULL, *json = NULL;
+	for (int i = 2; i < argc; i++){
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			json = argv[++i];
+		else if (filter == NULL && argv[i][0] != '-')
+			filter = argv[i];
+		else{
+			fprintf(stderr, "Invalid option: %s\n", argv[i]);
+			return 1;
+		}
+	}
+	FILE *fp = NULL;
+	if (json){
+		fp = fopen(json, "w");
+		if (fp == NULL){
+			fprintf(stderr, "Failed to open: %s\n", json);
+			return 1;
+		}
+		fprintf(fp, "{\n  \"bench\": \"micro\",\n  \"inputs\": %d,\n  \"config\": {\n", MICRO_N);
+#ifdef NVQM_INLINE_ALL
+		json_config(fp, "NVQM_INLINE_ALL", true, false);
+#else
+		json_config(fp, "NVQM_INLINE_ALL", false, false);
+#endif
+#ifdef NVQM_SSE2
+		json_config(fp, "NVQM_SSE2", true, false);
+#else
+		json_config(fp, "NVQM_SSE2", false, false);
+#endif
+#ifdef NVQM_XANG16
+		json_config(fp, "NVQM_XANG16", true, false);
+#else
+		json_config(fp, "NVQM_XANG16", false, false);
+#endif
+#ifdef NVQM_QUARTER_LUT
+		json_config(fp, "NVQM_QUARTER_LUT", true, false);
+#else
+		json_config(fp, "NVQM_QUARTER_LUT", false, false);
+#endif
+#ifdef NVQM_XINT_ROUND_EACH
+		json_config(fp, "NVQM_XINT_ROUND_EACH", true, true);
+#else
+		json_config(fp, "NVQM_XINT_ROUND_EACH", false, true);
+#endif
+		fprintf(fp, "  },\n  \"results\": [");
+	}
+
+	micro_init();
+	printf("every function on %d random inputs, per call or per array element\n", MICRO_N);
+	int count = 0;
+	for (size_t i = 0; i < sizeof(micro_funcs) / sizeof(micro_funcs[0]); i++){
+		const micro_func *m = &micro_funcs[i];
+		if (filter && strstr(m->name, filter) == NULL)
+			continue;
+		size_t ops;
+		double sec = micro_time(m->run, &ops);
+		report(m->name, sec, ops);
+		if (fp){
+			fprintf(fp, "%s\n    { \"name\": \"%s\", \"ns_per_op\": %.4f, \"ops_per_sec\": %.0f }",
+				count == 0 ? "" : ",", m->name, sec * 1e9 / ops, ops / sec);
+		}
+		count++;
+	}
+	sink = out.f[0];
+	if (fp){
+		fprintf(fp, "\n  ]\n}\n");
+		fclose(fp);
+	}
+	if (count == 0){
+		fprintf(stderr, "No functions match: %s\n", filter);
+		return 1;
+	}
+	return 0;
+}
+
+static const micro_func *micro_find(const char *name){
+	for (size_t i = 0; i < sizeof(micro_funcs) / sizeof(micro_funcs[0]); i++){
+		if (strcmp(micro_funcs[i].name, name) == 0)
+			return &micro_funcs[i];
+	}
+	return NULL;
+}
+
+static bool pair_kind(const char *kind, const char *const *kinds){
+	for (int i = 0; kinds[i]; i++){
+		if (strcmp(kind, kinds[i]) == 0)
+			return true;
+	}
+	return false;
+}
+
+static const micro_func *pair_twin(const micro_func *m){
+	// returns the float function computing the same thing as the fixed-point function `m`
+	static const char *const float_kinds[] = { "f", "v2", "v3", "v4", "q", "m2", "m32", "m3", "m4",
+		"m43", NULL };
+	static const char *const fixed_kinds[] = { "x", "a", "xv2", "xv3", "xv4", "xq", "xm2", "xm32",
+		"xm3", "xm4", NULL };
+	char name[64];
+	if (strncmp(m->name, "xint_", 5) == 0)
+		snprintf(name, sizeof(name), "num_%s", m->name + 5);
+	else if (strncmp(m->name, "xvec", 4) == 0 || strncmp(m->name, "xquat", 5) == 0 ||
+		strncmp(m->name, "xmat", 4) == 0)
+		snprintf(name, sizeof(name), "%s", m->name + 1);
+	else
+		return NULL;
+	if (!pair_kind(m->kind, fixed_kinds))
+		return NULL;
+	const micro_func *f = micro_find(name);
+	if (f == NULL || !pair_kind(f->kind, float_kinds) || f->size != m->size)
+		return NULL;
+	return f;
+}
+
+static int bench_pairs(int argc, char **argv){
+	const char *filter = NULL, *json = NULL;
+	for (int i = 2; i < argc; i++){
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			json = argv[++i];
+		else if (filter == NULL && argv[i][0] != '-')
+			filter = argv[i];
+		else{
+			fprintf(stderr, "Invalid option: %s\n", argv[i]);
+			return 1;
+		}
+	}
+	FILE *fp = NULL;
+	if (json){
+		fp = fopen(json, "w");
+		if (fp == NULL){
+			fprintf(stderr, "Failed to open: %s\n", json);
+			return 1;
+		}
+		fprintf(fp, "{\n  \"bench\": \"pairs\",\n  \"inputs\": %d,\n  \"results\": [", MICRO_N);
+	}
+
+	micro_init();
+	printf("float vs fixed-point functions on the same %d inputs, per call\n", MICRO_N);
+	printf("ratio is fixed time / float time, and errors are of the fixed-point results against\n"
+		"the float results, in radians for angles\n\n");
+	printf("%-28s %9s %9s %7s %12s %12s\n", "function", "float ns", "fixed ns", "ratio", "max err",
+		"mean err");
+	static unsigned char fres[sizeof(out)];
+	int count = 0;
+	for (size_t i = 0; i < sizeof(micro_funcs) / sizeof(micro_funcs[0]); i++){
+		const micro_func *x = &micro_funcs[i];
+		const micro_func *f = pair_twin(x);
+		if (f == NULL || (filter && strstr(x->name, filter) == NULL && strstr(f->name, filter) == NULL))
+			continue;
+		size_t fops, xops;
+		double fsec = micro_time(f->run, &fops);
+		double xsec = micro_time(x->run, &xops);
+		double fns = fsec * 1e9 / fops, xns = xsec * 1e9 / xops;
+
+		// both functions see the same inputs on the first round, so compare their results
+		f->run(1);
+		memcpy(fres, &out, sizeof(out));
+		x->run(1);
+		bool ang = strcmp(x->kind, "a") == 0 || strstr(x->name, "angle") != NULL;
+		double maxerr = 0, sumerr = 0;
+		size_t n = 0;
+		for (size_t e = 0; e < MICRO_N * (x->size / 4); e++){
+			float fv;
+			int32_t xv;
+			memcpy(&fv, fres + e * 4, 4);
+			memcpy(&xv, (unsigned char *)&out + e * 4, 4);
+			// skip results that xint can't represent, like tangents near the poles
+			if (!isfinite(fv) || (!ang && fabsf(fv) >= 32767.0f))
+				continue;
+			double err;
+			if (ang){
+				err = fmod(xang_todouble(xv) - fv, TAUd);
+				if (err > TAUd / 2)
+					err -= TAUd;
+				else if (err < -TAUd / 2)
+					err += TAUd;
+			}
+			else
+				err = xint_todouble(xv) - fv;
+			err = fabs(err);
+			if (err > maxerr)
+				maxerr = err;
+			sumerr += err;
+			n++;
+		}
+		double meanerr = n ? sumerr / n : 0;
+		printf("%-28s %9.3f %9.3f %7.2f %12.6g %12.6g\n", x->name, fns, xns, xns / fns, maxerr,
+			meanerr);
+		if (fp){
+			fprintf(fp, "%s\n    { \"float\": \"%s\", \"fixed\": \"%s\", \"float_ns\": %.4f, "
+				"\"fixed_ns\": %.4f, \"ratio\": %.4f, \"max_err\": %.9g, \"mean_err\": %.9g }",
+				count == 0 ? "" : ",", f->name, x->name, fns, xns, xns / fns, maxerr, meanerr);
+		}
+		count++;
+	}
+	sink = out.f[0];
+	if (fp){
+		fprintf(fp, "\n  ]\n}\n");
+		fclose(fp);
+	}
+	if (count == 0){
+		fprintf(stderr, "No pairs match: %s\n", filter);
+		return 1;
+	}
+	return 0;
+}
+
+static void print_help(){
+	printf(
+		"NVQM benchmark suite\n\n"
+		"Please select a benchmark via:\n"
+		"  $ ./bench <benchname>\n\n"
+		"Or time every function, optionally only names containing `filter`, and save the results:\n"
+		"  $ ./bench micro [filter] [--json <file>]\n\n"
+		"Or time each float function against its fixed-point version, and compare the results:\n"
+		"  $ ./bench pairs [filter] [--json <file>]\n\n"
+		"Benchmarks:\n\n"
+		"  Bench Name        Description\n"
+		"  ----------        -----------\n"
+		"  applymat4     ->  vec3_applymat4 per-call loop vs array functions\n"
+		"  mat4_mul      ->  mat4_mul independent and chained multiplies\n"
+		"  soa           ->  AoS loops vs structure of arrays functions\n"
+		"  chain         ->  transform chain, compare with -DNVQM_INLINE_ALL\n"
+		"  invert        ->  mat4_invert vs affine, rigid, and fast versions\n"
+		"  affine        ->  mat4_mul vs mat4_mul_affine and mat4x3\n"
+		"  slerp         ->  quat_slerp/quat_nlerp per-call loop vs array functions\n"
+		"  normal        ->  vec3_normal vs vec3_fnormal, per-call and batched\n"
+		"  hierarchy     ->  full scene graph rebuild vs dirty subtree updates\n"
+		"  cull          ->  frustum culling of spheres and boxes\n"
+		"  sqrt          ->  xint_sqrt vs the old bitwise search, and xint_rsqrt\n"
+		"  pow           ->  xint_pow with small and huge exponents\n"
+		"  atan2         ->  xint_atan2 vs the old polynomial, and xint_acos/xint_asin\n"
+		"  lut           ->  sin/cos under cache pressure, compare with -DNVQM_QUARTER_LUT\n"
+		"  xdot          ->  xmat4_mul and xvec3 transforms, compare with -DNVQM_XINT_ROUND_EACH\n"
+		"  xarray        ->  fixed-point entity update, per-call loop vs array functions\n"
+		"  xdiv          ->  xint_div vs xint_div_by and xvec3_divs_array with one divisor\n"
+		"  xlong         ->  Q32.32 distances, multiplies, and determinants\n"
+	);
+}
+
+static const char *benchname;
+bool B(const char *bench){ return strcmp(benchname, bench) == 0; }
+int main(int argc, char **argv){
+	if (argc < 2){
+		print_help();
+		return 1;
+	}
+	benchname = argv[1];
+	if (B("micro"    )) return bench_micro(argc, argv);
+	if (B("pairs"    )) return bench_pairs(argc, argv);
+	if (B("applymat4")) return bench_applymat4();
+	if (B("mat4_mul" )) return bench_mat4_mul();
+	if (B("soa"      )) return bench_soa();
+	if (B("chain"    )) return bench_chain();
+	if (B("invert"   )) return bench_invert();
+	if (B("affine"   )) return bench_affine();
+	if (B("slerp"    )) return bench_slerp();
+	if (B("normal"   )) return bench_normal();
+	if (B("hierarchy")) return bench_hierarchy();
+	if (B("cull"     )) return bench_cull();
+	if (B("sqrt"     )) return bench_sqrt();
+	if (B("pow"      )) return bench_pow();
+	if (B("atan2"    )) return bench_atan2();
+	if (B("lut"      )) return bench_lut();
+	if (B("xdot"     )) return bench_xdot();
+	if (B("xarray"   )) return bench_xarray();
+	if (B("xdiv"     )) return bench_xdiv();
+	if (B("xlong"    )) return bench_xlong();
+	print_help();
+	fprintf(stderr, "Invalid benchmark: %s\n", argv[1]);
+	return 1;
+}
@@ -3,15 +3,122 @@
  * Project Home: https://github.com/voidqk/nvqm
  */
 
+#ifndef NVQM__C
+#define NVQM__C
+
 #include "nvqm.h"
 
+#ifdef NVQM_INLINE_ALL
+#	define NVQM_LUT_DATA  static const
+#else
+#	define NVQM_LUT_DATA  const
+#endif
+
+/* wider instruction sets are chosen at runtime via CPUID, so the library still runs on older CPUs
+ * NVQM_INLINE_ALL skips the runtime choice, since calling through a pointer would defeat inlining
+ * the FMA kernels give slightly different results than the C code, so they must be enabled by
+ * defining NVQM_FMA
+ */
+#if defined(NVQM_SSE2) && !defined(NVQM_INLINE_ALL) && (defined(__GNUC__) || defined(_MSC_VER))
+#	define NVQM_DISPATCH
+#	include <immintrin.h>
+#	if defined(_MSC_VER)
+#		include <intrin.h>
+#		define NVQM_TARGET(t)
+#	else
+#		include <cpuid.h>
+#		define NVQM_TARGET(t) __attribute__((target(t)))
+#	endif
+
+#define CPU_SSE41  1
+#define CPU_AVX    2
+#define CPU_AVX2   4
+#define CPU_FMA    8
+
+static int cpu_detect(){
+	unsigned int r[4] = {0}, xcr0 = 0;
+	int res = 0;
+#	if defined(_MSC_VER)
+	__cpuid((int *)r, 0);
+	if (r[0] < 1)
+		return 0;
+	__cpuid((int *)r, 1);
+#	else
+	if (!__get_cpuid(1, &r[0], &r[1], &r[2], &r[3]))
+		return 0;
+#	endif
+	if (r[2] & (1 << 19))
+		res |= CPU_SSE41;
+	/* AVX also requires the OS to save the ymm registers, checked via XGETBV */
+	if ((r[2] & (1 << 27)) && (r[2] & (1 << 28))){
+#		if defined(_MSC_VER)
+		xcr0 = (unsigned int)_xgetbv(0);
+#		else
+		unsigned int edx;
+		__asm__ volatile ("xgetbv" : "=a"(xcr0), "=d"(edx) : "c"(0));
+#		endif
+		if ((xcr0 & 6) == 6){
+			res |= CPU_AVX;
+			if (r[2] & (1 << 12))
+				res |= CPU_FMA;
+#			if defined(_MSC_VER)
+			__cpuidex((int *)r, 7, 0);
+#			else
+			if (!__get_cpuid_count(7, 0, &r[0], &r[1], &r[2], &r[3]))
+				r[1] = 0;
+#			endif
+			if (r[1] & (1 << 5))
+				res |= CPU_AVX2;
+		}
+	}
+	return res;
+}
+
+static int cpu_features(){
+	/* racing threads will calculate the same value, so no need for locking */
+	static volatile int features = -1;
+	if (features < 0)
+		features = cpu_detect();
+	return features;
+}
+#endif
+
+#ifdef NVQM_SSE2
+static inline void sse_load3x4(float *p, __m128 *x, __m128 *y, __m128 *z){
+	/* load 4 vec3's and transpose them into x, y, z lanes */
+	__m128
+		p0 = _mm_loadu_ps(p    ), /* x0 y0 z0 x1 */
+		p1 = _mm_loadu_ps(p + 4), /* y1 z1 x2 y2 */
+		p2 = _mm_loadu_ps(p + 8), /* z2 x3 y3 z3 */
+		t0 = _mm_shuffle_ps(p1, p2, _MM_SHUFFLE(2, 1, 3, 2)), /* x2 y2 x3 y3 */
+		t1 = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(1, 0, 2, 1)); /* y0 z0 y1 z1 */
+	*x = _mm_shuffle_ps(p0, t0, _MM_SHUFFLE(2, 0, 3, 0));
+	*y = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+	*z = _mm_shuffle_ps(t1, p2, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+static inline void sse_store3x4(float *p, __m128 x, __m128 y, __m128 z){
+	/* inverse of sse_load3x4 */
+	__m128
+		xy0 = _mm_unpacklo_ps(x, y), /* x0 y0 x1 y1 */
+		xy1 = _mm_unpackhi_ps(x, y), /* x2 y2 x3 y3 */
+		zx  = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), /* z0 z0 x1 x1 */
+		yz  = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), /* y1 y1 z1 z1 */
+		zx3 = _mm_shuffle_ps(z, xy1, _MM_SHUFFLE(2, 2, 2, 2)), /* z2 z2 x3 x3 */
+		yz3 = _mm_shuffle_ps(xy1, z, _MM_SHUFFLE(3, 3, 3, 3)); /* y3 y3 z3 z3 */
+	_mm_storeu_ps(p    , _mm_shuffle_ps(xy0, zx, _MM_SHUFFLE(2, 0, 1, 0)));
+	_mm_storeu_ps(p + 4, _mm_shuffle_ps(yz, xy1, _MM_SHUFFLE(1, 0, 2, 0)));
+	_mm_storeu_ps(p + 8, _mm_shuffle_ps(zx3, yz3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+#endif
+
 #ifndef NVQM_SKIP_FLOATING_POINT
 
 /*
  * mat3
  */
 
-mat3 *mat3_add(mat3 *out, mat3 *a, mat3 *b){
+NVQM_API mat3 *mat3_add(mat3 *out, mat3 *a, mat3 *b){
 	out->v[0] = a->v[0] + b->v[0];
 	out->v[1] = a->v[1] + b->v[1];
 	out->v[2] = a->v[2] + b->v[2];
@@ -24,7 +131,7 @@ mat3 *mat3_add(mat3 *out, mat3 *a, mat3 *b){
 	return out;
 }
 
-mat3 *mat3_adjoint(mat3 *out, mat3 *a){
+NVQM_API mat3 *mat3_adjoint(mat3 *out, mat3 *a){
 	float
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -41,7 +148,7 @@ mat3 *mat3_adjoint(mat3 *out, mat3 *a){
 	return out;
 }
 
-mat3 *mat3_compmul(mat3 *out, mat3 *a, mat3 *b){
+NVQM_API mat3 *mat3_compmul(mat3 *out, mat3 *a, mat3 *b){
 	out->v[0] = a->v[0] * b->v[0];
 	out->v[1] = a->v[1] * b->v[1];
 	out->v[2] = a->v[2] * b->v[2];
@@ -54,14 +161,14 @@ mat3 *mat3_compmul(mat3 *out, mat3 *a, mat3 *b){
 	return out;
 }
 
-mat3 *mat3_copy(mat3 *out, mat3 *a){
+NVQM_API mat3 *mat3_copy(mat3 *out, mat3 *a){
 	out->v[0] = a->v[0]; out->v[1] = a->v[1]; out->v[2] = a->v[2];
 	out->v[3] = a->v[3]; out->v[4] = a->v[4]; out->v[5] = a->v[5];
 	out->v[6] = a->v[6]; out->v[7] = a->v[7]; out->v[8] = a->v[8];
 	return out;
 }
 
-float mat3_det(mat3 *a){
+NVQM_API float mat3_det(mat3 *a){
 	float
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -72,14 +179,14 @@ float mat3_det(mat3 *a){
 		a02 * ( a21 * a10 - a11 * a20);
 }
 
-mat3 *mat3_identity(mat3 *out){
+NVQM_API mat3 *mat3_identity(mat3 *out){
 	out->v[0] = 1.0f; out->v[1] = 0.0f; out->v[2] = 0.0f;
 	out->v[3] = 0.0f; out->v[4] = 1.0f; out->v[5] = 0.0f;
 	out->v[6] = 0.0f; out->v[7] = 0.0f; out->v[8] = 1.0f;
 	return out;
 }
 
-mat3 *mat3_invert(mat3 *out, mat3 *a){
+NVQM_API mat3 *mat3_invert(mat3 *out, mat3 *a){
 	float
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -103,7 +210,7 @@ mat3 *mat3_invert(mat3 *out, mat3 *a){
 	return out;
 }
 
-mat3 *mat3_mul(mat3 *out, mat3 *a, mat3 *b){
+NVQM_API mat3 *mat3_mul(mat3 *out, mat3 *a, mat3 *b){
 	float
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -123,7 +230,7 @@ mat3 *mat3_mul(mat3 *out, mat3 *a, mat3 *b){
 	return out;
 }
 
-mat3 *mat3_quat(mat3 *out, quat a){
+NVQM_API mat3 *mat3_quat(mat3 *out, quat a){
 	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax + ax,
 		ay2 = ay + ay,
@@ -149,7 +256,7 @@ mat3 *mat3_quat(mat3 *out, quat a){
 	return out;
 }
 
-mat3 *mat3_rotate(mat3 *out, mat3 *a, float ang){
+NVQM_API mat3 *mat3_rotate(mat3 *out, mat3 *a, float ang){
 	float
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -167,7 +274,7 @@ mat3 *mat3_rotate(mat3 *out, mat3 *a, float ang){
 	return out;
 }
 
-mat3 *mat3_rotation(mat3 *out, float ang){
+NVQM_API mat3 *mat3_rotation(mat3 *out, float ang){
 	float s = num_sin(ang), c = num_cos(ang);
 	out->v[0] =  c;
 	out->v[1] =  s;
@@ -181,7 +288,7 @@ mat3 *mat3_rotation(mat3 *out, float ang){
 	return out;
 }
 
-mat3 *mat3_scale(mat3 *out, mat3 *a, vec2 b){
+NVQM_API mat3 *mat3_scale(mat3 *out, mat3 *a, vec2 b){
 	float bx = b.v[0], by = b.v[1];
 	out->v[0] = bx * a->v[0];
 	out->v[1] = bx * a->v[1];
@@ -195,7 +302,7 @@ mat3 *mat3_scale(mat3 *out, mat3 *a, vec2 b){
 	return out;
 }
 
-mat3 *mat3_scaling(mat3 *out, vec2 a){
+NVQM_API mat3 *mat3_scaling(mat3 *out, vec2 a){
 	out->v[0] = a.v[0];
 	out->v[1] = 0.0f;
 	out->v[2] = 0.0f;
@@ -208,7 +315,7 @@ mat3 *mat3_scaling(mat3 *out, vec2 a){
 	return out;
 }
 
-mat3 *mat3_sub(mat3 *out, mat3 *a, mat3 *b){
+NVQM_API mat3 *mat3_sub(mat3 *out, mat3 *a, mat3 *b){
 	out->v[0] = a->v[0] - b->v[0];
 	out->v[1] = a->v[1] - b->v[1];
 	out->v[2] = a->v[2] - b->v[2];
@@ -221,7 +328,7 @@ mat3 *mat3_sub(mat3 *out, mat3 *a, mat3 *b){
 	return out;
 }
 
-mat3 *mat3_translate(mat3 *out, mat3 *a, vec2 b){
+NVQM_API mat3 *mat3_translate(mat3 *out, mat3 *a, vec2 b){
 	float
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -239,7 +346,7 @@ mat3 *mat3_translate(mat3 *out, mat3 *a, vec2 b){
 	return out;
 }
 
-mat3 *mat3_translation(mat3 *out, vec2 a){
+NVQM_API mat3 *mat3_translation(mat3 *out, vec2 a){
 	out->v[0] = 1.0f;
 	out->v[1] = 0.0f;
 	out->v[2] = 0.0f;
@@ -252,7 +359,7 @@ mat3 *mat3_translation(mat3 *out, vec2 a){
 	return out;
 }
 
-mat3 *mat3_transpose(mat3 *out, mat3 *a){
+NVQM_API mat3 *mat3_transpose(mat3 *out, mat3 *a){
 	if (out == a) {
 		float a01 = a->v[1], a02 = a->v[2], a12 = a->v[5];
 		out->v[1] = a->v[3];
@@ -280,7 +387,7 @@ mat3 *mat3_transpose(mat3 *out, mat3 *a){
  * mat4
  */
 
-mat4 *mat4_add(mat4 *out, mat4 *a, mat4 *b){
+NVQM_API mat4 *mat4_add(mat4 *out, mat4 *a, mat4 *b){
 	out->v[ 0] = a->v[ 0] + b->v[ 0];
 	out->v[ 1] = a->v[ 1] + b->v[ 1];
 	out->v[ 2] = a->v[ 2] + b->v[ 2];
@@ -300,7 +407,7 @@ mat4 *mat4_add(mat4 *out, mat4 *a, mat4 *b){
 	return out;
 }
 
-mat4 *mat4_adjoint(mat4 *out, mat4 *a){
+NVQM_API mat4 *mat4_adjoint(mat4 *out, mat4 *a){
 	float
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -373,7 +480,7 @@ mat4 *mat4_adjoint(mat4 *out, mat4 *a){
 	return out;
 }
 
-mat4 *mat4_compmul(mat4 *out, mat4 *a, mat4 *b){
+NVQM_API mat4 *mat4_compmul(mat4 *out, mat4 *a, mat4 *b){
 	out->v[ 0] = a->v[ 0] * b->v[ 0];
 	out->v[ 1] = a->v[ 1] * b->v[ 1];
 	out->v[ 2] = a->v[ 2] * b->v[ 2];
@@ -393,7 +500,7 @@ mat4 *mat4_compmul(mat4 *out, mat4 *a, mat4 *b){
 	return out;
 }
 
-mat4 *mat4_copy(mat4 *out, mat4 *a){
+NVQM_API mat4 *mat4_copy(mat4 *out, mat4 *a){
 	out->v[ 0] = a->v[ 0]; out->v[ 1] = a->v[ 1]; out->v[ 2] = a->v[ 2]; out->v[ 3] = a->v[ 3];
 	out->v[ 4] = a->v[ 4]; out->v[ 5] = a->v[ 5]; out->v[ 6] = a->v[ 6]; out->v[ 7] = a->v[ 7];
 	out->v[ 8] = a->v[ 8]; out->v[ 9] = a->v[ 9]; out->v[10] = a->v[10]; out->v[11] = a->v[11];
@@ -401,7 +508,7 @@ mat4 *mat4_copy(mat4 *out, mat4 *a){
 	return out;
 }
 
-float mat4_det(mat4 *a){
+NVQM_API float mat4_det(mat4 *a){
 	float
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -422,7 +529,7 @@ float mat4_det(mat4 *a){
 	return b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06;
 }
 
-mat4 *mat4_frustum(mat4 *out, float L, float R, float B, float T, float N, float F){
+NVQM_API mat4 *mat4_frustum(mat4 *out, float L, float R, float B, float T, float N, float F){
 	float
 		rl = 1.0f / (R - L),
 		tb = 1.0f / (T - B),
@@ -446,7 +553,7 @@ mat4 *mat4_frustum(mat4 *out, float L, float R, float B, float T, float N, float
 	return out;
 }
 
-mat4 *mat4_identity(mat4 *out){
+NVQM_API mat4 *mat4_identity(mat4 *out){
 	out->v[ 0] = 1.0f; out->v[ 1] = 0.0f; out->v[ 2] = 0.0f; out->v[ 3] = 0.0f;
 	out->v[ 4] = 0.0f; out->v[ 5] = 1.0f; out->v[ 6] = 0.0f; out->v[ 7] = 0.0f;
 	out->v[ 8] = 0.0f; out->v[ 9] = 0.0f; out->v[10] = 1.0f; out->v[11] = 0.0f;
@@ -454,7 +561,7 @@ mat4 *mat4_identity(mat4 *out){
 	return out;
 }
 
-mat4 *mat4_invert(mat4 *out, mat4 *a){
+NVQM_API mat4 *mat4_invert(mat4 *out, mat4 *a){
 	float
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -495,7 +602,96 @@ mat4 *mat4_invert(mat4 *out, mat4 *a){
 	return out;
 }
 
-mat4 *mat4_lookat(mat4 *out, vec3 eye, vec3 position, vec3 up){
+NVQM_API mat4 *mat4_invert_affine(mat4 *out, mat4 *a){
+	/* assumes the bottom row is [0, 0, 0, 1], so only the 3x3 part needs a real inverse */
+	float
+		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2],
+		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6],
+		a20 = a->v[ 8], a21 = a->v[ 9], a22 = a->v[10],
+		a30 = a->v[12], a31 = a->v[13], a32 = a->v[14],
+		b01 =  a22 * a11 - a12 * a21,
+		b11 = -a22 * a10 + a12 * a20,
+		b21 =  a21 * a10 - a11 * a20;
+	float det = a00 * b01 + a01 * b11 + a02 * b21;
+	if (det == 0.0f)
+		return (mat4 *)0;
+	det = 1.0f / det;
+	float
+		c00 =   b01                    * det,
+		c01 = (-a22 * a01 + a02 * a21) * det,
+		c02 = ( a12 * a01 - a02 * a11) * det,
+		c10 =   b11                    * det,
+		c11 = ( a22 * a00 - a02 * a20) * det,
+		c12 = (-a12 * a00 + a02 * a10) * det,
+		c20 =   b21                    * det,
+		c21 = (-a21 * a00 + a01 * a20) * det,
+		c22 = ( a11 * a00 - a01 * a10) * det;
+	out->v[ 0] = c00;
+	out->v[ 1] = c01;
+	out->v[ 2] = c02;
+	out->v[ 3] = 0.0f;
+	out->v[ 4] = c10;
+	out->v[ 5] = c11;
+	out->v[ 6] = c12;
+	out->v[ 7] = 0.0f;
+	out->v[ 8] = c20;
+	out->v[ 9] = c21;
+	out->v[10] = c22;
+	out->v[11] = 0.0f;
+	out->v[12] = -(c00 * a30 + c10 * a31 + c20 * a32);
+	out->v[13] = -(c01 * a30 + c11 * a31 + c21 * a32);
+	out->v[14] = -(c02 * a30 + c12 * a31 + c22 * a32);
+	out->v[15] = 1.0f;
+	return out;
+}
+
+NVQM_API mat4 *mat4_invert_fast(mat4 *out, mat4 *a){
+	if (a->v[3] != 0.0f || a->v[7] != 0.0f || a->v[11] != 0.0f || a->v[15] != 1.0f)
+		return mat4_invert(out, a);
+	/* rigid when the 3x3 columns are orthonormal, within the error of mat4_rottrans/mat4_lookat */
+	float
+		a00 = a->v[0], a01 = a->v[1], a02 = a->v[ 2],
+		a10 = a->v[4], a11 = a->v[5], a12 = a->v[ 6],
+		a20 = a->v[8], a21 = a->v[9], a22 = a->v[10],
+		d0 = a00 * a00 + a01 * a01 + a02 * a02 - 1.0f,
+		d1 = a10 * a10 + a11 * a11 + a12 * a12 - 1.0f,
+		d2 = a20 * a20 + a21 * a21 + a22 * a22 - 1.0f,
+		d3 = a00 * a10 + a01 * a11 + a02 * a12,
+		d4 = a00 * a20 + a01 * a21 + a02 * a22,
+		d5 = a10 * a20 + a11 * a21 + a12 * a22;
+	if (d0 * d0 + d1 * d1 + d2 * d2 + d3 * d3 + d4 * d4 + d5 * d5 < 1e-10f)
+		return mat4_invert_rigid(out, a);
+	return mat4_invert_affine(out, a);
+}
+
+NVQM_API mat4 *mat4_invert_rigid(mat4 *out, mat4 *a){
+	/* assumes rotation and translation only, so the inverse is the transpose with the translation
+	 * rotated back and negated */
+	float
+		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2],
+		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6],
+		a20 = a->v[ 8], a21 = a->v[ 9], a22 = a->v[10],
+		a30 = a->v[12], a31 = a->v[13], a32 = a->v[14];
+	out->v[ 0] = a00;
+	out->v[ 1] = a10;
+	out->v[ 2] = a20;
+	out->v[ 3] = 0.0f;
+	out->v[ 4] = a01;
+	out->v[ 5] = a11;
+	out->v[ 6] = a21;
+	out->v[ 7] = 0.0f;
+	out->v[ 8] = a02;
+	out->v[ 9] = a12;
+	out->v[10] = a22;
+	out->v[11] = 0.0f;
+	out->v[12] = -(a00 * a30 + a01 * a31 + a02 * a32);
+	out->v[13] = -(a10 * a30 + a11 * a31 + a12 * a32);
+	out->v[14] = -(a20 * a30 + a21 * a31 + a22 * a32);
+	out->v[15] = 1.0f;
+	return out;
+}
+
+NVQM_API mat4 *mat4_lookat(mat4 *out, vec3 eye, vec3 position, vec3 up){
 	float
 		ex = eye.v[0], ey = eye.v[1], ez = eye.v[2],
 		ux = up.v[0], uy = up.v[1], uz = up.v[2],
@@ -564,7 +760,8 @@ mat4 *mat4_lookat(mat4 *out, vec3 eye, vec3 position, vec3 up){
 	return out;
 }
 
-mat4 *mat4_mul(mat4 *out, mat4 *a, mat4 *b){
+#ifndef NVQM_SSE2
+NVQM_API mat4 *mat4_mul(mat4 *out, mat4 *a, mat4 *b){
 	float
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -605,8 +802,217 @@ mat4 *mat4_mul(mat4 *out, mat4 *a, mat4 *b){
 	out->v[15] = b0 * a03 + b1 * a13 + b2 * a23 + b3 * a33;
 	return out;
 }
+#else
+/* the kernels below calculate each output column as ((b0 * a0 + b1 * a1) + b2 * a2) + b3 * a3,
+ * which is the same order as the C version, so the results are bitwise identical
+ * each column of `b` is read before that column of `out` is written, so out == b still works
+ */
+
+static mat4 *mat4_mul_sse2(mat4 *out, mat4 *a, mat4 *b){
+	__m128
+		a0 = _mm_loadu_ps(&a->v[ 0]),
+		a1 = _mm_loadu_ps(&a->v[ 4]),
+		a2 = _mm_loadu_ps(&a->v[ 8]),
+		a3 = _mm_loadu_ps(&a->v[12]);
+	for (int i = 0; i < 16; i += 4){
+		__m128 bc = _mm_loadu_ps(&b->v[i]);
+		_mm_storeu_ps(&out->v[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)), a0),
+			_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1)), a1)),
+			_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2)), a2)),
+			_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3)), a3)));
+	}
+	return out;
+}
+
+#ifdef NVQM_DISPATCH
+/* AVX calculates two columns at once, with each column of `a` copied into both 128-bit lanes */
+
+NVQM_TARGET("avx")
+static mat4 *mat4_mul_avx(mat4 *out, mat4 *a, mat4 *b){
+	__m256
+		a0 = _mm256_broadcast_ps((const __m128 *)&a->v[ 0]),
+		a1 = _mm256_broadcast_ps((const __m128 *)&a->v[ 4]),
+		a2 = _mm256_broadcast_ps((const __m128 *)&a->v[ 8]),
+		a3 = _mm256_broadcast_ps((const __m128 *)&a->v[12]);
+	for (int i = 0; i < 16; i += 8){
+		__m256 bc = _mm256_loadu_ps(&b->v[i]);
+		_mm256_storeu_ps(&out->v[i], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)), a0),
+			_mm256_mul_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1)), a1)),
+			_mm256_mul_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2)), a2)),
+			_mm256_mul_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3)), a3)));
+	}
+	return out;
+}
+
+#ifdef NVQM_FMA
+/* fused multiply-add rounds once per step, so results can differ from the C version in the last bit */
+NVQM_TARGET("avx,fma")
+static mat4 *mat4_mul_fma(mat4 *out, mat4 *a, mat4 *b){
+	__m256
+		a0 = _mm256_broadcast_ps((const __m128 *)&a->v[ 0]),
+		a1 = _mm256_broadcast_ps((const __m128 *)&a->v[ 4]),
+		a2 = _mm256_broadcast_ps((const __m128 *)&a->v[ 8]),
+		a3 = _mm256_broadcast_ps((const __m128 *)&a->v[12]);
+	for (int i = 0; i < 16; i += 8){
+		__m256 bc = _mm256_loadu_ps(&b->v[i]);
+		_mm256_storeu_ps(&out->v[i],
+			_mm256_fmadd_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3)), a3,
+			_mm256_fmadd_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2)), a2,
+			_mm256_fmadd_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1)), a1,
+			_mm256_mul_ps(_mm256_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)), a0)))));
+	}
+	return out;
+}
+#endif
+
+static mat4 *mat4_mul_init(mat4 *out, mat4 *a, mat4 *b);
+static mat4 *(*mat4_mul_f)(mat4 *out, mat4 *a, mat4 *b) = mat4_mul_init;
+
+static mat4 *mat4_mul_init(mat4 *out, mat4 *a, mat4 *b){
+	/* first call picks the best kernel for the CPU, and replaces itself */
+	int cpu = cpu_features();
+#ifdef NVQM_FMA
+	if ((cpu & CPU_AVX) && (cpu & CPU_FMA))
+		mat4_mul_f = mat4_mul_fma;
+	else
+#endif
+	if (cpu & CPU_AVX)
+		mat4_mul_f = mat4_mul_avx;
+	else
+		mat4_mul_f = mat4_mul_sse2;
+	return mat4_mul_f(out, a, b);
+}
+
+NVQM_API mat4 *mat4_mul(mat4 *out, mat4 *a, mat4 *b){
+	return mat4_mul_f(out, a, b);
+}
+#else
+NVQM_API mat4 *mat4_mul(mat4 *out, mat4 *a, mat4 *b){
+	return mat4_mul_sse2(out, a, b);
+}
+#endif /* NVQM_DISPATCH */
+#endif /* NVQM_SSE2 */
+
+#ifdef NVQM_SSE2
+/* same column order as mat4_mul without the fourth term, and the masks replace the fourth lanes with
+ * the constant row */
+
+static inline __m128 mat4_mul_affine_col(const float *b, __m128 a0, __m128 a1, __m128 a2){
+	__m128 bc = _mm_loadu_ps(b);
+	return _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)), a0),
+		_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1)), a1)),
+		_mm_mul_ps(_mm_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2)), a2));
+}
+
+static mat4 *mat4_mul_affine_sse2(mat4 *out, mat4 *a, mat4 *b){
+	__m128
+		m  = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)),
+		a0 = _mm_loadu_ps(&a->v[ 0]),
+		a1 = _mm_loadu_ps(&a->v[ 4]),
+		a2 = _mm_loadu_ps(&a->v[ 8]),
+		a3 = _mm_loadu_ps(&a->v[12]),
+		c0 = mat4_mul_affine_col(&b->v[ 0], a0, a1, a2),
+		c1 = mat4_mul_affine_col(&b->v[ 4], a0, a1, a2),
+		c2 = mat4_mul_affine_col(&b->v[ 8], a0, a1, a2),
+		c3 = mat4_mul_affine_col(&b->v[12], a0, a1, a2);
+	_mm_storeu_ps(&out->v[ 0], _mm_and_ps(c0, m));
+	_mm_storeu_ps(&out->v[ 4], _mm_and_ps(c1, m));
+	_mm_storeu_ps(&out->v[ 8], _mm_and_ps(c2, m));
+	_mm_storeu_ps(&out->v[12], _mm_or_ps(_mm_and_ps(_mm_add_ps(c3, a3), m),
+		_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f)));
+	return out;
+}
+
+#ifdef NVQM_DISPATCH
+NVQM_TARGET("avx")
+static mat4 *mat4_mul_affine_avx(mat4 *out, mat4 *a, mat4 *b){
+	__m256
+		m  = _mm256_castsi256_ps(_mm256_set_epi32(0, -1, -1, -1, 0, -1, -1, -1)),
+		w  = _mm256_set_ps(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f),
+		a0 = _mm256_broadcast_ps((const __m128 *)&a->v[ 0]),
+		a1 = _mm256_broadcast_ps((const __m128 *)&a->v[ 4]),
+		a2 = _mm256_broadcast_ps((const __m128 *)&a->v[ 8]),
+		a3 = _mm256_broadcast_ps((const __m128 *)&a->v[12]),
+		b0 = _mm256_loadu_ps(&b->v[0]),
+		b1 = _mm256_loadu_ps(&b->v[8]),
+		c0 = _mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(_mm256_shuffle_ps(b0, b0, _MM_SHUFFLE(0, 0, 0, 0)), a0),
+			_mm256_mul_ps(_mm256_shuffle_ps(b0, b0, _MM_SHUFFLE(1, 1, 1, 1)), a1)),
+			_mm256_mul_ps(_mm256_shuffle_ps(b0, b0, _MM_SHUFFLE(2, 2, 2, 2)), a2)),
+		c1 = _mm256_add_ps(_mm256_add_ps(
+			_mm256_mul_ps(_mm256_shuffle_ps(b1, b1, _MM_SHUFFLE(0, 0, 0, 0)), a0),
+			_mm256_mul_ps(_mm256_shuffle_ps(b1, b1, _MM_SHUFFLE(1, 1, 1, 1)), a1)),
+			_mm256_mul_ps(_mm256_shuffle_ps(b1, b1, _MM_SHUFFLE(2, 2, 2, 2)), a2));
+	/* only the translation column (upper lane of c1) gets the fourth term */
+	c1 = _mm256_blend_ps(c1, _mm256_add_ps(c1, a3), 0xF0);
+	_mm256_storeu_ps(&out->v[0], _mm256_and_ps(c0, m));
+	_mm256_storeu_ps(&out->v[8], _mm256_or_ps(_mm256_and_ps(c1, m), w));
+	return out;
+}
 
-mat4 *mat4_orthogonal(mat4 *out, float W, float H, float N, float F){
+static mat4 *mat4_mul_affine_init(mat4 *out, mat4 *a, mat4 *b);
+static mat4 *(*mat4_mul_affine_f)(mat4 *out, mat4 *a, mat4 *b) = mat4_mul_affine_init;
+
+static mat4 *mat4_mul_affine_init(mat4 *out, mat4 *a, mat4 *b){
+	if (cpu_features() & CPU_AVX)
+		mat4_mul_affine_f = mat4_mul_affine_avx;
+	else
+		mat4_mul_affine_f = mat4_mul_affine_sse2;
+	return mat4_mul_affine_f(out, a, b);
+}
+#endif /* NVQM_DISPATCH */
+#endif /* NVQM_SSE2 */
+
+NVQM_API mat4 *mat4_mul_affine(mat4 *out, mat4 *a, mat4 *b){
+	/* assumes the bottom rows of `a` and `b` are [0, 0, 0, 1], so the bottom row of the result is
+	 * constant and the fourth term only survives in the translation column */
+#if defined(NVQM_DISPATCH)
+	return mat4_mul_affine_f(out, a, b);
+#elif defined(NVQM_SSE2)
+	return mat4_mul_affine_sse2(out, a, b);
+#else
+	float
+		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2],
+		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6],
+		a20 = a->v[ 8], a21 = a->v[ 9], a22 = a->v[10],
+		a30 = a->v[12], a31 = a->v[13], a32 = a->v[14];
+	float b0, b1, b2;
+	b0 = b->v[ 0];
+	b1 = b->v[ 1];
+	b2 = b->v[ 2];
+	out->v[ 0] = b0 * a00 + b1 * a10 + b2 * a20;
+	out->v[ 1] = b0 * a01 + b1 * a11 + b2 * a21;
+	out->v[ 2] = b0 * a02 + b1 * a12 + b2 * a22;
+	out->v[ 3] = 0.0f;
+	b0 = b->v[ 4];
+	b1 = b->v[ 5];
+	b2 = b->v[ 6];
+	out->v[ 4] = b0 * a00 + b1 * a10 + b2 * a20;
+	out->v[ 5] = b0 * a01 + b1 * a11 + b2 * a21;
+	out->v[ 6] = b0 * a02 + b1 * a12 + b2 * a22;
+	out->v[ 7] = 0.0f;
+	b0 = b->v[ 8];
+	b1 = b->v[ 9];
+	b2 = b->v[10];
+	out->v[ 8] = b0 * a00 + b1 * a10 + b2 * a20;
+	out->v[ 9] = b0 * a01 + b1 * a11 + b2 * a21;
+	out->v[10] = b0 * a02 + b1 * a12 + b2 * a22;
+	out->v[11] = 0.0f;
+	b0 = b->v[12];
+	b1 = b->v[13];
+	b2 = b->v[14];
+	out->v[12] = b0 * a00 + b1 * a10 + b2 * a20 + a30;
+	out->v[13] = b0 * a01 + b1 * a11 + b2 * a21 + a31;
+	out->v[14] = b0 * a02 + b1 * a12 + b2 * a22 + a32;
+	out->v[15] = 1.0f;
+	return out;
+#endif
+}
+
+NVQM_API mat4 *mat4_orthogonal(mat4 *out, float W, float H, float N, float F){
 	float nf = 1.0f / (N - F);
 	out->v[ 0] = 2.0f / W;
 	out->v[ 1] = 0.0f;
@@ -627,7 +1033,7 @@ mat4 *mat4_orthogonal(mat4 *out, float W, float H, float N, float F){
 	return out;
 }
 
-mat4 *mat4_perspective(mat4 *out, float fov, float W, float H, float N, float F){
+NVQM_API mat4 *mat4_perspective(mat4 *out, float fov, float W, float H, float N, float F){
 	float
 		f  = 1.0f / num_tan(fov * 0.5f),
 		nf = 1.0f / (N - F);
@@ -650,7 +1056,7 @@ mat4 *mat4_perspective(mat4 *out, float fov, float W, float H, float N, float F)
 	return out;
 }
 
-mat4 *mat4_quat(mat4 *out, quat a){
+NVQM_API mat4 *mat4_quat(mat4 *out, quat a){
 	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax + ax,
 		ay2 = ay + ay,
@@ -683,7 +1089,7 @@ mat4 *mat4_quat(mat4 *out, quat a){
 	return out;
 }
 
-mat4 *mat4_rotate(mat4 *out, mat4 *a, vec3 axis, float ang){
+NVQM_API mat4 *mat4_rotate(mat4 *out, mat4 *a, vec3 axis, float ang){
 	float
 		x = axis.v[0], y = axis.v[1], z = axis.v[2],
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[ 2], a03 = a->v[ 3],
@@ -715,7 +1121,7 @@ mat4 *mat4_rotate(mat4 *out, mat4 *a, vec3 axis, float ang){
 	return out;
 }
 
-mat4 *mat4_rotation(mat4 *out, vec3 axis, float ang){
+NVQM_API mat4 *mat4_rotation(mat4 *out, vec3 axis, float ang){
 	float x = axis.v[0], y = axis.v[1], z = axis.v[2],
 		s = num_sin(ang), c = num_cos(ang),
 		t = 1.0f - c;
@@ -738,7 +1144,7 @@ mat4 *mat4_rotation(mat4 *out, vec3 axis, float ang){
 	return out;
 }
 
-mat4 *mat4_rottrans(mat4 *out, quat a, vec3 b){
+NVQM_API mat4 *mat4_rottrans(mat4 *out, quat a, vec3 b){
 	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax + ax,
 		ay2 = ay + ay,
@@ -771,7 +1177,7 @@ mat4 *mat4_rottrans(mat4 *out, quat a, vec3 b){
 	return out;
 }
 
-mat4 *mat4_rottransorigin(mat4 *out, quat a, vec3 b, vec3 origin){
+NVQM_API mat4 *mat4_rottransorigin(mat4 *out, quat a, vec3 b, vec3 origin){
 	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax + ax,
 		ay2 = ay + ay,
@@ -805,7 +1211,7 @@ mat4 *mat4_rottransorigin(mat4 *out, quat a, vec3 b, vec3 origin){
 	return out;
 }
 
-mat4 *mat4_scale(mat4 *out, mat4 *a, vec3 b){
+NVQM_API mat4 *mat4_scale(mat4 *out, mat4 *a, vec3 b){
 	float bx = b.v[0], by = b.v[1], bz = b.v[2];
 	out->v[ 0] = a->v[ 0] * bx;
 	out->v[ 1] = a->v[ 1] * bx;
@@ -826,7 +1232,7 @@ mat4 *mat4_scale(mat4 *out, mat4 *a, vec3 b){
 	return out;
 }
 
-mat4 *mat4_scaling(mat4 *out, vec3 a){
+NVQM_API mat4 *mat4_scaling(mat4 *out, vec3 a){
 	out->v[ 0] = a.v[0]; out->v[ 1] =   0.0f; out->v[ 2] =   0.0f; out->v[ 3] = 0.0f;
 	out->v[ 4] =   0.0f; out->v[ 5] = a.v[1]; out->v[ 6] =   0.0f; out->v[ 7] = 0.0f;
 	out->v[ 8] =   0.0f; out->v[ 9] =   0.0f; out->v[10] = a.v[2]; out->v[11] = 0.0f;
@@ -834,7 +1240,7 @@ mat4 *mat4_scaling(mat4 *out, vec3 a){
 	return out;
 }
 
-mat4 *mat4_sub(mat4 *out, mat4 *a, mat4 *b){
+NVQM_API mat4 *mat4_sub(mat4 *out, mat4 *a, mat4 *b){
 	out->v[ 0] = a->v[ 0] - b->v[ 0];
 	out->v[ 1] = a->v[ 1] - b->v[ 1];
 	out->v[ 2] = a->v[ 2] - b->v[ 2];
@@ -854,7 +1260,7 @@ mat4 *mat4_sub(mat4 *out, mat4 *a, mat4 *b){
 	return out;
 }
 
-mat4 *mat4_translate(mat4 *out, mat4 *a, vec3 b){
+NVQM_API mat4 *mat4_translate(mat4 *out, mat4 *a, vec3 b){
 	float bx = b.v[0], by = b.v[1], bz = b.v[2];
 	if (out == a){
 		out->v[12] = a->v[0] * bx + a->v[4] * by + a->v[ 8] * bz + a->v[12];
@@ -887,7 +1293,7 @@ mat4 *mat4_translate(mat4 *out, mat4 *a, vec3 b){
 	return out;
 }
 
-mat4 *mat4_translation(mat4 *out, vec3 a){
+NVQM_API mat4 *mat4_translation(mat4 *out, vec3 a){
 	out->v[ 0] = 1.0f; out->v[ 1] = 0.0f; out->v[ 2] = 0.0f; out->v[ 3] = 0.0f;
 	out->v[ 4] = 0.0f; out->v[ 5] = 1.0f; out->v[ 6] = 0.0f; out->v[ 7] = 0.0f;
 	out->v[ 8] = 0.0f; out->v[ 9] = 0.0f; out->v[10] = 1.0f; out->v[11] = 0.0f;
@@ -895,7 +1301,7 @@ mat4 *mat4_translation(mat4 *out, vec3 a){
 	return out;
 }
 
-mat4 *mat4_transpose(mat4 *out, mat4 *a){
+NVQM_API mat4 *mat4_transpose(mat4 *out, mat4 *a){
 	if (out == a){
 		float
 			a01 = a->v[1], a02 = a->v[2], a03 = a->v[ 3],
@@ -923,69 +1329,1544 @@ mat4 *mat4_transpose(mat4 *out, mat4 *a){
 	return out;
 }
 
-#endif /* NVQM_SKIP_FLOATING_POINT */
+/*
+ * mat4x3
+ */
+
+NVQM_API mat4x3 *mat4x3_copy(mat4x3 *out, mat4x3 *a){
+	out->v[ 0] = a->v[ 0]; out->v[ 1] = a->v[ 1]; out->v[ 2] = a->v[ 2];
+	out->v[ 3] = a->v[ 3]; out->v[ 4] = a->v[ 4]; out->v[ 5] = a->v[ 5];
+	out->v[ 6] = a->v[ 6]; out->v[ 7] = a->v[ 7]; out->v[ 8] = a->v[ 8];
+	out->v[ 9] = a->v[ 9]; out->v[10] = a->v[10]; out->v[11] = a->v[11];
+	return out;
+}
+
+NVQM_API mat4x3 *mat4x3_identity(mat4x3 *out){
+	out->v[ 0] = 1.0f; out->v[ 1] = 0.0f; out->v[ 2] = 0.0f;
+	out->v[ 3] = 0.0f; out->v[ 4] = 1.0f; out->v[ 5] = 0.0f;
+	out->v[ 6] = 0.0f; out->v[ 7] = 0.0f; out->v[ 8] = 1.0f;
+	out->v[ 9] = 0.0f; out->v[10] = 0.0f; out->v[11] = 0.0f;
+	return out;
+}
+
+NVQM_API mat4x3 *mat4x3_invert(mat4x3 *out, mat4x3 *a){
+	float
+		a00 = a->v[0], a01 = a->v[ 1], a02 = a->v[ 2],
+		a10 = a->v[3], a11 = a->v[ 4], a12 = a->v[ 5],
+		a20 = a->v[6], a21 = a->v[ 7], a22 = a->v[ 8],
+		a30 = a->v[9], a31 = a->v[10], a32 = a->v[11],
+		b01 =  a22 * a11 - a12 * a21,
+		b11 = -a22 * a10 + a12 * a20,
+		b21 =  a21 * a10 - a11 * a20;
+	float det = a00 * b01 + a01 * b11 + a02 * b21;
+	if (det == 0.0f)
+		return (mat4x3 *)0;
+	det = 1.0f / det;
+	float
+		c00 =   b01                    * det,
+		c01 = (-a22 * a01 + a02 * a21) * det,
+		c02 = ( a12 * a01 - a02 * a11) * det,
+		c10 =   b11                    * det,
+		c11 = ( a22 * a00 - a02 * a20) * det,
+		c12 = (-a12 * a00 + a02 * a10) * det,
+		c20 =   b21                    * det,
+		c21 = (-a21 * a00 + a01 * a20) * det,
+		c22 = ( a11 * a00 - a01 * a10) * det;
+	out->v[ 0] = c00;
+	out->v[ 1] = c01;
+	out->v[ 2] = c02;
+	out->v[ 3] = c10;
+	out->v[ 4] = c11;
+	out->v[ 5] = c12;
+	out->v[ 6] = c20;
+	out->v[ 7] = c21;
+	out->v[ 8] = c22;
+	out->v[ 9] = -(c00 * a30 + c10 * a31 + c20 * a32);
+	out->v[10] = -(c01 * a30 + c11 * a31 + c21 * a32);
+	out->v[11] = -(c02 * a30 + c12 * a31 + c22 * a32);
+	return out;
+}
+
+NVQM_API mat4x3 *mat4x3_mat4(mat4x3 *out, mat4 *a){
+	out->v[ 0] = a->v[ 0]; out->v[ 1] = a->v[ 1]; out->v[ 2] = a->v[ 2];
+	out->v[ 3] = a->v[ 4]; out->v[ 4] = a->v[ 5]; out->v[ 5] = a->v[ 6];
+	out->v[ 6] = a->v[ 8]; out->v[ 7] = a->v[ 9]; out->v[ 8] = a->v[10];
+	out->v[ 9] = a->v[12]; out->v[10] = a->v[13]; out->v[11] = a->v[14];
+	return out;
+}
+
+NVQM_API mat4 *mat4_mat4x3(mat4 *out, mat4x3 *a){
+	out->v[ 0] = a->v[0]; out->v[ 1] = a->v[ 1]; out->v[ 2] = a->v[ 2]; out->v[ 3] = 0.0f;
+	out->v[ 4] = a->v[3]; out->v[ 5] = a->v[ 4]; out->v[ 6] = a->v[ 5]; out->v[ 7] = 0.0f;
+	out->v[ 8] = a->v[6]; out->v[ 9] = a->v[ 7]; out->v[10] = a->v[ 8]; out->v[11] = 0.0f;
+	out->v[12] = a->v[9]; out->v[13] = a->v[10]; out->v[14] = a->v[11]; out->v[15] = 1.0f;
+	return out;
+}
+
+#ifdef NVQM_SSE2
+static inline __m128 mat4x3_mul_col(const float *b, __m128 a0, __m128 a1, __m128 a2){
+	return _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(_mm_set1_ps(b[0]), a0),
+		_mm_mul_ps(_mm_set1_ps(b[1]), a1)),
+		_mm_mul_ps(_mm_set1_ps(b[2]), a2));
+}
+#endif
+
+NVQM_API mat4x3 *mat4x3_mul(mat4x3 *out, mat4x3 *a, mat4x3 *b){
+	/* same order of operations as mat4_mul_affine, so the results match it bitwise */
+#ifdef NVQM_SSE2
+	/* columns are three floats apart, so the fourth lane of each load is ignored, and the last column
+	 * is loaded one float early to stay inside the matrix */
+	__m128
+		a0 = _mm_loadu_ps(&a->v[0]),
+		a1 = _mm_loadu_ps(&a->v[3]),
+		a2 = _mm_loadu_ps(&a->v[6]),
+		a3 = _mm_loadu_ps(&a->v[8]);
+	a3 = _mm_shuffle_ps(a3, a3, _MM_SHUFFLE(3, 3, 2, 1));
+	__m128
+		c0 = mat4x3_mul_col(&b->v[0], a0, a1, a2),
+		c1 = mat4x3_mul_col(&b->v[3], a0, a1, a2),
+		c2 = mat4x3_mul_col(&b->v[6], a0, a1, a2),
+		c3 = _mm_add_ps(mat4x3_mul_col(&b->v[9], a0, a1, a2), a3);
+	/* pack the four xyz results into three registers */
+	__m128
+		t0 = _mm_shuffle_ps(c0, c1, _MM_SHUFFLE(0, 0, 2, 2)), /* c0z c0z c1x c1x */
+		t1 = _mm_shuffle_ps(c1, c2, _MM_SHUFFLE(1, 0, 2, 1)), /* c1y c1z c2x c2y */
+		t2 = _mm_shuffle_ps(c2, c3, _MM_SHUFFLE(0, 0, 2, 2)); /* c2z c2z c3x c3x */
+	_mm_storeu_ps(&out->v[0], _mm_shuffle_ps(c0, t0, _MM_SHUFFLE(2, 0, 1, 0)));
+	_mm_storeu_ps(&out->v[4], t1);
+	_mm_storeu_ps(&out->v[8], _mm_shuffle_ps(t2, c3, _MM_SHUFFLE(2, 1, 2, 0)));
+	return out;
+#else
+	float
+		a00 = a->v[0], a01 = a->v[ 1], a02 = a->v[ 2],
+		a10 = a->v[3], a11 = a->v[ 4], a12 = a->v[ 5],
+		a20 = a->v[6], a21 = a->v[ 7], a22 = a->v[ 8],
+		a30 = a->v[9], a31 = a->v[10], a32 = a->v[11];
+	float b0, b1, b2;
+	b0 = b->v[ 0];
+	b1 = b->v[ 1];
+	b2 = b->v[ 2];
+	out->v[ 0] = b0 * a00 + b1 * a10 + b2 * a20;
+	out->v[ 1] = b0 * a01 + b1 * a11 + b2 * a21;
+	out->v[ 2] = b0 * a02 + b1 * a12 + b2 * a22;
+	b0 = b->v[ 3];
+	b1 = b->v[ 4];
+	b2 = b->v[ 5];
+	out->v[ 3] = b0 * a00 + b1 * a10 + b2 * a20;
+	out->v[ 4] = b0 * a01 + b1 * a11 + b2 * a21;
+	out->v[ 5] = b0 * a02 + b1 * a12 + b2 * a22;
+	b0 = b->v[ 6];
+	b1 = b->v[ 7];
+	b2 = b->v[ 8];
+	out->v[ 6] = b0 * a00 + b1 * a10 + b2 * a20;
+	out->v[ 7] = b0 * a01 + b1 * a11 + b2 * a21;
+	out->v[ 8] = b0 * a02 + b1 * a12 + b2 * a22;
+	b0 = b->v[ 9];
+	b1 = b->v[10];
+	b2 = b->v[11];
+	out->v[ 9] = b0 * a00 + b1 * a10 + b2 * a20 + a30;
+	out->v[10] = b0 * a01 + b1 * a11 + b2 * a21 + a31;
+	out->v[11] = b0 * a02 + b1 * a12 + b2 * a22 + a32;
+	return out;
+#endif
+}
+
+NVQM_API mat4x3 *mat4x3_rottrans(mat4x3 *out, quat a, vec3 b){
+	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
+		ax2 = ax + ax,
+		ay2 = ay + ay,
+		az2 = az + az,
+		axx = ax * ax2,
+		axy = ax * ay2,
+		axz = ax * az2,
+		ayy = ay * ay2,
+		ayz = ay * az2,
+		azz = az * az2,
+		awx = aw * ax2,
+		awy = aw * ay2,
+		awz = aw * az2;
+	out->v[ 0] = 1.0f - ayy - azz;
+	out->v[ 1] =        axy + awz;
+	out->v[ 2] =        axz - awy;
+	out->v[ 3] =        axy - awz;
+	out->v[ 4] = 1.0f - axx - azz;
+	out->v[ 5] =        ayz + awx;
+	out->v[ 6] =        axz + awy;
+	out->v[ 7] =        ayz - awx;
+	out->v[ 8] = 1.0f - axx - ayy;
+	out->v[ 9] = b.v[0];
+	out->v[10] = b.v[1];
+	out->v[11] = b.v[2];
+	return out;
+}
+
+/*
+ * arrays
+ */
+
+#ifdef NVQM_SSE2
+static inline __m128 sse_fnormal_scale(__m128 len){
+	/* num_frsqrt for each lane, or 1 where the length is below FLT_MIN, like the *_fnormal
+	 * functions */
+	__m128
+		half = _mm_set1_ps(0.5f),
+		y    = _mm_rsqrt_ps(len),
+		big  = _mm_cmpge_ps(len, _mm_set1_ps(FLT_MIN));
+	y = _mm_add_ps(y, _mm_mul_ps(y, _mm_sub_ps(half, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(half, len), y), y))));
+	return _mm_or_ps(_mm_and_ps(big, y), _mm_andnot_ps(big, _mm_set1_ps(1.0f)));
+}
+#endif
+
+NVQM_API vec3 *vec3_applymat4_array(vec3 *out, vec3 *a, mat4 *b, size_t n){
+	/* same operations in the same order as vec3_applymat4, so results are identical */
+	float
+		b00 = b->v[ 0], b01 = b->v[ 1], b02 = b->v[ 2], b03 = b->v[ 3],
+		b10 = b->v[ 4], b11 = b->v[ 5], b12 = b->v[ 6], b13 = b->v[ 7],
+		b20 = b->v[ 8], b21 = b->v[ 9], b22 = b->v[10], b23 = b->v[11],
+		b30 = b->v[12], b31 = b->v[13], b32 = b->v[14], b33 = b->v[15];
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128
+		c00 = _mm_set1_ps(b00), c01 = _mm_set1_ps(b01), c02 = _mm_set1_ps(b02), c03 = _mm_set1_ps(b03),
+		c10 = _mm_set1_ps(b10), c11 = _mm_set1_ps(b11), c12 = _mm_set1_ps(b12), c13 = _mm_set1_ps(b13),
+		c20 = _mm_set1_ps(b20), c21 = _mm_set1_ps(b21), c22 = _mm_set1_ps(b22), c23 = _mm_set1_ps(b23),
+		c30 = _mm_set1_ps(b30), c31 = _mm_set1_ps(b31), c32 = _mm_set1_ps(b32), c33 = _mm_set1_ps(b33),
+		zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax, ay, az, w, wz;
+		sse_load3x4(a[i].v, &ax, &ay, &az);
+		w = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c03, ax), _mm_mul_ps(c13, ay)), _mm_mul_ps(c23, az)), c33);
+		wz = _mm_cmpeq_ps(w, zero);
+		w = _mm_or_ps(_mm_and_ps(wz, one), _mm_andnot_ps(wz, _mm_div_ps(one, w)));
+		sse_store3x4(out[i].v,
+			_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(c00, ax), _mm_mul_ps(c10, ay)), _mm_mul_ps(c20, az)), c30), w),
+			_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(c01, ax), _mm_mul_ps(c11, ay)), _mm_mul_ps(c21, az)), c31), w),
+			_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(c02, ax), _mm_mul_ps(c12, ay)), _mm_mul_ps(c22, az)), c32), w));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = a[i].v[0], ay = a[i].v[1], az = a[i].v[2];
+		float w = b03 * ax + b13 * ay + b23 * az + b33;
+		if (w == 0.0f)
+			w = 1.0f;
+		else
+			w = 1.0f / w;
+		out[i].v[0] = (b00 * ax + b10 * ay + b20 * az + b30) * w;
+		out[i].v[1] = (b01 * ax + b11 * ay + b21 * az + b31) * w;
+		out[i].v[2] = (b02 * ax + b12 * ay + b22 * az + b32) * w;
+	}
+	return out;
+}
+
+NVQM_API vec3 *vec3_applymat4affine_array(vec3 *out, vec3 *a, mat4 *b, size_t n){
+	/* assumes the bottom row of `b` is [0, 0, 0, 1] */
+	float
+		b00 = b->v[ 0], b01 = b->v[ 1], b02 = b->v[ 2],
+		b10 = b->v[ 4], b11 = b->v[ 5], b12 = b->v[ 6],
+		b20 = b->v[ 8], b21 = b->v[ 9], b22 = b->v[10],
+		b30 = b->v[12], b31 = b->v[13], b32 = b->v[14];
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128
+		c00 = _mm_set1_ps(b00), c01 = _mm_set1_ps(b01), c02 = _mm_set1_ps(b02),
+		c10 = _mm_set1_ps(b10), c11 = _mm_set1_ps(b11), c12 = _mm_set1_ps(b12),
+		c20 = _mm_set1_ps(b20), c21 = _mm_set1_ps(b21), c22 = _mm_set1_ps(b22),
+		c30 = _mm_set1_ps(b30), c31 = _mm_set1_ps(b31), c32 = _mm_set1_ps(b32);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax, ay, az;
+		sse_load3x4(a[i].v, &ax, &ay, &az);
+		sse_store3x4(out[i].v,
+			_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(c00, ax), _mm_mul_ps(c10, ay)), _mm_mul_ps(c20, az)), c30),
+			_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(c01, ax), _mm_mul_ps(c11, ay)), _mm_mul_ps(c21, az)), c31),
+			_mm_add_ps(_mm_add_ps(_mm_add_ps(
+				_mm_mul_ps(c02, ax), _mm_mul_ps(c12, ay)), _mm_mul_ps(c22, az)), c32));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = a[i].v[0], ay = a[i].v[1], az = a[i].v[2];
+		out[i].v[0] = b00 * ax + b10 * ay + b20 * az + b30;
+		out[i].v[1] = b01 * ax + b11 * ay + b21 * az + b31;
+		out[i].v[2] = b02 * ax + b12 * ay + b22 * az + b32;
+	}
+	return out;
+}
+
+NVQM_API vec3 *vec3_fnormal_array(vec3 *out, vec3 *a, size_t n){
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax, ay, az;
+		sse_load3x4(a[i].v, &ax, &ay, &az);
+		__m128 len = sse_fnormal_scale(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)));
+		sse_store3x4(out[i].v, _mm_mul_ps(ax, len), _mm_mul_ps(ay, len), _mm_mul_ps(az, len));
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = vec3_fnormal(a[i]);
+	return out;
+}
+
+static void x_fnormal4(float *out, const float *a, size_t n){
+	/* rows of 4 floats, shared by vec4 and quat, with the same operations as vec4_fnormal */
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(&a[(i + 0) * 4]), ay = _mm_loadu_ps(&a[(i + 1) * 4]),
+			az = _mm_loadu_ps(&a[(i + 2) * 4]), aw = _mm_loadu_ps(&a[(i + 3) * 4]);
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		__m128 len = sse_fnormal_scale(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)), _mm_mul_ps(aw, aw)));
+		ax = _mm_mul_ps(ax, len);
+		ay = _mm_mul_ps(ay, len);
+		az = _mm_mul_ps(az, len);
+		aw = _mm_mul_ps(aw, len);
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		_mm_storeu_ps(&out[(i + 0) * 4], ax);
+		_mm_storeu_ps(&out[(i + 1) * 4], ay);
+		_mm_storeu_ps(&out[(i + 2) * 4], az);
+		_mm_storeu_ps(&out[(i + 3) * 4], aw);
+	}
+#endif
+	for (; i < n; i++){
+		float ax = a[i * 4 + 0], ay = a[i * 4 + 1], az = a[i * 4 + 2], aw = a[i * 4 + 3];
+		float len = ax * ax + ay * ay + az * az + aw * aw;
+		if (len >= FLT_MIN){
+			len = num_frsqrt(len);
+			ax *= len;
+			ay *= len;
+			az *= len;
+			aw *= len;
+		}
+		out[i * 4 + 0] = ax;
+		out[i * 4 + 1] = ay;
+		out[i * 4 + 2] = az;
+		out[i * 4 + 3] = aw;
+	}
+}
+
+NVQM_API vec4 *vec4_fnormal_array(vec4 *out, vec4 *a, size_t n){
+	x_fnormal4((float *)out, (const float *)a, n);
+	return out;
+}
+
+NVQM_API quat *quat_fnormal_array(quat *out, quat *a, size_t n){
+	x_fnormal4((float *)out, (const float *)a, n);
+	return out;
+}
+
+static quat *quat_nlerp_arr(quat *out, quat *a, quat *b, float *tv, float t, size_t n){
+	/* same operations in the same order as quat_nlerp, so results are identical */
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f), tt = _mm_set1_ps(t);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(a[i + 0].v), ay = _mm_loadu_ps(a[i + 1].v),
+			az = _mm_loadu_ps(a[i + 2].v), aw = _mm_loadu_ps(a[i + 3].v),
+			bx = _mm_loadu_ps(b[i + 0].v), by = _mm_loadu_ps(b[i + 1].v),
+			bz = _mm_loadu_ps(b[i + 2].v), bw = _mm_loadu_ps(b[i + 3].v);
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+		if (tv)
+			tt = _mm_loadu_ps(&tv[i]);
+		ax = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), tt));
+		ay = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), tt));
+		az = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), tt));
+		aw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), tt));
+		__m128 len = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)), _mm_mul_ps(aw, aw));
+		__m128 pos = _mm_cmpgt_ps(len, zero);
+		len = _mm_or_ps(_mm_and_ps(pos, _mm_div_ps(one, _mm_sqrt_ps(len))), _mm_andnot_ps(pos, one));
+		ax = _mm_mul_ps(ax, len);
+		ay = _mm_mul_ps(ay, len);
+		az = _mm_mul_ps(az, len);
+		aw = _mm_mul_ps(aw, len);
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		_mm_storeu_ps(out[i + 0].v, ax);
+		_mm_storeu_ps(out[i + 1].v, ay);
+		_mm_storeu_ps(out[i + 2].v, az);
+		_mm_storeu_ps(out[i + 3].v, aw);
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = quat_nlerp(a[i], b[i], tv ? tv[i] : t);
+	return out;
+}
+
+NVQM_API quat *quat_nlerp_array(quat *out, quat *a, quat *b, float t, size_t n){
+	return quat_nlerp_arr(out, a, b, (float *)0, t, n);
+}
+
+NVQM_API quat *quat_nlerpv_array(quat *out, quat *a, quat *b, float *t, size_t n){
+	return quat_nlerp_arr(out, a, b, t, 0.0f, n);
+}
+
+/* polynomial slerp from "A Fast and Accurate Algorithm for Computing SLERP" by David Eberly
+ * sin(t * ang) / sin(ang) is a series in (cos(ang) - 1), where each term is the previous term times
+ * (u[i] * t^2 - v[i]) * (cos(ang) - 1), and the last term is scaled by 1.91 to make up for the ones
+ * that are cut off
+ * with 16 terms the truncation error is below float rounding, and the maximum error is about 2e-7
+ * per component for unit quaternions (see chk_slerp in test.c), which is no worse than quat_slerp
+ */
+#define SLERP_MU 1.91f
+static const float slerp_u[16] = {
+	1.0f / ( 1.0f *  3.0f), 1.0f / ( 2.0f *  5.0f), 1.0f / ( 3.0f *  7.0f), 1.0f / ( 4.0f *  9.0f),
+	1.0f / ( 5.0f * 11.0f), 1.0f / ( 6.0f * 13.0f), 1.0f / ( 7.0f * 15.0f), 1.0f / ( 8.0f * 17.0f),
+	1.0f / ( 9.0f * 19.0f), 1.0f / (10.0f * 21.0f), 1.0f / (11.0f * 23.0f), 1.0f / (12.0f * 25.0f),
+	1.0f / (13.0f * 27.0f), 1.0f / (14.0f * 29.0f), 1.0f / (15.0f * 31.0f), SLERP_MU / (16.0f * 33.0f)
+};
+static const float slerp_v[16] = {
+	 1.0f /  3.0f,  2.0f /  5.0f,  3.0f /  7.0f,  4.0f /  9.0f,
+	 5.0f / 11.0f,  6.0f / 13.0f,  7.0f / 15.0f,  8.0f / 17.0f,
+	 9.0f / 19.0f, 10.0f / 21.0f, 11.0f / 23.0f, 12.0f / 25.0f,
+	13.0f / 27.0f, 14.0f / 29.0f, 15.0f / 31.0f, SLERP_MU * 16.0f / 33.0f
+};
+#undef SLERP_MU
+
+static inline quat quat_slerp_poly(quat a, quat b, float t){
+	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3];
+	float bx = b.v[0], by = b.v[1], bz = b.v[2], bw = b.v[3];
+	float x = ax * bx + ay * by + az * bz + aw * bw;
+	int neg = x < 0.0f;
+	if (neg)
+		x = -x;
+	float xm1 = x - 1.0f, d = 1.0f - t, t2 = t * t, d2 = d * d;
+	float ct = 1.0f, cd = 1.0f;
+	for (int i = 15; i >= 0; i--){
+		ct = 1.0f + (slerp_u[i] * t2 - slerp_v[i]) * xm1 * ct;
+		cd = 1.0f + (slerp_u[i] * d2 - slerp_v[i]) * xm1 * cd;
+	}
+	ct *= t;
+	cd *= d;
+	if (neg)
+		ct = -ct;
+	return quat_new(
+		cd * ax + ct * bx,
+		cd * ay + ct * by,
+		cd * az + ct * bz,
+		cd * aw + ct * bw
+	);
+}
+
+static quat *quat_slerp_arr(quat *out, quat *a, quat *b, float *tv, float t, size_t n){
+	/* the SSE2 loop does the same operations in the same order as quat_slerp_poly, so the results
+	 * don't depend on where an element falls in the array */
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128
+		zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f),
+		sign = _mm_set1_ps(-0.0f), tt = _mm_set1_ps(t);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(a[i + 0].v), ay = _mm_loadu_ps(a[i + 1].v),
+			az = _mm_loadu_ps(a[i + 2].v), aw = _mm_loadu_ps(a[i + 3].v),
+			bx = _mm_loadu_ps(b[i + 0].v), by = _mm_loadu_ps(b[i + 1].v),
+			bz = _mm_loadu_ps(b[i + 2].v), bw = _mm_loadu_ps(b[i + 3].v);
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		_MM_TRANSPOSE4_PS(bx, by, bz, bw);
+		if (tv)
+			tt = _mm_loadu_ps(&tv[i]);
+		__m128 x = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)), _mm_mul_ps(aw, bw));
+		__m128 neg = _mm_and_ps(_mm_cmplt_ps(x, zero), sign);
+		x = _mm_xor_ps(x, neg);
+		__m128
+			xm1 = _mm_sub_ps(x, one),
+			d   = _mm_sub_ps(one, tt),
+			t2  = _mm_mul_ps(tt, tt),
+			d2  = _mm_mul_ps(d, d),
+			ct  = one,
+			cd  = one;
+		for (int j = 15; j >= 0; j--){
+			__m128 u = _mm_set1_ps(slerp_u[j]), v = _mm_set1_ps(slerp_v[j]);
+			ct = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, t2), v), xm1), ct));
+			cd = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(u, d2), v), xm1), cd));
+		}
+		ct = _mm_xor_ps(_mm_mul_ps(ct, tt), neg);
+		cd = _mm_mul_ps(cd, d);
+		ax = _mm_add_ps(_mm_mul_ps(cd, ax), _mm_mul_ps(ct, bx));
+		ay = _mm_add_ps(_mm_mul_ps(cd, ay), _mm_mul_ps(ct, by));
+		az = _mm_add_ps(_mm_mul_ps(cd, az), _mm_mul_ps(ct, bz));
+		aw = _mm_add_ps(_mm_mul_ps(cd, aw), _mm_mul_ps(ct, bw));
+		_MM_TRANSPOSE4_PS(ax, ay, az, aw);
+		_mm_storeu_ps(out[i + 0].v, ax);
+		_mm_storeu_ps(out[i + 1].v, ay);
+		_mm_storeu_ps(out[i + 2].v, az);
+		_mm_storeu_ps(out[i + 3].v, aw);
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = quat_slerp_poly(a[i], b[i], tv ? tv[i] : t);
+	return out;
+}
+
+NVQM_API quat *quat_slerp_array(quat *out, quat *a, quat *b, float t, size_t n){
+	return quat_slerp_arr(out, a, b, (float *)0, t, n);
+}
+
+NVQM_API quat *quat_slerpv_array(quat *out, quat *a, quat *b, float *t, size_t n){
+	return quat_slerp_arr(out, a, b, t, 0.0f, n);
+}
+
+/*
+ * structure of arrays
+ * the SSE2 loops load all inputs of 4 elements before storing, so `out` can be the same as an input
+ * results are identical to the matching AoS function
+ */
+
+NVQM_API vec3soa *vec3soa_fromvec3(vec3soa *out, vec3 *a, size_t n){
+	float *ox = out->x, *oy = out->y, *oz = out->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax, ay, az;
+		sse_load3x4(a[i].v, &ax, &ay, &az);
+		_mm_storeu_ps(&ox[i], ax);
+		_mm_storeu_ps(&oy[i], ay);
+		_mm_storeu_ps(&oz[i], az);
+	}
+#endif
+	for (; i < n; i++){
+		ox[i] = a[i].v[0];
+		oy[i] = a[i].v[1];
+		oz[i] = a[i].v[2];
+	}
+	return out;
+}
+
+NVQM_API vec3 *vec3soa_tovec3(vec3 *out, vec3soa *a, size_t n){
+	float *ax = a->x, *ay = a->y, *az = a->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4)
+		sse_store3x4(out[i].v, _mm_loadu_ps(&ax[i]), _mm_loadu_ps(&ay[i]), _mm_loadu_ps(&az[i]));
+#endif
+	for (; i < n; i++){
+		out[i].v[0] = ax[i];
+		out[i].v[1] = ay[i];
+		out[i].v[2] = az[i];
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_add(vec3soa *out, vec3soa *a, vec3soa *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*ax = a->x, *ay = a->y, *az = a->z,
+		*bx = b->x, *by = b->y, *bz = b->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			rx = _mm_add_ps(_mm_loadu_ps(&ax[i]), _mm_loadu_ps(&bx[i])),
+			ry = _mm_add_ps(_mm_loadu_ps(&ay[i]), _mm_loadu_ps(&by[i])),
+			rz = _mm_add_ps(_mm_loadu_ps(&az[i]), _mm_loadu_ps(&bz[i]));
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+	}
+#endif
+	for (; i < n; i++){
+		float rx = ax[i] + bx[i], ry = ay[i] + by[i], rz = az[i] + bz[i];
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_applymat4(vec3soa *out, vec3soa *a, mat4 *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*px = a->x, *py = a->y, *pz = a->z;
+	float
+		b00 = b->v[ 0], b01 = b->v[ 1], b02 = b->v[ 2], b03 = b->v[ 3],
+		b10 = b->v[ 4], b11 = b->v[ 5], b12 = b->v[ 6], b13 = b->v[ 7],
+		b20 = b->v[ 8], b21 = b->v[ 9], b22 = b->v[10], b23 = b->v[11],
+		b30 = b->v[12], b31 = b->v[13], b32 = b->v[14], b33 = b->v[15];
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128
+		c00 = _mm_set1_ps(b00), c01 = _mm_set1_ps(b01), c02 = _mm_set1_ps(b02), c03 = _mm_set1_ps(b03),
+		c10 = _mm_set1_ps(b10), c11 = _mm_set1_ps(b11), c12 = _mm_set1_ps(b12), c13 = _mm_set1_ps(b13),
+		c20 = _mm_set1_ps(b20), c21 = _mm_set1_ps(b21), c22 = _mm_set1_ps(b22), c23 = _mm_set1_ps(b23),
+		c30 = _mm_set1_ps(b30), c31 = _mm_set1_ps(b31), c32 = _mm_set1_ps(b32), c33 = _mm_set1_ps(b33),
+		zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]), az = _mm_loadu_ps(&pz[i]);
+		__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c03, ax), _mm_mul_ps(c13, ay)), _mm_mul_ps(c23, az)), c33);
+		__m128 wz = _mm_cmpeq_ps(w, zero);
+		w = _mm_or_ps(_mm_and_ps(wz, one), _mm_andnot_ps(wz, _mm_div_ps(one, w)));
+		_mm_storeu_ps(&ox[i], _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c00, ax), _mm_mul_ps(c10, ay)), _mm_mul_ps(c20, az)), c30), w));
+		_mm_storeu_ps(&oy[i], _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c01, ax), _mm_mul_ps(c11, ay)), _mm_mul_ps(c21, az)), c31), w));
+		_mm_storeu_ps(&oz[i], _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c02, ax), _mm_mul_ps(c12, ay)), _mm_mul_ps(c22, az)), c32), w));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = px[i], ay = py[i], az = pz[i];
+		float w = b03 * ax + b13 * ay + b23 * az + b33;
+		if (w == 0.0f)
+			w = 1.0f;
+		else
+			w = 1.0f / w;
+		ox[i] = (b00 * ax + b10 * ay + b20 * az + b30) * w;
+		oy[i] = (b01 * ax + b11 * ay + b21 * az + b31) * w;
+		oz[i] = (b02 * ax + b12 * ay + b22 * az + b32) * w;
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_applyquat(vec3soa *out, vec3soa *a, quat b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*px = a->x, *py = a->y, *pz = a->z;
+	float bx = b.v[0], by = b.v[1], bz = b.v[2], bw = b.v[3];
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128
+		qx = _mm_set1_ps(bx), qy = _mm_set1_ps(by), qz = _mm_set1_ps(bz), qw = _mm_set1_ps(bw),
+		nx = _mm_set1_ps(-bx), ny = _mm_set1_ps(-by), nz = _mm_set1_ps(-bz);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]), az = _mm_loadu_ps(&pz[i]);
+		__m128
+			ix = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(qw, ax), _mm_mul_ps(qy, az)), _mm_mul_ps(qz, ay)),
+			iy = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(qw, ay), _mm_mul_ps(qz, ax)), _mm_mul_ps(qx, az)),
+			iz = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(qw, az), _mm_mul_ps(qx, ay)), _mm_mul_ps(qy, ax)),
+			iw = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(nx, ax), _mm_mul_ps(qy, ay)), _mm_mul_ps(qz, az));
+		_mm_storeu_ps(&ox[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ix, qw), _mm_mul_ps(iw, nx)), _mm_mul_ps(iy, nz)), _mm_mul_ps(iz, ny)));
+		_mm_storeu_ps(&oy[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(iy, qw), _mm_mul_ps(iw, ny)), _mm_mul_ps(iz, nx)), _mm_mul_ps(ix, nz)));
+		_mm_storeu_ps(&oz[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(iz, qw), _mm_mul_ps(iw, nz)), _mm_mul_ps(ix, ny)), _mm_mul_ps(iy, nx)));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = px[i], ay = py[i], az = pz[i];
+		float
+			ix =  bw * ax + by * az - bz * ay,
+			iy =  bw * ay + bz * ax - bx * az,
+			iz =  bw * az + bx * ay - by * ax,
+			iw = -bx * ax - by * ay - bz * az;
+		ox[i] = ix * bw + iw * -bx + iy * -bz - iz * -by;
+		oy[i] = iy * bw + iw * -by + iz * -bx - ix * -bz;
+		oz[i] = iz * bw + iw * -bz + ix * -by - iy * -bx;
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_cross(vec3soa *out, vec3soa *a, vec3soa *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*pax = a->x, *pay = a->y, *paz = a->z,
+		*pbx = b->x, *pby = b->y, *pbz = b->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(&pax[i]), ay = _mm_loadu_ps(&pay[i]), az = _mm_loadu_ps(&paz[i]),
+			bx = _mm_loadu_ps(&pbx[i]), by = _mm_loadu_ps(&pby[i]), bz = _mm_loadu_ps(&pbz[i]);
+		_mm_storeu_ps(&ox[i], _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+		_mm_storeu_ps(&oy[i], _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+		_mm_storeu_ps(&oz[i], _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+	}
+#endif
+	for (; i < n; i++){
+		float
+			ax = pax[i], ay = pay[i], az = paz[i],
+			bx = pbx[i], by = pby[i], bz = pbz[i];
+		ox[i] = ay * bz - az * by;
+		oy[i] = az * bx - ax * bz;
+		oz[i] = ax * by - ay * bx;
+	}
+	return out;
+}
+
+NVQM_API float *vec3soa_dot(float *out, vec3soa *a, vec3soa *b, size_t n){
+	float
+		*ax = a->x, *ay = a->y, *az = a->z,
+		*bx = b->x, *by = b->y, *bz = b->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		_mm_storeu_ps(&out[i], _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(&ax[i]), _mm_loadu_ps(&bx[i])),
+			_mm_mul_ps(_mm_loadu_ps(&ay[i]), _mm_loadu_ps(&by[i]))),
+			_mm_mul_ps(_mm_loadu_ps(&az[i]), _mm_loadu_ps(&bz[i]))));
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_fnormal(vec3soa *out, vec3soa *a, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*px = a->x, *py = a->y, *pz = a->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]), az = _mm_loadu_ps(&pz[i]);
+		__m128 len = sse_fnormal_scale(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)));
+		_mm_storeu_ps(&ox[i], _mm_mul_ps(ax, len));
+		_mm_storeu_ps(&oy[i], _mm_mul_ps(ay, len));
+		_mm_storeu_ps(&oz[i], _mm_mul_ps(az, len));
+	}
+#endif
+	for (; i < n; i++){
+		vec3 r = vec3_fnormal(vec3_new(px[i], py[i], pz[i]));
+		ox[i] = r.v[0];
+		oy[i] = r.v[1];
+		oz[i] = r.v[2];
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_lerp(vec3soa *out, vec3soa *a, vec3soa *b, float t, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*ax = a->x, *ay = a->y, *az = a->z,
+		*bx = b->x, *by = b->y, *bz = b->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 tt = _mm_set1_ps(t);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 px = _mm_loadu_ps(&ax[i]), py = _mm_loadu_ps(&ay[i]), pz = _mm_loadu_ps(&az[i]);
+		__m128
+			rx = _mm_add_ps(px, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&bx[i]), px), tt)),
+			ry = _mm_add_ps(py, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&by[i]), py), tt)),
+			rz = _mm_add_ps(pz, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&bz[i]), pz), tt));
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+	}
+#endif
+	for (; i < n; i++){
+		float
+			rx = num_lerp(ax[i], bx[i], t),
+			ry = num_lerp(ay[i], by[i], t),
+			rz = num_lerp(az[i], bz[i], t);
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_normal(vec3soa *out, vec3soa *a, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*px = a->x, *py = a->y, *pz = a->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128 ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]), az = _mm_loadu_ps(&pz[i]);
+		__m128 len = _mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az));
+		/* zero length vectors are scaled by 1, which leaves them untouched like vec3_normal */
+		__m128 pos = _mm_cmpgt_ps(len, zero);
+		len = _mm_or_ps(_mm_and_ps(pos, _mm_div_ps(one, _mm_sqrt_ps(len))), _mm_andnot_ps(pos, one));
+		_mm_storeu_ps(&ox[i], _mm_mul_ps(ax, len));
+		_mm_storeu_ps(&oy[i], _mm_mul_ps(ay, len));
+		_mm_storeu_ps(&oz[i], _mm_mul_ps(az, len));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = px[i], ay = py[i], az = pz[i];
+		float len = ax * ax + ay * ay + az * az;
+		if (len > 0.0f){
+			len = 1.0f / num_sqrt(len);
+			ox[i] = ax * len;
+			oy[i] = ay * len;
+			oz[i] = az * len;
+		}
+		else{
+			ox[i] = ax;
+			oy[i] = ay;
+			oz[i] = az;
+		}
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_scale(vec3soa *out, vec3soa *a, float s, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*ax = a->x, *ay = a->y, *az = a->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 ss = _mm_set1_ps(s);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			rx = _mm_mul_ps(_mm_loadu_ps(&ax[i]), ss),
+			ry = _mm_mul_ps(_mm_loadu_ps(&ay[i]), ss),
+			rz = _mm_mul_ps(_mm_loadu_ps(&az[i]), ss);
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+	}
+#endif
+	for (; i < n; i++){
+		float rx = ax[i] * s, ry = ay[i] * s, rz = az[i] * s;
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+	}
+	return out;
+}
+
+NVQM_API vec3soa *vec3soa_sub(vec3soa *out, vec3soa *a, vec3soa *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z,
+		*ax = a->x, *ay = a->y, *az = a->z,
+		*bx = b->x, *by = b->y, *bz = b->z;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			rx = _mm_sub_ps(_mm_loadu_ps(&ax[i]), _mm_loadu_ps(&bx[i])),
+			ry = _mm_sub_ps(_mm_loadu_ps(&ay[i]), _mm_loadu_ps(&by[i])),
+			rz = _mm_sub_ps(_mm_loadu_ps(&az[i]), _mm_loadu_ps(&bz[i]));
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+	}
+#endif
+	for (; i < n; i++){
+		float rx = ax[i] - bx[i], ry = ay[i] - by[i], rz = az[i] - bz[i];
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+	}
+	return out;
+}
+
+/* vec4 and quat are both 4 floats, so the conversions work on rows of 4 floats, and each type gets
+ * its own wrapper instead of casting between the struct types */
+
+static void x_soa_from4(float *ox, float *oy, float *oz, float *ow, const float *a, size_t n){
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			p0 = _mm_loadu_ps(&a[(i + 0) * 4]),
+			p1 = _mm_loadu_ps(&a[(i + 1) * 4]),
+			p2 = _mm_loadu_ps(&a[(i + 2) * 4]),
+			p3 = _mm_loadu_ps(&a[(i + 3) * 4]);
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		_mm_storeu_ps(&ox[i], p0);
+		_mm_storeu_ps(&oy[i], p1);
+		_mm_storeu_ps(&oz[i], p2);
+		_mm_storeu_ps(&ow[i], p3);
+	}
+#endif
+	for (; i < n; i++){
+		ox[i] = a[i * 4 + 0];
+		oy[i] = a[i * 4 + 1];
+		oz[i] = a[i * 4 + 2];
+		ow[i] = a[i * 4 + 3];
+	}
+}
+
+static void x_soa_to4(float *out, const float *ax, const float *ay, const float *az,
+	const float *aw, size_t n){
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			p0 = _mm_loadu_ps(&ax[i]),
+			p1 = _mm_loadu_ps(&ay[i]),
+			p2 = _mm_loadu_ps(&az[i]),
+			p3 = _mm_loadu_ps(&aw[i]);
+		_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+		_mm_storeu_ps(&out[(i + 0) * 4], p0);
+		_mm_storeu_ps(&out[(i + 1) * 4], p1);
+		_mm_storeu_ps(&out[(i + 2) * 4], p2);
+		_mm_storeu_ps(&out[(i + 3) * 4], p3);
+	}
+#endif
+	for (; i < n; i++){
+		out[i * 4 + 0] = ax[i];
+		out[i * 4 + 1] = ay[i];
+		out[i * 4 + 2] = az[i];
+		out[i * 4 + 3] = aw[i];
+	}
+}
+
+NVQM_API vec4soa *vec4soa_fromvec4(vec4soa *out, vec4 *a, size_t n){
+	/* a pointer to a struct also points to its first member, the array of floats */
+	x_soa_from4(out->x, out->y, out->z, out->w, (const float *)a, n);
+	return out;
+}
+
+NVQM_API vec4 *vec4soa_tovec4(vec4 *out, vec4soa *a, size_t n){
+	x_soa_to4((float *)out, a->x, a->y, a->z, a->w, n);
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_add(vec4soa *out, vec4soa *a, vec4soa *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*ax = a->x, *ay = a->y, *az = a->z, *aw = a->w,
+		*bx = b->x, *by = b->y, *bz = b->z, *bw = b->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			rx = _mm_add_ps(_mm_loadu_ps(&ax[i]), _mm_loadu_ps(&bx[i])),
+			ry = _mm_add_ps(_mm_loadu_ps(&ay[i]), _mm_loadu_ps(&by[i])),
+			rz = _mm_add_ps(_mm_loadu_ps(&az[i]), _mm_loadu_ps(&bz[i])),
+			rw = _mm_add_ps(_mm_loadu_ps(&aw[i]), _mm_loadu_ps(&bw[i]));
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+		_mm_storeu_ps(&ow[i], rw);
+	}
+#endif
+	for (; i < n; i++){
+		float rx = ax[i] + bx[i], ry = ay[i] + by[i], rz = az[i] + bz[i], rw = aw[i] + bw[i];
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+		ow[i] = rw;
+	}
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_applymat4(vec4soa *out, vec4soa *a, mat4 *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*px = a->x, *py = a->y, *pz = a->z, *pw = a->w;
+	float
+		b00 = b->v[ 0], b01 = b->v[ 1], b02 = b->v[ 2], b03 = b->v[ 3],
+		b10 = b->v[ 4], b11 = b->v[ 5], b12 = b->v[ 6], b13 = b->v[ 7],
+		b20 = b->v[ 8], b21 = b->v[ 9], b22 = b->v[10], b23 = b->v[11],
+		b30 = b->v[12], b31 = b->v[13], b32 = b->v[14], b33 = b->v[15];
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128
+		c00 = _mm_set1_ps(b00), c01 = _mm_set1_ps(b01), c02 = _mm_set1_ps(b02), c03 = _mm_set1_ps(b03),
+		c10 = _mm_set1_ps(b10), c11 = _mm_set1_ps(b11), c12 = _mm_set1_ps(b12), c13 = _mm_set1_ps(b13),
+		c20 = _mm_set1_ps(b20), c21 = _mm_set1_ps(b21), c22 = _mm_set1_ps(b22), c23 = _mm_set1_ps(b23),
+		c30 = _mm_set1_ps(b30), c31 = _mm_set1_ps(b31), c32 = _mm_set1_ps(b32), c33 = _mm_set1_ps(b33);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]),
+			az = _mm_loadu_ps(&pz[i]), aw = _mm_loadu_ps(&pw[i]);
+		_mm_storeu_ps(&ox[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c00, ax), _mm_mul_ps(c10, ay)), _mm_mul_ps(c20, az)), _mm_mul_ps(c30, aw)));
+		_mm_storeu_ps(&oy[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c01, ax), _mm_mul_ps(c11, ay)), _mm_mul_ps(c21, az)), _mm_mul_ps(c31, aw)));
+		_mm_storeu_ps(&oz[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c02, ax), _mm_mul_ps(c12, ay)), _mm_mul_ps(c22, az)), _mm_mul_ps(c32, aw)));
+		_mm_storeu_ps(&ow[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(c03, ax), _mm_mul_ps(c13, ay)), _mm_mul_ps(c23, az)), _mm_mul_ps(c33, aw)));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = px[i], ay = py[i], az = pz[i], aw = pw[i];
+		ox[i] = b00 * ax + b10 * ay + b20 * az + b30 * aw;
+		oy[i] = b01 * ax + b11 * ay + b21 * az + b31 * aw;
+		oz[i] = b02 * ax + b12 * ay + b22 * az + b32 * aw;
+		ow[i] = b03 * ax + b13 * ay + b23 * az + b33 * aw;
+	}
+	return out;
+}
+
+NVQM_API float *vec4soa_dot(float *out, vec4soa *a, vec4soa *b, size_t n){
+	float
+		*ax = a->x, *ay = a->y, *az = a->z, *aw = a->w,
+		*bx = b->x, *by = b->y, *bz = b->z, *bw = b->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		_mm_storeu_ps(&out[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(_mm_loadu_ps(&ax[i]), _mm_loadu_ps(&bx[i])),
+			_mm_mul_ps(_mm_loadu_ps(&ay[i]), _mm_loadu_ps(&by[i]))),
+			_mm_mul_ps(_mm_loadu_ps(&az[i]), _mm_loadu_ps(&bz[i]))),
+			_mm_mul_ps(_mm_loadu_ps(&aw[i]), _mm_loadu_ps(&bw[i]))));
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i] + aw[i] * bw[i];
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_fnormal(vec4soa *out, vec4soa *a, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*px = a->x, *py = a->y, *pz = a->z, *pw = a->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]),
+			az = _mm_loadu_ps(&pz[i]), aw = _mm_loadu_ps(&pw[i]);
+		__m128 len = sse_fnormal_scale(_mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)), _mm_mul_ps(aw, aw)));
+		_mm_storeu_ps(&ox[i], _mm_mul_ps(ax, len));
+		_mm_storeu_ps(&oy[i], _mm_mul_ps(ay, len));
+		_mm_storeu_ps(&oz[i], _mm_mul_ps(az, len));
+		_mm_storeu_ps(&ow[i], _mm_mul_ps(aw, len));
+	}
+#endif
+	for (; i < n; i++){
+		vec4 r = vec4_fnormal(vec4_new(px[i], py[i], pz[i], pw[i]));
+		ox[i] = r.v[0];
+		oy[i] = r.v[1];
+		oz[i] = r.v[2];
+		ow[i] = r.v[3];
+	}
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_lerp(vec4soa *out, vec4soa *a, vec4soa *b, float t, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*ax = a->x, *ay = a->y, *az = a->z, *aw = a->w,
+		*bx = b->x, *by = b->y, *bz = b->z, *bw = b->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 tt = _mm_set1_ps(t);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			px = _mm_loadu_ps(&ax[i]), py = _mm_loadu_ps(&ay[i]),
+			pz = _mm_loadu_ps(&az[i]), pw = _mm_loadu_ps(&aw[i]);
+		__m128
+			rx = _mm_add_ps(px, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&bx[i]), px), tt)),
+			ry = _mm_add_ps(py, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&by[i]), py), tt)),
+			rz = _mm_add_ps(pz, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&bz[i]), pz), tt)),
+			rw = _mm_add_ps(pw, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&bw[i]), pw), tt));
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+		_mm_storeu_ps(&ow[i], rw);
+	}
+#endif
+	for (; i < n; i++){
+		float
+			rx = num_lerp(ax[i], bx[i], t),
+			ry = num_lerp(ay[i], by[i], t),
+			rz = num_lerp(az[i], bz[i], t),
+			rw = num_lerp(aw[i], bw[i], t);
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+		ow[i] = rw;
+	}
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_normal(vec4soa *out, vec4soa *a, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*px = a->x, *py = a->y, *pz = a->z, *pw = a->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 zero = _mm_setzero_ps(), one = _mm_set1_ps(1.0f);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(&px[i]), ay = _mm_loadu_ps(&py[i]),
+			az = _mm_loadu_ps(&pz[i]), aw = _mm_loadu_ps(&pw[i]);
+		__m128 len = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, ax), _mm_mul_ps(ay, ay)), _mm_mul_ps(az, az)), _mm_mul_ps(aw, aw));
+		__m128 pos = _mm_cmpgt_ps(len, zero);
+		len = _mm_or_ps(_mm_and_ps(pos, _mm_div_ps(one, _mm_sqrt_ps(len))), _mm_andnot_ps(pos, one));
+		_mm_storeu_ps(&ox[i], _mm_mul_ps(ax, len));
+		_mm_storeu_ps(&oy[i], _mm_mul_ps(ay, len));
+		_mm_storeu_ps(&oz[i], _mm_mul_ps(az, len));
+		_mm_storeu_ps(&ow[i], _mm_mul_ps(aw, len));
+	}
+#endif
+	for (; i < n; i++){
+		float ax = px[i], ay = py[i], az = pz[i], aw = pw[i];
+		float len = ax * ax + ay * ay + az * az + aw * aw;
+		if (len > 0.0f){
+			len = 1.0f / num_sqrt(len);
+			ox[i] = ax * len;
+			oy[i] = ay * len;
+			oz[i] = az * len;
+			ow[i] = aw * len;
+		}
+		else{
+			ox[i] = ax;
+			oy[i] = ay;
+			oz[i] = az;
+			ow[i] = aw;
+		}
+	}
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_scale(vec4soa *out, vec4soa *a, float s, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*ax = a->x, *ay = a->y, *az = a->z, *aw = a->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	__m128 ss = _mm_set1_ps(s);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			rx = _mm_mul_ps(_mm_loadu_ps(&ax[i]), ss),
+			ry = _mm_mul_ps(_mm_loadu_ps(&ay[i]), ss),
+			rz = _mm_mul_ps(_mm_loadu_ps(&az[i]), ss),
+			rw = _mm_mul_ps(_mm_loadu_ps(&aw[i]), ss);
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+		_mm_storeu_ps(&ow[i], rw);
+	}
+#endif
+	for (; i < n; i++){
+		float rx = ax[i] * s, ry = ay[i] * s, rz = az[i] * s, rw = aw[i] * s;
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+		ow[i] = rw;
+	}
+	return out;
+}
+
+NVQM_API vec4soa *vec4soa_sub(vec4soa *out, vec4soa *a, vec4soa *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*ax = a->x, *ay = a->y, *az = a->z, *aw = a->w,
+		*bx = b->x, *by = b->y, *bz = b->z, *bw = b->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			rx = _mm_sub_ps(_mm_loadu_ps(&ax[i]), _mm_loadu_ps(&bx[i])),
+			ry = _mm_sub_ps(_mm_loadu_ps(&ay[i]), _mm_loadu_ps(&by[i])),
+			rz = _mm_sub_ps(_mm_loadu_ps(&az[i]), _mm_loadu_ps(&bz[i])),
+			rw = _mm_sub_ps(_mm_loadu_ps(&aw[i]), _mm_loadu_ps(&bw[i]));
+		_mm_storeu_ps(&ox[i], rx);
+		_mm_storeu_ps(&oy[i], ry);
+		_mm_storeu_ps(&oz[i], rz);
+		_mm_storeu_ps(&ow[i], rw);
+	}
+#endif
+	for (; i < n; i++){
+		float rx = ax[i] - bx[i], ry = ay[i] - by[i], rz = az[i] - bz[i], rw = aw[i] - bw[i];
+		ox[i] = rx;
+		oy[i] = ry;
+		oz[i] = rz;
+		ow[i] = rw;
+	}
+	return out;
+}
+
+/* quatsoa has the same lanes as vec4soa, so most quat functions call the vec4 versions on a vec4soa
+ * made from the same pointers */
+
+static inline vec4soa x_quatsoa_vec4(quatsoa *a){
+	vec4soa r = { a->x, a->y, a->z, a->w };
+	return r;
+}
+
+NVQM_API quatsoa *quatsoa_fromquat(quatsoa *out, quat *a, size_t n){
+	x_soa_from4(out->x, out->y, out->z, out->w, (const float *)a, n);
+	return out;
+}
+
+NVQM_API quat *quatsoa_toquat(quat *out, quatsoa *a, size_t n){
+	x_soa_to4((float *)out, a->x, a->y, a->z, a->w, n);
+	return out;
+}
+
+NVQM_API float *quatsoa_dot(float *out, quatsoa *a, quatsoa *b, size_t n){
+	vec4soa va = x_quatsoa_vec4(a), vb = x_quatsoa_vec4(b);
+	return vec4soa_dot(out, &va, &vb, n);
+}
+
+NVQM_API quatsoa *quatsoa_fnormal(quatsoa *out, quatsoa *a, size_t n){
+	vec4soa vo = x_quatsoa_vec4(out), va = x_quatsoa_vec4(a);
+	vec4soa_fnormal(&vo, &va, n);
+	return out;
+}
+
+NVQM_API quatsoa *quatsoa_lerp(quatsoa *out, quatsoa *a, quatsoa *b, float t, size_t n){
+	vec4soa vo = x_quatsoa_vec4(out), va = x_quatsoa_vec4(a), vb = x_quatsoa_vec4(b);
+	vec4soa_lerp(&vo, &va, &vb, t, n);
+	return out;
+}
+
+NVQM_API quatsoa *quatsoa_mul(quatsoa *out, quatsoa *a, quatsoa *b, size_t n){
+	float
+		*ox = out->x, *oy = out->y, *oz = out->z, *ow = out->w,
+		*pax = a->x, *pay = a->y, *paz = a->z, *paw = a->w,
+		*pbx = b->x, *pby = b->y, *pbz = b->z, *pbw = b->w;
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128
+			ax = _mm_loadu_ps(&pax[i]), ay = _mm_loadu_ps(&pay[i]),
+			az = _mm_loadu_ps(&paz[i]), aw = _mm_loadu_ps(&paw[i]),
+			bx = _mm_loadu_ps(&pbx[i]), by = _mm_loadu_ps(&pby[i]),
+			bz = _mm_loadu_ps(&pbz[i]), bw = _mm_loadu_ps(&pbw[i]);
+		_mm_storeu_ps(&ox[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ax, bw), _mm_mul_ps(aw, bx)), _mm_mul_ps(ay, bz)), _mm_mul_ps(az, by)));
+		_mm_storeu_ps(&oy[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(ay, bw), _mm_mul_ps(aw, by)), _mm_mul_ps(az, bx)), _mm_mul_ps(ax, bz)));
+		_mm_storeu_ps(&oz[i], _mm_sub_ps(_mm_add_ps(_mm_add_ps(
+			_mm_mul_ps(az, bw), _mm_mul_ps(aw, bz)), _mm_mul_ps(ax, by)), _mm_mul_ps(ay, bx)));
+		_mm_storeu_ps(&ow[i], _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(
+			_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz)));
+	}
+#endif
+	for (; i < n; i++){
+		float
+			ax = pax[i], ay = pay[i], az = paz[i], aw = paw[i],
+			bx = pbx[i], by = pby[i], bz = pbz[i], bw = pbw[i];
+		ox[i] = ax * bw + aw * bx + ay * bz - az * by;
+		oy[i] = ay * bw + aw * by + az * bx - ax * bz;
+		oz[i] = az * bw + aw * bz + ax * by - ay * bx;
+		ow[i] = aw * bw - ax * bx - ay * by - az * bz;
+	}
+	return out;
+}
+
+NVQM_API quatsoa *quatsoa_nlerp(quatsoa *out, quatsoa *a, quatsoa *b, float t, size_t n){
+	return quatsoa_normal(quatsoa_lerp(out, a, b, t, n), out, n);
+}
+
+NVQM_API quatsoa *quatsoa_normal(quatsoa *out, quatsoa *a, size_t n){
+	vec4soa vo = x_quatsoa_vec4(out), va = x_quatsoa_vec4(a);
+	vec4soa_normal(&vo, &va, n);
+	return out;
+}
+
+/*
+ * transform hierarchy
+ * a single pass in index order reads the parent's world matrix after it has been written, and a
+ * node is dirty if its own flag or its parent's is set, so the flags spread down each subtree
+ * without a stack or child lists
+ */
+
+static inline void hierarchy_local(mat4 *out, hierarchy *h, size_t i){
+	/* same operations as mat4_rottrans followed by mat4_scale */
+	float ax = h->rot.x[i], ay = h->rot.y[i], az = h->rot.z[i], aw = h->rot.w[i],
+		sx = h->scale.x[i], sy = h->scale.y[i], sz = h->scale.z[i],
+		ax2 = ax + ax,
+		ay2 = ay + ay,
+		az2 = az + az,
+		axx = ax * ax2,
+		axy = ax * ay2,
+		axz = ax * az2,
+		ayy = ay * ay2,
+		ayz = ay * az2,
+		azz = az * az2,
+		awx = aw * ax2,
+		awy = aw * ay2,
+		awz = aw * az2;
+	out->v[ 0] = (1.0f - ayy - azz) * sx;
+	out->v[ 1] = (       axy + awz) * sx;
+	out->v[ 2] = (       axz - awy) * sx;
+	out->v[ 3] = 0.0f;
+	out->v[ 4] = (       axy - awz) * sy;
+	out->v[ 5] = (1.0f - axx - azz) * sy;
+	out->v[ 6] = (       ayz + awx) * sy;
+	out->v[ 7] = 0.0f;
+	out->v[ 8] = (       axz + awy) * sz;
+	out->v[ 9] = (       ayz - awx) * sz;
+	out->v[10] = (1.0f - axx - ayy) * sz;
+	out->v[11] = 0.0f;
+	out->v[12] = h->pos.x[i];
+	out->v[13] = h->pos.y[i];
+	out->v[14] = h->pos.z[i];
+	out->v[15] = 1.0f;
+}
+
+static hierarchy *hierarchy_run(hierarchy *h, int all){
+	int *parent = h->parent;
+	unsigned char *dirty = h->dirty;
+	mat4 *world = h->world;
+	size_t n = h->count, i = 0;
+	if (!all){
+		/* nothing before the first dirty node can change */
+		while (i < n && !dirty[i])
+			i++;
+	}
+	size_t first = i;
+	for (; i < n; i++){
+		int p = parent[i];
+		if (p >= 0 && (size_t)p >= i)
+			return (hierarchy *)0;
+		if (!all && !dirty[i]){
+			if (p < 0 || !dirty[p])
+				continue;
+			dirty[i] = 1;
+		}
+		if (p < 0)
+			hierarchy_local(&world[i], h, i);
+		else{
+			mat4 local;
+			hierarchy_local(&local, h, i);
+			mat4_mul_affine(&world[i], &world[p], &local);
+		}
+	}
+	for (i = first; i < n; i++)
+		dirty[i] = 0;
+	return h;
+}
+
+NVQM_API hierarchy *hierarchy_update(hierarchy *h){
+	return hierarchy_run(h, 0);
+}
+
+NVQM_API hierarchy *hierarchy_updateall(hierarchy *h){
+	return hierarchy_run(h, 1);
+}
+
+/*
+ * frustum culling
+ */
+
+NVQM_API frustum *frustum_frommat4(frustum *out, mat4 *a){
+	/* each plane is the bottom row plus or minus another row, which is -w <= x, y, z <= w in clip
+	 * space */
+	static const int row[6] = { 0, 0, 1, 1, 2, 2 };
+	for (int k = 0; k < 6; k++){
+		int r = row[k];
+		float s = (k & 1) ? -1.0f : 1.0f;
+		float
+			x = a->v[ 3] + s * a->v[ 0 + r],
+			y = a->v[ 7] + s * a->v[ 4 + r],
+			z = a->v[11] + s * a->v[ 8 + r],
+			w = a->v[15] + s * a->v[12 + r],
+			len = x * x + y * y + z * z;
+		if (len > 0.0f){
+			/* degenerate planes, like the far plane of an infinite projection, are left as-is */
+			len = 1.0f / num_sqrt(len);
+			x *= len;
+			y *= len;
+			z *= len;
+			w *= len;
+		}
+		out->v[k] = vec4_new(x, y, z, w);
+	}
+	return out;
+}
+
+/* the kernels fill whole 32 bit words, for spheres when `radius` is set, and boxes otherwise, where
+ * bx[k], by[k], bz[k] point to the coordinates to test against plane `k`
+ * the order of operations is the same as frustum_cull_c, so the bits are the same
+ */
 
-#ifndef NVQM_SKIP_FIXED_POINT
+static void frustum_cull_c(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t i, size_t n){
+	for (; i < n; i++){
+		if ((i & 31) == 0)
+			out[i >> 5] = 0;
+		float nr = radius ? -radius[i] : 0.0f;
+		uint32_t vis = 1;
+		for (int k = 0; k < 6; k++){
+			vec4 p = f->v[k];
+			vis &= p.v[0] * bx[k][i] + p.v[1] * by[k][i] + p.v[2] * bz[k][i] + p.v[3] >= nr;
+		}
+		out[i >> 5] |= vis << (i & 31);
+	}
+}
 
-xang xint_atan2(xint y, xint x){
-	static const xint c1 = 0x0200, c2 = 0x0600, c3 = 0x0080, c4 = 0x0280;
-	if (y == 0 && x == 0)
-		return 0;
-	if (x == XINT1){
-		/* hard-code some atan2(y, 1) values at the limits */
-		if (y <= -42722234) return (xang)3073;
-		if (y >=  42722235) return (xang)1023;
-	}
-	xint abs_y = xint_abs(y);
-	xang angle;
-	if (x >= 0){
-		xint d = xint_add(x, abs_y);
-		if (d == 0)
-			return 0;
-		xint r = xint_div(xint_sub(x, abs_y), d);
-		xint r3 = xint_mul(xint_mul(r, r), r);
-		angle = (xang)xint_add(xint_sub(xint_mul(c3, r3), xint_mul(c4, r)), c1);
+#ifdef NVQM_SSE2
+static inline __m128 frustum_plane_sse2(__m128 vis, const __m128 *p, __m128 x, __m128 y, __m128 z,
+	__m128 lim){
+	/* p points to the plane's x, y, z, w, each broadcast to all lanes */
+	__m128 d = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(p[0], x), _mm_mul_ps(p[1], y)), _mm_mul_ps(p[2], z)), p[3]);
+	return _mm_and_ps(vis, _mm_cmpge_ps(d, lim));
+}
+
+static void frustum_cull_sse2(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t words){
+	__m128 p[24];
+	for (int k = 0; k < 24; k++)
+		p[k] = _mm_set1_ps(f->v[k >> 2].v[k & 3]);
+	__m128 ones = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	if (radius){
+		__m128 sign = _mm_set1_ps(-0.0f);
+		float *cx = bx[0], *cy = by[0], *cz = bz[0];
+		for (size_t w = 0; w < words; w++){
+			uint32_t bits = 0;
+			for (int j = 0; j < 32; j += 4){
+				size_t i = w * 32 + j;
+				__m128
+					x = _mm_loadu_ps(&cx[i]),
+					y = _mm_loadu_ps(&cy[i]),
+					z = _mm_loadu_ps(&cz[i]),
+					nr = _mm_xor_ps(_mm_loadu_ps(&radius[i]), sign),
+					vis = ones;
+				vis = frustum_plane_sse2(vis, &p[ 0], x, y, z, nr);
+				vis = frustum_plane_sse2(vis, &p[ 4], x, y, z, nr);
+				vis = frustum_plane_sse2(vis, &p[ 8], x, y, z, nr);
+				vis = frustum_plane_sse2(vis, &p[12], x, y, z, nr);
+				vis = frustum_plane_sse2(vis, &p[16], x, y, z, nr);
+				vis = frustum_plane_sse2(vis, &p[20], x, y, z, nr);
+				bits |= (uint32_t)_mm_movemask_ps(vis) << j;
+			}
+			out[w] = bits;
+		}
 	}
 	else{
-		xint d = xint_sub(abs_y, x);
-		if (d == 0)
-			return 0;
-		xint r = xint_div(xint_add(x, abs_y), d);
-		xint r3 = xint_mul(xint_mul(r, r), r);
-		angle = (xang)xint_add(xint_sub(xint_mul(c3, r3), xint_mul(c4, r)), c2);
+		__m128 zero = _mm_setzero_ps();
+		#define PLANE(k) frustum_plane_sse2(vis, &p[(k) * 4], _mm_loadu_ps(&bx[k][i]), \
+			_mm_loadu_ps(&by[k][i]), _mm_loadu_ps(&bz[k][i]), zero)
+		for (size_t w = 0; w < words; w++){
+			uint32_t bits = 0;
+			for (int j = 0; j < 32; j += 4){
+				size_t i = w * 32 + j;
+				__m128 vis = ones;
+				vis = PLANE(0);
+				vis = PLANE(1);
+				vis = PLANE(2);
+				vis = PLANE(3);
+				vis = PLANE(4);
+				vis = PLANE(5);
+				bits |= (uint32_t)_mm_movemask_ps(vis) << j;
+			}
+			out[w] = bits;
+		}
+		#undef PLANE
 	}
-	if (y < 0)
-		return angle == 0 ? 0 : XANG360 - angle;
-	return angle;
 }
 
-xang xint_atan(xint a){
-	return xint_atan2(a, XINT1);
+#ifdef NVQM_DISPATCH
+NVQM_TARGET("avx")
+static inline __m256 frustum_plane_avx(__m256 vis, const __m256 *p, __m256 x, __m256 y, __m256 z,
+	__m256 lim){
+	__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(
+		_mm256_mul_ps(p[0], x), _mm256_mul_ps(p[1], y)), _mm256_mul_ps(p[2], z)), p[3]);
+	return _mm256_and_ps(vis, _mm256_cmp_ps(d, lim, _CMP_GE_OQ));
 }
 
-xang xint_acos(xint a){
-	if (a <= -XINT1)
-		return XANG180;
-	if (a >= XINT1)
-		return XANG0;
-	if (a > -51 && a < 51) /* high error rate right around 0, so just do it manually */
-		return XANG90;
-	xint res = xint_atan2(xint_div(xint_sqrt(xint_sub(XINT1, xint_mul(a, a))), a), XINT1);
-	if (a < 0)
-		res = (res + XANG180) % XANG360;
-	return res;
+NVQM_TARGET("avx")
+static void frustum_cull_avx(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t words){
+	__m256 p[24];
+	for (int k = 0; k < 24; k++)
+		p[k] = _mm256_set1_ps(f->v[k >> 2].v[k & 3]);
+	__m256 ones = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	if (radius){
+		__m256 sign = _mm256_set1_ps(-0.0f);
+		float *cx = bx[0], *cy = by[0], *cz = bz[0];
+		for (size_t w = 0; w < words; w++){
+			uint32_t bits = 0;
+			for (int j = 0; j < 32; j += 8){
+				size_t i = w * 32 + j;
+				__m256
+					x = _mm256_loadu_ps(&cx[i]),
+					y = _mm256_loadu_ps(&cy[i]),
+					z = _mm256_loadu_ps(&cz[i]),
+					nr = _mm256_xor_ps(_mm256_loadu_ps(&radius[i]), sign),
+					vis = ones;
+				vis = frustum_plane_avx(vis, &p[ 0], x, y, z, nr);
+				vis = frustum_plane_avx(vis, &p[ 4], x, y, z, nr);
+				vis = frustum_plane_avx(vis, &p[ 8], x, y, z, nr);
+				vis = frustum_plane_avx(vis, &p[12], x, y, z, nr);
+				vis = frustum_plane_avx(vis, &p[16], x, y, z, nr);
+				vis = frustum_plane_avx(vis, &p[20], x, y, z, nr);
+				bits |= (uint32_t)_mm256_movemask_ps(vis) << j;
+			}
+			out[w] = bits;
+		}
+	}
+	else{
+		__m256 zero = _mm256_setzero_ps();
+		#define PLANE(k) frustum_plane_avx(vis, &p[(k) * 4], _mm256_loadu_ps(&bx[k][i]), \
+			_mm256_loadu_ps(&by[k][i]), _mm256_loadu_ps(&bz[k][i]), zero)
+		for (size_t w = 0; w < words; w++){
+			uint32_t bits = 0;
+			for (int j = 0; j < 32; j += 8){
+				size_t i = w * 32 + j;
+				__m256 vis = ones;
+				vis = PLANE(0);
+				vis = PLANE(1);
+				vis = PLANE(2);
+				vis = PLANE(3);
+				vis = PLANE(4);
+				vis = PLANE(5);
+				bits |= (uint32_t)_mm256_movemask_ps(vis) << j;
+			}
+			out[w] = bits;
+		}
+		#undef PLANE
+	}
 }
 
-xang xint_asin(xint a){
-	if (a <= -XINT1)
-		return XANG270;
-	if (a >= XINT1)
-		return XANG90;
-	if (a > -51 && a < 51) /* high error rate right around 0, so just do it manually */
-		return XANG0;
-	return xint_atan2(xint_div(a, xint_sqrt(xint_sub(XINT1, xint_mul(a, a)))), XINT1);
+static void frustum_cull_init(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t words);
+static void (*frustum_cull_f)(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t words) = frustum_cull_init;
+
+static void frustum_cull_init(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t words){
+	if (cpu_features() & CPU_AVX)
+		frustum_cull_f = frustum_cull_avx;
+	else
+		frustum_cull_f = frustum_cull_sse2;
+	frustum_cull_f(out, f, bx, by, bz, radius, words);
+}
+#endif /* NVQM_DISPATCH */
+#endif /* NVQM_SSE2 */
+
+static uint32_t *frustum_cull(uint32_t *out, frustum *f, float **bx, float **by, float **bz,
+	float *radius, size_t n){
+	size_t i = 0;
+#if defined(NVQM_DISPATCH)
+	frustum_cull_f(out, f, bx, by, bz, radius, n >> 5);
+	i = n & ~(size_t)31;
+#elif defined(NVQM_SSE2)
+	frustum_cull_sse2(out, f, bx, by, bz, radius, n >> 5);
+	i = n & ~(size_t)31;
+#endif
+	frustum_cull_c(out, f, bx, by, bz, radius, i, n);
+	return out;
+}
+
+NVQM_API uint32_t *frustum_cullspheres(uint32_t *out, frustum *f, vec3soa *center, float *radius,
+	size_t n){
+	float *bx[6], *by[6], *bz[6];
+	for (int k = 0; k < 6; k++){
+		bx[k] = center->x;
+		by[k] = center->y;
+		bz[k] = center->z;
+	}
+	return frustum_cull(out, f, bx, by, bz, radius, n);
+}
+
+NVQM_API uint32_t *frustum_cullaabbs(uint32_t *out, frustum *f, vec3soa *min, vec3soa *max,
+	size_t n){
+	/* only the corner furthest along each plane's normal needs testing, and which corner that is
+	 * depends on the signs of the normal, so pick the arrays for it up front */
+	float *bx[6], *by[6], *bz[6];
+	for (int k = 0; k < 6; k++){
+		bx[k] = f->v[k].v[0] >= 0.0f ? max->x : min->x;
+		by[k] = f->v[k].v[1] >= 0.0f ? max->y : min->y;
+		bz[k] = f->v[k].v[2] >= 0.0f ? max->z : min->z;
+	}
+	return frustum_cull(out, f, bx, by, bz, (float *)0, n);
 }
 
+#endif /* NVQM_SKIP_FLOATING_POINT */
+
+#ifndef NVQM_SKIP_FIXED_POINT
+
 static inline int64_t x_mul31(int64_t res, int64_t f){
 	/* res is Q33.31 and f is Q0.32 */
 	return (int64_t)(((uint64_t)res * (uint64_t)f) >> 32);
@@ -1017,7 +2898,7 @@ static inline xint x_exp2(int64_t a){
 	return (xint)(fract << (whole - 15));
 }
 
-xint xint_exp(xint a){
+NVQM_API xint xint_exp(xint a){
 	if (a == 0)
 		return XINT1;
 	if (a > 681391)
@@ -1083,7 +2964,7 @@ static inline xint x_log2(xint a){
 	return xint_add(xint_fromint(base), frac);
 }
 
-xint xint_log(xint a){
+NVQM_API xint xint_log(xint a){
 	if (a <= 0)
 		return XINTMIN;
 	else if (a == 1) /* must hard code these because it's too small to calculate */
@@ -1102,91 +2983,451 @@ xint xint_log(xint a){
 	return res;
 }
 
-xint xint_pow(xint a, xint b){
-	if (a < 0)
-		return -xint_pow(-a, b);
+/* 2^15 / sqrt((i + 64.5) / 256), the starting guess for x_isqrt */
+static const uint16_t x_rsqrt__lut[192] = {
+	65281, 64781, 64292, 63814, 63347, 62889, 62442, 62004, 61575, 61154, 60742, 60339, 59943, 59555,
+	59175, 58801, 58435, 58075, 57722, 57376, 57035, 56700, 56372, 56049, 55731, 55419, 55112, 54810,
+	54513, 54221, 53933, 53650, 53371, 53097, 52826, 52560, 52298, 52040, 51785, 51535, 51288, 51044,
+	50804, 50567, 50333, 50103, 49876, 49652, 49430, 49212, 48997, 48784, 48574, 48367, 48163, 47961,
+	47761, 47564, 47370, 47178, 46988, 46800, 46615, 46432, 46251, 46072, 45895, 45720, 45547, 45376,
+	45207, 45040, 44875, 44711, 44550, 44390, 44232, 44075, 43920, 43767, 43615, 43465, 43316, 43169,
+	43024, 42879, 42737, 42595, 42456, 42317, 42180, 42044, 41910, 41776, 41644, 41514, 41384, 41256,
+	41129, 41003, 40878, 40754, 40631, 40510, 40390, 40270, 40152, 40035, 39919, 39803, 39689, 39576,
+	39464, 39352, 39242, 39133, 39024, 38916, 38810, 38704, 38599, 38494, 38391, 38289, 38187, 38086,
+	37986, 37887, 37788, 37690, 37593, 37497, 37401, 37307, 37213, 37119, 37027, 36935, 36843, 36753,
+	36663, 36573, 36485, 36397, 36309, 36222, 36136, 36051, 35966, 35882, 35798, 35715, 35632, 35550,
+	35469, 35388, 35307, 35228, 35148, 35070, 34991, 34914, 34837, 34760, 34684, 34608, 34533, 34458,
+	34384, 34310, 34237, 34164, 34092, 34020, 33949, 33878, 33807, 33737, 33668, 33599, 33530, 33461,
+	33393, 33326, 33259, 33192, 33126, 33060, 32994, 32929, 32864, 32800
+};
+
+static inline int x_clz64(uint64_t n){
+	/* leading zeros of n > 0, rounded down to even, so shifting by it keeps square roots exact */
+#if defined(__GNUC__)
+	return __builtin_clzll(n) & ~1;
+#else
+	int k = 0;
+	if (!(n >> 32)){ n <<= 32; k += 32; }
+	if (!(n >> 48)){ n <<= 16; k += 16; }
+	if (!(n >> 56)){ n <<=  8; k +=  8; }
+	if (!(n >> 60)){ n <<=  4; k +=  4; }
+	if (!(n >> 62)){ n <<=  2; k +=  2; }
+	return k;
+#endif
+}
+
+static inline uint64_t x_rsqrtn(uint64_t x){
+	/* 2^30 / sqrt(x / 2^32) for x in [2^30, 2^32), using two Newton steps from the table, with a
+	 * relative error below 2^-28 */
+	uint64_t y = (uint64_t)x_rsqrt__lut[(x >> 24) - 64] << 15;
+	y = (y * ((UINT64_C(3) << 30) - ((x * ((y * y) >> 30)) >> 32))) >> 31;
+	y = (y * ((UINT64_C(3) << 30) - ((x * ((y * y) >> 30)) >> 32))) >> 31;
+	return y;
+}
+
+static inline uint32_t x_isqrt(uint64_t n){
+	/* floor(sqrt(n)) for 0 < n < 2^48, using only integer multiplies
+	 * shift n left so x = the top 32 bits is in [2^30, 2^32), then x * x_rsqrtn(x) is within one of
+	 * the answer, and that is fixed up exactly (close to 2^62 it can be two off, see x_isqrt62) */
+	int k = x_clz64(n);
+	uint64_t x = (n << k) >> 32;
+	uint64_t r = (x * x_rsqrtn(x)) >> (30 + (k >> 1));
+	r -= r * r > n;
+	r += (r + 1) * (r + 1) <= n;
+	return (uint32_t)r;
+}
+
+NVQM_API xint xint_rsqrt(xint a){
+	/* 1 / sqrt(a) is 2^24 / sqrt(a) in 16.16, and a << k = x = 2^32 * X, so the result is
+	 * x_rsqrtn(x) >> (22 - k / 2), which is within one of the answer before rounding is made exact
+	 * by comparing (2r +- 1)^2 * a against 2^50 */
+	if (a <= 0)
+		return XINTMAX;
+	int k = x_clz64((uint64_t)a << 32);
+	uint64_t s = 22 - (k >> 1);
+	uint64_t r = (x_rsqrtn((uint64_t)a << k) + (UINT64_C(1) << (s - 1))) >> s;
+	r += (2 * r + 1) * (2 * r + 1) * (uint64_t)a < (UINT64_C(1) << 50);
+	r -= (2 * r - 1) * (2 * r - 1) * (uint64_t)a > (UINT64_C(1) << 50);
+	return (xint)r;
+}
+
+NVQM_API xint xint_sqrt(xint a){
+	/* the result is bit for bit what the original bitwise search gave, which was the largest `res`
+	 * with xint_mul(res, res) < a, except that the search never tried bit 0x20, so results with that
+	 * bit set come out as the largest value below them without it
+	 * the magnitude is unsigned, so XINTMIN no longer recurses forever */
+	uint32_t m = a < 0 ? 0u - (uint32_t)a : (uint32_t)a;
+	if (m == 0)
+		return 0;
+	uint32_t r = x_isqrt(((uint64_t)m << 16) - 1);
+	if (r & 0x20)
+		r = (r & ~UINT32_C(0x3F)) | 0x1F;
+	return a < 0 ? -(xint)r : (xint)r;
+}
+
+/* atan(i / 256) in turns, scaled by 2^32 and rounded, for the first octant */
+static const uint32_t x_atan__lut[257] = {
+	0x00000000, 0x0028BE53, 0x00517C55, 0x007A39B4, 0x00A2F61E, 0x00CBB143, 0x00F46AD1, 0x011D2276,
+	0x0145D7E1, 0x016E8AC2, 0x01973AC8, 0x01BFE7A1, 0x01E890FD, 0x0211368B, 0x0239D7FC, 0x026274FE,
+	0x028B0D43, 0x02B3A07A, 0x02DC2E54, 0x0304B681, 0x032D38B4, 0x0355B49C, 0x037E29EB, 0x03A69855,
+	0x03CEFF8A, 0x03F75F3D, 0x041FB721, 0x044806EA, 0x04704E4B, 0x04988CF8, 0x04C0C2A5, 0x04E8EF07,
+	0x051111D4, 0x05392AC1, 0x05613984, 0x05893DD4, 0x05B13767, 0x05D925F6, 0x06010937, 0x0628E0E5,
+	0x0650ACB7, 0x06786C67, 0x06A01FAF, 0x06C7C649, 0x06EF5FF2, 0x0716EC63, 0x073E6B5B, 0x0765DC95,
+	0x078D3FCF, 0x07B494C6, 0x07DBDB3A, 0x080312EA, 0x082A3B95, 0x085154FC, 0x08785EDF, 0x089F5902,
+	0x08C64325, 0x08ED1D0D, 0x0913E67C, 0x093A9F37, 0x09614704, 0x0987DDA7, 0x09AE62E7, 0x09D4D68B,
+	0x09FB385B, 0x0A218820, 0x0A47C5A2, 0x0A6DF0AC, 0x0A940907, 0x0ABA0E80, 0x0AE000E2, 0x0B05DFFA,
+	0x0B2BAB95, 0x0B516382, 0x0B770790, 0x0B9C978D, 0x0BC2134C, 0x0BE77A9B, 0x0C0CCD4F, 0x0C320B38,
+	0x0C57342B, 0x0C7C47FB, 0x0CA1467D, 0x0CC62F87, 0x0CEB02EF, 0x0D0FC08D, 0x0D346837, 0x0D58F9C7,
+	0x0D7D7515, 0x0DA1D9FC, 0x0DC62856, 0x0DEA6000, 0x0E0E80D4, 0x0E328AB1, 0x0E567D73, 0x0E7A58FA,
+	0x0E9E1D24, 0x0EC1C9D1, 0x0EE55EE3, 0x0F08DC39, 0x0F2C41B7, 0x0F4F8F3F, 0x0F72C4B4, 0x0F95E1FB,
+	0x0FB8E6F9, 0x0FDBD394, 0x0FFEA7B1, 0x10216337, 0x1044060F, 0x10669021, 0x10890156, 0x10AB5998,
+	0x10CD98D1, 0x10EFBEED, 0x1111CBD6, 0x1133BF7A, 0x115599C7, 0x11775AA8, 0x1199020E, 0x11BA8FE7,
+	0x11DC0423, 0x11FD5EB3, 0x121E9F86, 0x123FC690, 0x1260D3C2, 0x1281C70F, 0x12A2A06A, 0x12C35FC8,
+	0x12E4051E, 0x13049060, 0x13250184, 0x13455882, 0x1365954F, 0x1385B7E4, 0x13A5C038, 0x13C5AE45,
+	0x13E58204, 0x14053B6E, 0x1424DA7E, 0x14445F2E, 0x1463C97A, 0x1483195F, 0x14A24ED8, 0x14C169E2,
+	0x14E06A7B, 0x14FF50A0, 0x151E1C51, 0x153CCD8C, 0x155B6450, 0x1579E09E, 0x15984275, 0x15B689D7,
+	0x15D4B6C5, 0x15F2C93F, 0x1610C149, 0x162E9EE6, 0x164C6217, 0x166A0AE0, 0x16879946, 0x16A50D4C,
+	0x16C266F7, 0x16DFA64C, 0x16FCCB50, 0x1719D60A, 0x1736C67F, 0x17539CB6, 0x177058B6, 0x178CFA85,
+	0x17A9822D, 0x17C5EFB4, 0x17E24323, 0x17FE7C82, 0x181A9BDB, 0x1836A137, 0x18528C9F, 0x186E5E1D,
+	0x188A15BC, 0x18A5B386, 0x18C13785, 0x18DCA1C6, 0x18F7F252, 0x19132937, 0x192E4680, 0x19494A38,
+	0x1964346E, 0x197F052C, 0x1999BC81, 0x19B45A79, 0x19CEDF22, 0x19E94A8A, 0x1A039CBE, 0x1A1DD5CD,
+	0x1A37F5C5, 0x1A51FCB4, 0x1A6BEAAA, 0x1A85BFB5, 0x1A9F7BE5, 0x1AB91F49, 0x1AD2A9F0, 0x1AEC1BEB,
+	0x1B057548, 0x1B1EB61A, 0x1B37DE6F, 0x1B50EE58, 0x1B69E5E6, 0x1B82C529, 0x1B9B8C33, 0x1BB43B15,
+	0x1BCCD1E0, 0x1BE550A5, 0x1BFDB776, 0x1C160664, 0x1C2E3D81, 0x1C465CE0, 0x1C5E6492, 0x1C7654A9,
+	0x1C8E2D38, 0x1CA5EE52, 0x1CBD9807, 0x1CD52A6C, 0x1CECA593, 0x1D04098F, 0x1D1B5672, 0x1D328C4F,
+	0x1D49AB3B, 0x1D60B347, 0x1D77A487, 0x1D8E7F0F, 0x1DA542F1, 0x1DBBF042, 0x1DD28714, 0x1DE9077C,
+	0x1DFF718C, 0x1E15C55A, 0x1E2C02F8, 0x1E422A7A, 0x1E583BF4, 0x1E6E377B, 0x1E841D21, 0x1E99ECFC,
+	0x1EAFA71F, 0x1EC54B9E, 0x1EDADA8D, 0x1EF05401, 0x1F05B80E, 0x1F1B06C8, 0x1F304043, 0x1F456493,
+	0x1F5A73CD, 0x1F6F6E05, 0x1F84534F, 0x1F9923C0, 0x1FADDF6B, 0x1FC28667, 0x1FD718C6, 0x1FEB969D,
+	0x20000000
+};
+
+static inline uint32_t x_atan__oct(uint64_t r){
+	/* atan(r / 2^61) for r in [0, 2^61], interpolated from the table, in 2^32 per turn
+	 * the interpolation is off by at most 2^-20 of a turn, so with the rounding in x_atan__unfold
+	 * results are within half an xang plus a little, even with NVQM_XANG16 */
+	if (r >= (UINT64_C(1) << 61))
+		r = (UINT64_C(1) << 61) - 1;
+	uint64_t i = r >> 53, f = (r >> 21) & 0xFFFFFFFF;
+	return x_atan__lut[i] + (uint32_t)(((uint64_t)(x_atan__lut[i + 1] - x_atan__lut[i]) * f) >> 32);
+}
+
+static inline xang x_atan__unfold(uint32_t z, int swap, int xneg, int yneg){
+	/* reflect a first octant angle back out and round it to the nearest xang, where m is all ones
+	 * for each reflection and (z ^ m) - m negates z, since these are coin flips for random input */
+	uint32_t m = 0 - (uint32_t)swap;
+	z = ((z ^ m) - m) + (UINT32_C(0x40000000) & m);
+	m = 0 - (uint32_t)xneg;
+	z = ((z ^ m) - m) + (UINT32_C(0x80000000) & m);
+	m = 0 - (uint32_t)yneg;
+	z = (z ^ m) - m;
+	int bits = 32 - 12 - XANG__SHIFT;
+	return (xang)(((z + (UINT32_C(1) << (bits - 1))) >> bits) & (XANG360 - 1));
+}
+
+NVQM_API xang xint_atan2(xint y, xint x){
+	/* fold into the first octant, so 0 <= b <= a, then normalize so n = a / 2^(32 - k) is in
+	 * [2^30, 2^32), and x_rsqrtn(n) squared is 2^92 / n, so b / a is bn times that in units of
+	 * 2^-61, without any divides */
+	if (y == 0 && x == 0)
+		return 0;
+	uint64_t ax = x < 0 ? 0 - (uint64_t)x : (uint64_t)x;
+	uint64_t ay = y < 0 ? 0 - (uint64_t)y : (uint64_t)y;
+	int swap = ay > ax;
+	uint64_t d = (ax ^ ay) & (0 - (uint64_t)swap);
+	uint64_t a = ax ^ d, b = ay ^ d;
+	int k = x_clz64(a);
+	uint64_t n = (a << k) >> 32, bn = (b << k) >> 32;
+	uint64_t rs = x_rsqrtn(n);
+	return x_atan__unfold(x_atan__oct(bn * ((rs * rs) >> 31)), swap, x < 0, y < 0);
+}
+
+NVQM_API xang xint_atan(xint a){
+	return xint_atan2(a, XINT1);
+}
+
+static inline uint32_t x_acos__oct(xint a, int *swap){
+	/* with c = |a| and s = sqrt(1 - a^2), the octant ratio min(c, s) / max(c, s) is
+	 * min(c^2, s^2) / sqrt(c^2 s^2), and c^2 = a^2 and s^2 = 2^32 - a^2 are exact in Q32.32, so
+	 * it takes one x_rsqrtn and no square root or divide
+	 * p = c^2 s^2 is normalized like xint_atan2 so x_rsqrtn(n) is 2^46 / sqrt(n), and the ratio
+	 * in units of 2^-61 is min * x_rsqrtn(n) * 2^(k / 2 - 1) */
+	uint64_t c2 = (uint64_t)((int64_t)a * a), s2 = (UINT64_C(1) << 32) - c2;
+	*swap = s2 > c2;
+	uint64_t p = c2 * s2;
+	int k = x_clz64(p);
+	uint64_t rs = x_rsqrtn((p << k) >> 32);
+	return x_atan__oct(((*swap ? c2 : s2) * rs << (k >> 1)) >> 1);
+}
+
+NVQM_API xang xint_acos(xint a){
+	/* atan2(sqrt(1 - a^2), a) */
+	if (a <= -XINT1)
+		return XANG180;
+	if (a >= XINT1)
+		return XANG0;
+	if (a == 0)
+		return XANG90;
+	int swap;
+	uint32_t z = x_acos__oct(a, &swap);
+	return x_atan__unfold(z, swap, a < 0, 0);
+}
+
+NVQM_API xang xint_asin(xint a){
+	/* atan2(a, sqrt(1 - a^2)), where the octant is swapped the other way around */
+	if (a <= -XINT1)
+		return XANG270;
+	if (a >= XINT1)
+		return XANG90;
 	if (a == 0)
-		return XINTMIN;
+		return XANG0;
+	int swap;
+	uint32_t z = x_acos__oct(a, &swap);
+	return x_atan__unfold(z, !swap, 0, a < 0);
+}
 
-	int flip = 0;
-	if (b < 0){
-		b = -b;
-		if (a < XINT1)
-			a = xint_div(XINT1, a); /* double flip -> no flip */
-		else
-			flip = 1;
-	}
-	else if (a < XINT1){
-		a = xint_div(XINT1, a);
-		flip = 1;
+#if defined(__SIZEOF_INT128__)
+static inline uint64_t x_umulhi(uint64_t a, uint64_t b){
+	__extension__ typedef unsigned __int128 u128;
+	return (uint64_t)(((u128)a * b) >> 64);
+}
+#else
+static inline uint64_t x_umulhi(uint64_t a, uint64_t b){
+	uint64_t al = a & 0xFFFFFFFF, ah = a >> 32;
+	uint64_t bl = b & 0xFFFFFFFF, bh = b >> 32;
+	uint64_t lh = al * bh, hl = ah * bl;
+	uint64_t mid = ((al * bl) >> 32) + (lh & 0xFFFFFFFF) + (hl & 0xFFFFFFFF);
+	return ah * bh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+}
+#endif
+
+NVQM_API xlong xlong_div(xlong a, xlong b){
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef __int128 i128;
+	return (xlong)(uint64_t)(((i128)a * XLONG1) / b);
+#else
+	/* |a| * 2^32 / |b|, with a 64 bit divide for the whole part, then long division for the 32
+	 * bits below it, where r < d <= 2^63 so doubling r can't overflow */
+	uint64_t n = a < 0 ? 0 - (uint64_t)a : (uint64_t)a;
+	uint64_t d = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+	uint64_t q = n / d, r = n % d;
+	for (int i = 0; i < 32; i++){
+		r <<= 1;
+		q <<= 1;
+		if (r >= d){
+			r -= d;
+			q |= 1;
+		}
 	}
+	return (xlong)((a < 0) != (b < 0) ? 0 - q : q);
+#endif
+}
 
-	/* res = a^(integer + fraction)
-	 *     = a^(integer) * a^(fraction)
-	 *     = a^(integer) * (2^(log2 a))^(fraction)
-	 *     = a^(integer) * 2^(fraction * log2 a)
-	 */
-	xint res = XINT1;
-	xint base = a;
-	int pow_int = xint_toint(b);
-	while (pow_int){
-		if (pow_int & 1)
-			res = xint_mul(res, base);
-		pow_int >>= 1;
-		base = xint_mul(base, base);
+static inline uint64_t x_isqrt62(uint64_t n){
+	/* floor(sqrt(n)) for 0 < n < 2^62, where the x_isqrt estimate needs more than one fix up */
+	uint64_t r = x_isqrt(n);
+	while (r * r > n)
+		r--;
+	while ((r + 1) * (r + 1) <= n)
+		r++;
+	return r;
+}
+
+static inline int x_sqgt(uint64_t r, uint64_t m){
+	/* r * r > m * 2^32, compared as 128 bit values */
+	uint64_t hi = x_umulhi(r, r), lo = r * r;
+	return hi > (m >> 32) || (hi == (m >> 32) && lo > (m << 32));
+}
+
+NVQM_API xlong xlong_sqrt(xlong a){
+	/* floor(sqrt(m * 2^32)) for the magnitude m
+	 * small values fit x_isqrt62 directly, otherwise q = floor(sqrt(m)) and one Newton step from
+	 * 2^16 q gives 2^16 q + 2^15 (m - q^2) / q, which is at most one too big when q >= 2^15 */
+	uint64_t m = a < 0 ? 0 - (uint64_t)a : (uint64_t)a, r;
+	if (m == 0)
+		return 0;
+	if (m < (UINT64_C(1) << 30))
+		r = x_isqrt62(m << 32);
+	else{
+		uint64_t q = x_isqrt62(m >> 2) << 1;
+		q += (q + 1) * (q + 1) <= m;
+		r = (q << 16) + (((m - q * q) << 15) / q);
+		r -= x_sqgt(r, m);
 	}
+	return a < 0 ? -(xlong)r : (xlong)r;
+}
 
-	int64_t pow_frac = b & 0xFFFF;
-	if (pow_frac)
-		res = xint_mul(res, x_exp2(pow_frac * x_log2(a)));
+/* ceil(2^32 / (1 + i / 64)), so that m * x_pow__rcp[i] is in [1, 1 + 1/64] for m in that segment */
+static const uint64_t x_pow__rcp[64] = {
+	UINT64_C(0x0000000100000000), UINT64_C(0x00000000FC0FC0FD), UINT64_C(0x00000000F83E0F84),
+	UINT64_C(0x00000000F4898D60), UINT64_C(0x00000000F0F0F0F1), UINT64_C(0x00000000ED7303B6),
+	UINT64_C(0x00000000EA0EA0EB), UINT64_C(0x00000000E6C2B449), UINT64_C(0x00000000E38E38E4),
+	UINT64_C(0x00000000E070381D), UINT64_C(0x00000000DD67C8A7), UINT64_C(0x00000000DA740DA8),
+	UINT64_C(0x00000000D79435E6), UINT64_C(0x00000000D4C77B04), UINT64_C(0x00000000D20D20D3),
+	UINT64_C(0x00000000CF6474A9), UINT64_C(0x00000000CCCCCCCD), UINT64_C(0x00000000CA4587E7),
+	UINT64_C(0x00000000C7CE0C7D), UINT64_C(0x00000000C565C87C), UINT64_C(0x00000000C30C30C4),
+	UINT64_C(0x00000000C0C0C0C1), UINT64_C(0x00000000BE82FA0C), UINT64_C(0x00000000BC52640C),
+	UINT64_C(0x00000000BA2E8BA3), UINT64_C(0x00000000B81702E1), UINT64_C(0x00000000B60B60B7),
+	UINT64_C(0x00000000B40B40B5), UINT64_C(0x00000000B21642C9), UINT64_C(0x00000000B02C0B03),
+	UINT64_C(0x00000000AE4C415D), UINT64_C(0x00000000AC769185), UINT64_C(0x00000000AAAAAAAB),
+	UINT64_C(0x00000000A8E83F58), UINT64_C(0x00000000A72F053A), UINT64_C(0x00000000A57EB503),
+	UINT64_C(0x00000000A3D70A3E), UINT64_C(0x00000000A237C32C), UINT64_C(0x00000000A0A0A0A1),
+	UINT64_C(0x000000009F1165E8), UINT64_C(0x000000009D89D89E), UINT64_C(0x000000009C09C09D),
+	UINT64_C(0x000000009A90E7DA), UINT64_C(0x00000000991F1A52), UINT64_C(0x0000000097B425EE),
+	UINT64_C(0x00000000964FDA6D), UINT64_C(0x0000000094F20950), UINT64_C(0x00000000939A85C5),
+	UINT64_C(0x0000000092492493), UINT64_C(0x0000000090FDBC0A), UINT64_C(0x000000008FB823EF),
+	UINT64_C(0x000000008E78356E), UINT64_C(0x000000008D3DCB09), UINT64_C(0x000000008C08C08D),
+	UINT64_C(0x000000008AD8F2FC), UINT64_C(0x0000000089AE408A), UINT64_C(0x0000000088888889),
+	UINT64_C(0x000000008767AB60), UINT64_C(0x00000000864B8A7E), UINT64_C(0x0000000085340854),
+	UINT64_C(0x0000000084210843), UINT64_C(0x0000000083126E98), UINT64_C(0x0000000082082083),
+	UINT64_C(0x0000000081020409)
+};
 
-	if (flip)
-		res = xint_div(XINT1, res);
-	return res;
+/* -log2(x_pow__rcp[i] / 2^32) at Q0.64 */
+static const uint64_t x_pow__log2[64] = {
+	UINT64_C(0x0000000000000000), UINT64_C(0x05B9E5A010B0099C), UINT64_C(0x0B5D69BA995434CE),
+	UINT64_C(0x10EB389EE9F55F8B), UINT64_C(0x1663F6FAB1FDCF18), UINT64_C(0x1BC842405CE14082),
+	UINT64_C(0x2118B1183814AD28), UINT64_C(0x2655D3C385CD0FC6), UINT64_C(0x2B8034733F02D416),
+	UINT64_C(0x3098579ECFD8566B), UINT64_C(0x359EBC59D5E4C676), UINT64_C(0x3A93DC972188F80A),
+	UINT64_C(0x3F782D7065510F2B), UINT64_C(0x444C1F6A20193709), UINT64_C(0x49101EAA8D133D3A),
+	UINT64_C(0x4DC49339B2283B4C), UINT64_C(0x5269E12ED8190E65), UINT64_C(0x570068E76A9FC3F9),
+	UINT64_C(0x5B8887363A7E46E1), UINT64_C(0x6002958B2C5CB0A8), UINT64_C(0x646EEA22AEB28EED),
+	UINT64_C(0x68CDD82984518BA3), UINT64_C(0x6D1FAFDCB3DFF3C6), UINT64_C(0x7164BEB43202F500),
+	UINT64_C(0x759D4F809D7DAD2F), UINT64_C(0x79C9AA8654640ED0), UINT64_C(0x7DEA15A13BD1BC3B),
+	UINT64_C(0x81FED45AC6BD28C6), UINT64_C(0x86082805579603D7), UINT64_C(0x8A064FD48A6FC26B),
+	UINT64_C(0x8DF988F3D33648DD), UINT64_C(0x91E20E9F2C1A2804), UINT64_C(0x95C01A39432C4C76),
+	UINT64_C(0x9993E353A9111393), UINT64_C(0x9D5D9FD3D4F69644), UINT64_C(0xA11D83F3D6BB2F6C),
+	UINT64_C(0xA4D3C25D25B2706A), UINT64_C(0xA8808C36325E5CDA), UINT64_C(0xAC241133E99F77DC),
+	UINT64_C(0xAFBE7F9EF4795316), UINT64_C(0xB3500471274705AC), UINT64_C(0xB6D8CB5169F10413),
+	UINT64_C(0xBA58FEB0E7D0E080), UINT64_C(0xBDD0C7C81422BEE6), UINT64_C(0xC1404EAB9B5A569A),
+	UINT64_C(0xC4A7BA55D98DC7E6), UINT64_C(0xC80730ADD617B678), UINT64_C(0xCB5ED692FC3679AF),
+	UINT64_C(0xCEAECFE8B2DC074D), UINT64_C(0xD1F73F9A0D0D128D), UINT64_C(0xD53847A985DD708B),
+	UINT64_C(0xD8720933828F7AC6), UINT64_C(0xDBA4A47A362C6D61), UINT64_C(0xDED038E3A7DA4CC1),
+	UINT64_C(0xE1F4E516262DDFA8), UINT64_C(0xE512C6E46E4E8B6F), UINT64_C(0xE829FB67ED1ACC11),
+	UINT64_C(0xEB3A9EFF6D51C678), UINT64_C(0xEE44CD59BA6B8CC4), UINT64_C(0xF148A16E5D2096E8),
+	UINT64_C(0xF446359875EA7EDD), UINT64_C(0xF73DA38C5A209C64), UINT64_C(0xFA2F045BB829A8E7),
+	UINT64_C(0xFD1A70890F588F15)
+};
+
+/* 2^(i / 64) at Q1.63 */
+static const uint64_t x_pow__exp2[64] = {
+	UINT64_C(0x8000000000000000), UINT64_C(0x8164D1F3BC030773), UINT64_C(0x82CD8698AC2BA1D7),
+	UINT64_C(0x843A28C3ACDE4046), UINT64_C(0x85AAC367CC487B15), UINT64_C(0x871F61969E8D1010),
+	UINT64_C(0x88980E8092DA8527), UINT64_C(0x8A14D575496EFD9A), UINT64_C(0x8B95C1E3EA8BD6E7),
+	UINT64_C(0x8D1ADF5B7E5BA9E6), UINT64_C(0x8EA4398B45CD53C0), UINT64_C(0x9031DC431466B1DC),
+	UINT64_C(0x91C3D373AB11C336), UINT64_C(0x935A2B2F13E6E92C), UINT64_C(0x94F4EFA8FEF70961),
+	UINT64_C(0x96942D3720185A00), UINT64_C(0x9837F0518DB8A96F), UINT64_C(0x99E0459320B7FA65),
+	UINT64_C(0x9B8D39B9D54E5539), UINT64_C(0x9D3ED9A72CFFB751), UINT64_C(0x9EF5326091A111AE),
+	UINT64_C(0xA0B0510FB9714FC2), UINT64_C(0xA27043030C496819), UINT64_C(0xA43515AE09E6809E),
+	UINT64_C(0xA5FED6A9B15138EA), UINT64_C(0xA7CD93B4E965356A), UINT64_C(0xA9A15AB4EA7C0EF8),
+	UINT64_C(0xAB7A39B5A93ED337), UINT64_C(0xAD583EEA42A14AC6), UINT64_C(0xAF3B78AD690A4375),
+	UINT64_C(0xB123F581D2AC2590), UINT64_C(0xB311C412A9112489), UINT64_C(0xB504F333F9DE6484),
+	UINT64_C(0xB6FD91E328D17791), UINT64_C(0xB8FBAF4762FB9EE9), UINT64_C(0xBAFF5AB2133E45FB),
+	UINT64_C(0xBD08A39F580C36BF), UINT64_C(0xBF1799B67A731083), UINT64_C(0xC12C4CCA66709456),
+	UINT64_C(0xC346CCDA24976407), UINT64_C(0xC5672A115506DADD), UINT64_C(0xC78D74C8ABB9B15D),
+	UINT64_C(0xC9B9BD866E2F27A3), UINT64_C(0xCBEC14FEF2727C5D), UINT64_C(0xCE248C151F8480E4),
+	UINT64_C(0xD06333DAEF2B2595), UINT64_C(0xD2A81D91F12AE45A), UINT64_C(0xD4F35AABCFEDFA1F),
+	UINT64_C(0xD744FCCAD69D6AF4), UINT64_C(0xD99D15C278AFD7B6), UINT64_C(0xDBFBB797DAF23755),
+	UINT64_C(0xDE60F4825E0E9124), UINT64_C(0xE0CCDEEC2A94E111), UINT64_C(0xE33F8972BE8A5A51),
+	UINT64_C(0xE5B906E77C8348A8), UINT64_C(0xE8396A503C4BDC68), UINT64_C(0xEAC0C6E7DD24392F),
+	UINT64_C(0xED4F301ED9942B84), UINT64_C(0xEFE4B99BDCDAF5CB), UINT64_C(0xF281773C59FFB13A),
+	UINT64_C(0xF5257D152486CC2C), UINT64_C(0xF7D0DF730AD13BB9), UINT64_C(0xFA83B2DB722A033A),
+	UINT64_C(0xFD3E0C0CF486C175)
+};
+
+static inline uint64_t x_pow_log2m(uint64_t m){
+	/* log2(m / 2^31) at Q0.64 for m in [2^31, 2^32)
+	 * m is scaled by a table reciprocal to 1 + t with 0 <= t < 2^-6, and log2(1 + t) is the Taylor
+	 * series to t^7 with Q2.62 coefficients 1 / (k ln 2), which leaves an error around 2^-50 */
+	static const uint64_t
+		c1 = UINT64_C(0x5C551D94AE0BF85E),
+		c2 = UINT64_C(0x2E2A8ECA5705FC2F),
+		c3 = UINT64_C(0x1EC709DC3A03FD75),
+		c4 = UINT64_C(0x171547652B82FE17),
+		c5 = UINT64_C(0x12776C50EF9BFE79),
+		c6 = UINT64_C(0x0F6384EE1D01FEBA),
+		c7 = UINT64_C(0x0D30BB153D6F6CA0);
+	int i = (int)(m >> 25) & 63;
+	uint64_t t = (m * x_pow__rcp[i] - (UINT64_C(1) << 63)) << 1;
+	uint64_t p = c7;
+	p = c6 - x_umulhi(t, p);
+	p = c5 - x_umulhi(t, p);
+	p = c4 - x_umulhi(t, p);
+	p = c3 - x_umulhi(t, p);
+	p = c2 - x_umulhi(t, p);
+	p = c1 - x_umulhi(t, p);
+	return x_pow__log2[i] + (x_umulhi(t, p) << 2);
 }
 
-xint xint_sqrt(xint a){
-	if (a < 0)
-		return -xint_sqrt(-a);
-	xint res = 0;
-	xint res2, m;
-	#define X(b)                  \
-		res2 = res | b;           \
-		m = xint_mul(res2, res2); \
-		if (m >= 0 && m < a)      \
-			res = res2;
-	X(0x00800000);
-	X(0x00400000);
-	X(0x00200000);
-	X(0x00100000);
-	X(0x00080000);
-	X(0x00040000);
-	X(0x00020000);
-	X(0x00010000);
-	X(0x00008000);
-	X(0x00004000);
-	X(0x00002000);
-	X(0x00001000);
-	X(0x00000800);
-	X(0x00000400);
-	X(0x00000200);
-	X(0x00000100);
-	X(0x00000080);
-	X(0x00000040);
-	X(0x00000010);
-	X(0x00000008);
-	X(0x00000004);
-	X(0x00000002);
-	X(0x00000001);
-	#undef X
-	return res;
+static inline uint64_t x_pow_exp2f(uint64_t f){
+	/* 2^(f / 2^64) at Q3.61
+	 * the top six bits pick 2^(i / 64) from the table, and 2^r for the rest is the Taylor series to
+	 * r^6 with Q2.62 coefficients ln(2)^k / k! */
+	static const uint64_t
+		d1 = UINT64_C(0x2C5C85FDF473DE6B),
+		d2 = UINT64_C(0x0F5FDEFFC162C754),
+		d3 = UINT64_C(0x038D611AE09417F1),
+		d4 = UINT64_C(0x009D955B7DD273B9),
+		d5 = UINT64_C(0x0015D87FE78A6731),
+		d6 = UINT64_C(0x0002861225F0D8F1);
+	uint64_t r = f & ((UINT64_C(1) << 58) - 1);
+	uint64_t q = d6;
+	q = d5 + x_umulhi(r, q);
+	q = d4 + x_umulhi(r, q);
+	q = d3 + x_umulhi(r, q);
+	q = d2 + x_umulhi(r, q);
+	q = d1 + x_umulhi(r, q);
+	q = (UINT64_C(1) << 62) + x_umulhi(r, q);
+	return x_umulhi(x_pow__exp2[f >> 58], q);
+}
+
+NVQM_API xint xint_pow(xint a, xint b){
+	/* a^b = 2^(b * log2 a), with no loops and no divides, so it takes the same time for any b
+	 * log2 |a| is e + f, with e in [-16, 15] and f at Q0.64, and b * log2 |a| is formed at Q23.40,
+	 * which is far more precision than a Q16.16 result can show: the answer is within 0.5 units
+	 * (plus a rounding hair) of the exact power of the two inputs
+	 * out of range results saturate to XINTMAX or 0, and a < 0 gives -(-a)^b like before */
+	if (a == 0)
+		return b > 0 ? 0 : b == 0 ? XINT1 : XINTMAX;
+	uint32_t mag = a < 0 ? 0u - (uint32_t)a : (uint32_t)a;
+	uint32_t bmag = b < 0 ? 0u - (uint32_t)b : (uint32_t)b;
+
+	/* normalize |a| so the top bit is at 2^63, to get the exponent and the mantissa */
+	uint64_t x = (uint64_t)mag << 32;
+	int k = x_clz64(x);
+	x <<= k;
+	if (!(x >> 63)){
+		x <<= 1;
+		k++;
+	}
+	int e = 15 - k;
+	uint64_t f = x_pow_log2m(x >> 32);
+
+	/* p = b * (e + f) at Q23.40 */
+	int64_t bf = (int64_t)(x_umulhi((uint64_t)bmag << 32, f) >> 8);
+	int64_t p = (int64_t)b * e * (INT64_C(1) << 24) + (b < 0 ? -bf : bf);
+
+	xint res;
+	if (p >= (INT64_C(15) << 40))
+		res = XINTMAX;
+	else if (p < -(INT64_C(17) << 40))
+		res = 0;
+	else{
+		/* 2^p in units is 2^(p_whole + 16) * 2^p_fraction */
+		int whole = (int)(p >> 40);
+		uint64_t v = x_pow_exp2f((uint64_t)(p & ((INT64_C(1) << 40) - 1)) << 24);
+		int s = 45 - whole;
+		v = (v + (UINT64_C(1) << (s - 1))) >> s;
+		res = v > (uint64_t)XINTMAX ? XINTMAX : (xint)v;
+	}
+	return a < 0 ? -res : res;
 }
 
 /*
  * xmat3
  */
 
-xmat3 *xmat3_add(xmat3 *out, xmat3 *a, xmat3 *b){
+NVQM_API xmat3 *xmat3_add(xmat3 *out, xmat3 *a, xmat3 *b){
 	out->v[0] = xint_add(a->v[0], b->v[0]);
 	out->v[1] = xint_add(a->v[1], b->v[1]);
 	out->v[2] = xint_add(a->v[2], b->v[2]);
@@ -1199,7 +3440,7 @@ xmat3 *xmat3_add(xmat3 *out, xmat3 *a, xmat3 *b){
 	return out;
 }
 
-xmat3 *xmat3_adjoint(xmat3 *out, xmat3 *a){
+NVQM_API xmat3 *xmat3_adjoint(xmat3 *out, xmat3 *a){
 	xint
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -1216,7 +3457,7 @@ xmat3 *xmat3_adjoint(xmat3 *out, xmat3 *a){
 	return out;
 }
 
-xmat3 *xmat3_compmul(xmat3 *out, xmat3 *a, xmat3 *b){
+NVQM_API xmat3 *xmat3_compmul(xmat3 *out, xmat3 *a, xmat3 *b){
 	out->v[0] = xint_mul(a->v[0], b->v[0]);
 	out->v[1] = xint_mul(a->v[1], b->v[1]);
 	out->v[2] = xint_mul(a->v[2], b->v[2]);
@@ -1229,14 +3470,14 @@ xmat3 *xmat3_compmul(xmat3 *out, xmat3 *a, xmat3 *b){
 	return out;
 }
 
-xmat3 *xmat3_copy(xmat3 *out, xmat3 *a){
+NVQM_API xmat3 *xmat3_copy(xmat3 *out, xmat3 *a){
 	out->v[0] = a->v[0]; out->v[1] = a->v[1]; out->v[2] = a->v[2];
 	out->v[3] = a->v[3]; out->v[4] = a->v[4]; out->v[5] = a->v[5];
 	out->v[6] = a->v[6]; out->v[7] = a->v[7]; out->v[8] = a->v[8];
 	return out;
 }
 
-xint xmat3_det(xmat3 *a){
+NVQM_API xint xmat3_det(xmat3 *a){
 	xint
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -1248,14 +3489,27 @@ xint xmat3_det(xmat3 *a){
 	);
 }
 
-xmat3 *xmat3_identity(xmat3 *out){
+NVQM_API xlong xmat3_detl(xmat3 *a){
+	/* the minors are exact, and each term rounds down once */
+	xint
+		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
+		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
+		a20 = a->v[6], a21 = a->v[7], a22 = a->v[8];
+	return xlong_add(xlong_add(
+		xlong_mul(xlong_fromxint(a00), xlong_sub(xlong__mul( a22, a11), xlong__mul(a12, a21))),
+		xlong_mul(xlong_fromxint(a01), xlong_sub(xlong__mul(a12, a20), xlong__mul(a22, a10)))),
+		xlong_mul(xlong_fromxint(a02), xlong_sub(xlong__mul( a21, a10), xlong__mul(a11, a20)))
+	);
+}
+
+NVQM_API xmat3 *xmat3_identity(xmat3 *out){
 	out->v[0] = XINT1; out->v[1] = 0; out->v[2] = 0;
 	out->v[3] = 0; out->v[4] = XINT1; out->v[5] = 0;
 	out->v[6] = 0; out->v[7] = 0; out->v[8] = XINT1;
 	return out;
 }
 
-xmat3 *xmat3_invert(xmat3 *out, xmat3 *a){
+NVQM_API xmat3 *xmat3_invert(xmat3 *out, xmat3 *a){
 	xint
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -1279,7 +3533,7 @@ xmat3 *xmat3_invert(xmat3 *out, xmat3 *a){
 	return out;
 }
 
-xmat3 *xmat3_mul(xmat3 *out, xmat3 *a, xmat3 *b){
+NVQM_API xmat3 *xmat3_mul(xmat3 *out, xmat3 *a, xmat3 *b){
 	xint
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -1287,19 +3541,19 @@ xmat3 *xmat3_mul(xmat3 *out, xmat3 *a, xmat3 *b){
 		b00 = b->v[0], b01 = b->v[1], b02 = b->v[2],
 		b10 = b->v[3], b11 = b->v[4], b12 = b->v[5],
 		b20 = b->v[6], b21 = b->v[7], b22 = b->v[8];
-	out->v[0] = xint_add(xint_add(xint_mul(b00, a00), xint_mul(b01, a10)), xint_mul(b02, a20));
-	out->v[1] = xint_add(xint_add(xint_mul(b00, a01), xint_mul(b01, a11)), xint_mul(b02, a21));
-	out->v[2] = xint_add(xint_add(xint_mul(b00, a02), xint_mul(b01, a12)), xint_mul(b02, a22));
-	out->v[3] = xint_add(xint_add(xint_mul(b10, a00), xint_mul(b11, a10)), xint_mul(b12, a20));
-	out->v[4] = xint_add(xint_add(xint_mul(b10, a01), xint_mul(b11, a11)), xint_mul(b12, a21));
-	out->v[5] = xint_add(xint_add(xint_mul(b10, a02), xint_mul(b11, a12)), xint_mul(b12, a22));
-	out->v[6] = xint_add(xint_add(xint_mul(b20, a00), xint_mul(b21, a10)), xint_mul(b22, a20));
-	out->v[7] = xint_add(xint_add(xint_mul(b20, a01), xint_mul(b21, a11)), xint_mul(b22, a21));
-	out->v[8] = xint_add(xint_add(xint_mul(b20, a02), xint_mul(b21, a12)), xint_mul(b22, a22));
+	out->v[0] = xint_dot3(b00, a00, b01, a10, b02, a20);
+	out->v[1] = xint_dot3(b00, a01, b01, a11, b02, a21);
+	out->v[2] = xint_dot3(b00, a02, b01, a12, b02, a22);
+	out->v[3] = xint_dot3(b10, a00, b11, a10, b12, a20);
+	out->v[4] = xint_dot3(b10, a01, b11, a11, b12, a21);
+	out->v[5] = xint_dot3(b10, a02, b11, a12, b12, a22);
+	out->v[6] = xint_dot3(b20, a00, b21, a10, b22, a20);
+	out->v[7] = xint_dot3(b20, a01, b21, a11, b22, a21);
+	out->v[8] = xint_dot3(b20, a02, b21, a12, b22, a22);
 	return out;
 }
 
-xmat3 *xmat3_quat(xmat3 *out, xquat a){
+NVQM_API xmat3 *xmat3_quat(xmat3 *out, xquat a){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax << 1,
 		ay2 = ay << 1,
@@ -1325,7 +3579,7 @@ xmat3 *xmat3_quat(xmat3 *out, xquat a){
 	return out;
 }
 
-xmat3 *xmat3_rotate(xmat3 *out, xmat3 *a, xang ang){
+NVQM_API xmat3 *xmat3_rotate(xmat3 *out, xmat3 *a, xang ang){
 	xint
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -1343,7 +3597,7 @@ xmat3 *xmat3_rotate(xmat3 *out, xmat3 *a, xang ang){
 	return out;
 }
 
-xmat3 *xmat3_rotation(xmat3 *out, xang ang){
+NVQM_API xmat3 *xmat3_rotation(xmat3 *out, xang ang){
 	xint s = xint_sin(ang), c = xint_cos(ang);
 	out->v[0] =  c;
 	out->v[1] =  s;
@@ -1357,7 +3611,7 @@ xmat3 *xmat3_rotation(xmat3 *out, xang ang){
 	return out;
 }
 
-xmat3 *xmat3_scale(xmat3 *out, xmat3 *a, xvec2 b){
+NVQM_API xmat3 *xmat3_scale(xmat3 *out, xmat3 *a, xvec2 b){
 	xint bx = b.v[0], by = b.v[1];
 	out->v[0] = xint_mul(bx, a->v[0]);
 	out->v[1] = xint_mul(bx, a->v[1]);
@@ -1371,7 +3625,7 @@ xmat3 *xmat3_scale(xmat3 *out, xmat3 *a, xvec2 b){
 	return out;
 }
 
-xmat3 *xmat3_scaling(xmat3 *out, xvec2 a){
+NVQM_API xmat3 *xmat3_scaling(xmat3 *out, xvec2 a){
 	out->v[0] = a.v[0];
 	out->v[1] = 0;
 	out->v[2] = 0;
@@ -1384,7 +3638,7 @@ xmat3 *xmat3_scaling(xmat3 *out, xvec2 a){
 	return out;
 }
 
-xmat3 *xmat3_sub(xmat3 *out, xmat3 *a, xmat3 *b){
+NVQM_API xmat3 *xmat3_sub(xmat3 *out, xmat3 *a, xmat3 *b){
 	out->v[0] = xint_sub(a->v[0], b->v[0]);
 	out->v[1] = xint_sub(a->v[1], b->v[1]);
 	out->v[2] = xint_sub(a->v[2], b->v[2]);
@@ -1397,7 +3651,7 @@ xmat3 *xmat3_sub(xmat3 *out, xmat3 *a, xmat3 *b){
 	return out;
 }
 
-xmat3 *xmat3_translate(xmat3 *out, xmat3 *a, xvec2 b){
+NVQM_API xmat3 *xmat3_translate(xmat3 *out, xmat3 *a, xvec2 b){
 	xint
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[2],
 		a10 = a->v[3], a11 = a->v[4], a12 = a->v[5],
@@ -1415,7 +3669,7 @@ xmat3 *xmat3_translate(xmat3 *out, xmat3 *a, xvec2 b){
 	return out;
 }
 
-xmat3 *xmat3_translation(xmat3 *out, xvec2 a){
+NVQM_API xmat3 *xmat3_translation(xmat3 *out, xvec2 a){
 	out->v[0] = XINT1;
 	out->v[1] = 0;
 	out->v[2] = 0;
@@ -1428,7 +3682,7 @@ xmat3 *xmat3_translation(xmat3 *out, xvec2 a){
 	return out;
 }
 
-xmat3 *xmat3_transpose(xmat3 *out, xmat3 *a){
+NVQM_API xmat3 *xmat3_transpose(xmat3 *out, xmat3 *a){
 	if (out == a) {
 		xint a01 = a->v[1], a02 = a->v[2], a12 = a->v[5];
 		out->v[1] = a->v[3];
@@ -1456,7 +3710,7 @@ xmat3 *xmat3_transpose(xmat3 *out, xmat3 *a){
  * xmat4
  */
 
-xmat4 *xmat4_add(xmat4 *out, xmat4 *a, xmat4 *b){
+NVQM_API xmat4 *xmat4_add(xmat4 *out, xmat4 *a, xmat4 *b){
 	out->v[ 0] = xint_add(a->v[ 0], b->v[ 0]);
 	out->v[ 1] = xint_add(a->v[ 1], b->v[ 1]);
 	out->v[ 2] = xint_add(a->v[ 2], b->v[ 2]);
@@ -1476,7 +3730,7 @@ xmat4 *xmat4_add(xmat4 *out, xmat4 *a, xmat4 *b){
 	return out;
 }
 
-xmat4 *xmat4_adjoint(xmat4 *out, xmat4 *a){
+NVQM_API xmat4 *xmat4_adjoint(xmat4 *out, xmat4 *a){
 	xint
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -1549,7 +3803,7 @@ xmat4 *xmat4_adjoint(xmat4 *out, xmat4 *a){
 	return out;
 }
 
-xmat4 *xmat4_compmul(xmat4 *out, xmat4 *a, xmat4 *b){
+NVQM_API xmat4 *xmat4_compmul(xmat4 *out, xmat4 *a, xmat4 *b){
 	out->v[ 0] = xint_mul(a->v[ 0], b->v[ 0]);
 	out->v[ 1] = xint_mul(a->v[ 1], b->v[ 1]);
 	out->v[ 2] = xint_mul(a->v[ 2], b->v[ 2]);
@@ -1569,7 +3823,7 @@ xmat4 *xmat4_compmul(xmat4 *out, xmat4 *a, xmat4 *b){
 	return out;
 }
 
-xmat4 *xmat4_copy(xmat4 *out, xmat4 *a){
+NVQM_API xmat4 *xmat4_copy(xmat4 *out, xmat4 *a){
 	out->v[ 0] = a->v[ 0]; out->v[ 1] = a->v[ 1]; out->v[ 2] = a->v[ 2]; out->v[ 3] = a->v[ 3];
 	out->v[ 4] = a->v[ 4]; out->v[ 5] = a->v[ 5]; out->v[ 6] = a->v[ 6]; out->v[ 7] = a->v[ 7];
 	out->v[ 8] = a->v[ 8]; out->v[ 9] = a->v[ 9]; out->v[10] = a->v[10]; out->v[11] = a->v[11];
@@ -1577,7 +3831,7 @@ xmat4 *xmat4_copy(xmat4 *out, xmat4 *a){
 	return out;
 }
 
-xint xmat4_det(xmat4 *a){
+NVQM_API xint xmat4_det(xmat4 *a){
 	xint
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -1600,7 +3854,32 @@ xint xmat4_det(xmat4 *a){
 		xint_mul(b04, b07)), xint_mul(b05, b06));
 }
 
-xmat4 *xmat4_frustum(xmat4 *out, xint L, xint R, xint B, xint T, xint N, xint F){
+NVQM_API xlong xmat4_detl(xmat4 *a){
+	/* the 2x2 minors are exact, and each product of two rounds down once */
+	xint
+		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
+		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
+		a20 = a->v[ 8], a21 = a->v[ 9], a22 = a->v[10], a23 = a->v[11],
+		a30 = a->v[12], a31 = a->v[13], a32 = a->v[14], a33 = a->v[15];
+	xlong
+		b00 = xlong_sub(xlong__mul(a00, a11), xlong__mul(a01, a10)),
+		b01 = xlong_sub(xlong__mul(a00, a12), xlong__mul(a02, a10)),
+		b02 = xlong_sub(xlong__mul(a00, a13), xlong__mul(a03, a10)),
+		b03 = xlong_sub(xlong__mul(a01, a12), xlong__mul(a02, a11)),
+		b04 = xlong_sub(xlong__mul(a01, a13), xlong__mul(a03, a11)),
+		b05 = xlong_sub(xlong__mul(a02, a13), xlong__mul(a03, a12)),
+		b06 = xlong_sub(xlong__mul(a20, a31), xlong__mul(a21, a30)),
+		b07 = xlong_sub(xlong__mul(a20, a32), xlong__mul(a22, a30)),
+		b08 = xlong_sub(xlong__mul(a20, a33), xlong__mul(a23, a30)),
+		b09 = xlong_sub(xlong__mul(a21, a32), xlong__mul(a22, a31)),
+		b10 = xlong_sub(xlong__mul(a21, a33), xlong__mul(a23, a31)),
+		b11 = xlong_sub(xlong__mul(a22, a33), xlong__mul(a23, a32));
+	return xlong_add(xlong_sub(xlong_add(xlong_add(xlong_sub(
+		xlong_mul(b00, b11), xlong_mul(b01, b10)), xlong_mul(b02, b09)), xlong_mul(b03, b08)),
+		xlong_mul(b04, b07)), xlong_mul(b05, b06));
+}
+
+NVQM_API xmat4 *xmat4_frustum(xmat4 *out, xint L, xint R, xint B, xint T, xint N, xint F){
 	xint
 		rl = xint_div(XINT1, xint_sub(R, L)),
 		tb = xint_div(XINT1, xint_sub(T, B)),
@@ -1624,7 +3903,7 @@ xmat4 *xmat4_frustum(xmat4 *out, xint L, xint R, xint B, xint T, xint N, xint F)
 	return out;
 }
 
-xmat4 *xmat4_identity(xmat4 *out){
+NVQM_API xmat4 *xmat4_identity(xmat4 *out){
 	out->v[ 0] = XINT1; out->v[ 1] = 0; out->v[ 2] = 0; out->v[ 3] = 0;
 	out->v[ 4] = 0; out->v[ 5] = XINT1; out->v[ 6] = 0; out->v[ 7] = 0;
 	out->v[ 8] = 0; out->v[ 9] = 0; out->v[10] = XINT1; out->v[11] = 0;
@@ -1632,7 +3911,7 @@ xmat4 *xmat4_identity(xmat4 *out){
 	return out;
 }
 
-xmat4 *xmat4_invert(xmat4 *out, xmat4 *a){
+NVQM_API xmat4 *xmat4_invert(xmat4 *out, xmat4 *a){
 	xint
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -1691,7 +3970,7 @@ xmat4 *xmat4_invert(xmat4 *out, xmat4 *a){
 	return out;
 }
 
-xmat4 *xmat4_lookat(xmat4 *out, xvec3 eye, xvec3 position, xvec3 up){
+NVQM_API xmat4 *xmat4_lookat(xmat4 *out, xvec3 eye, xvec3 position, xvec3 up){
 	xint
 		ex = eye.v[0], ey = eye.v[1], ez = eye.v[2],
 		ux = up.v[0], uy = up.v[1], uz = up.v[2],
@@ -1762,7 +4041,7 @@ xmat4 *xmat4_lookat(xmat4 *out, xvec3 eye, xvec3 position, xvec3 up){
 	return out;
 }
 
-xmat4 *xmat4_mul(xmat4 *out, xmat4 *a, xmat4 *b){
+NVQM_API xmat4 *xmat4_mul(xmat4 *out, xmat4 *a, xmat4 *b){
 	xint
 		a00 = a->v[ 0], a01 = a->v[ 1], a02 = a->v[ 2], a03 = a->v[ 3],
 		a10 = a->v[ 4], a11 = a->v[ 5], a12 = a->v[ 6], a13 = a->v[ 7],
@@ -1773,54 +4052,38 @@ xmat4 *xmat4_mul(xmat4 *out, xmat4 *a, xmat4 *b){
 	b1 = b->v[ 1];
 	b2 = b->v[ 2];
 	b3 = b->v[ 3];
-	out->v[ 0] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a00), xint_mul(b1, a10)), xint_mul(b2, a20)), xint_mul(b3, a30));
-	out->v[ 1] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a01), xint_mul(b1, a11)), xint_mul(b2, a21)), xint_mul(b3, a31));
-	out->v[ 2] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a02), xint_mul(b1, a12)), xint_mul(b2, a22)), xint_mul(b3, a32));
-	out->v[ 3] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a03), xint_mul(b1, a13)), xint_mul(b2, a23)), xint_mul(b3, a33));
+	out->v[ 0] = xint_dot4(b0, a00, b1, a10, b2, a20, b3, a30);
+	out->v[ 1] = xint_dot4(b0, a01, b1, a11, b2, a21, b3, a31);
+	out->v[ 2] = xint_dot4(b0, a02, b1, a12, b2, a22, b3, a32);
+	out->v[ 3] = xint_dot4(b0, a03, b1, a13, b2, a23, b3, a33);
 	b0 = b->v[ 4];
 	b1 = b->v[ 5];
 	b2 = b->v[ 6];
 	b3 = b->v[ 7];
-	out->v[ 4] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a00), xint_mul(b1, a10)), xint_mul(b2, a20)), xint_mul(b3, a30));
-	out->v[ 5] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a01), xint_mul(b1, a11)), xint_mul(b2, a21)), xint_mul(b3, a31));
-	out->v[ 6] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a02), xint_mul(b1, a12)), xint_mul(b2, a22)), xint_mul(b3, a32));
-	out->v[ 7] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a03), xint_mul(b1, a13)), xint_mul(b2, a23)), xint_mul(b3, a33));
+	out->v[ 4] = xint_dot4(b0, a00, b1, a10, b2, a20, b3, a30);
+	out->v[ 5] = xint_dot4(b0, a01, b1, a11, b2, a21, b3, a31);
+	out->v[ 6] = xint_dot4(b0, a02, b1, a12, b2, a22, b3, a32);
+	out->v[ 7] = xint_dot4(b0, a03, b1, a13, b2, a23, b3, a33);
 	b0 = b->v[ 8];
 	b1 = b->v[ 9];
 	b2 = b->v[10];
 	b3 = b->v[11];
-	out->v[ 8] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a00), xint_mul(b1, a10)), xint_mul(b2, a20)), xint_mul(b3, a30));
-	out->v[ 9] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a01), xint_mul(b1, a11)), xint_mul(b2, a21)), xint_mul(b3, a31));
-	out->v[10] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a02), xint_mul(b1, a12)), xint_mul(b2, a22)), xint_mul(b3, a32));
-	out->v[11] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a03), xint_mul(b1, a13)), xint_mul(b2, a23)), xint_mul(b3, a33));
+	out->v[ 8] = xint_dot4(b0, a00, b1, a10, b2, a20, b3, a30);
+	out->v[ 9] = xint_dot4(b0, a01, b1, a11, b2, a21, b3, a31);
+	out->v[10] = xint_dot4(b0, a02, b1, a12, b2, a22, b3, a32);
+	out->v[11] = xint_dot4(b0, a03, b1, a13, b2, a23, b3, a33);
 	b0 = b->v[12];
 	b1 = b->v[13];
 	b2 = b->v[14];
 	b3 = b->v[15];
-	out->v[12] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a00), xint_mul(b1, a10)), xint_mul(b2, a20)), xint_mul(b3, a30));
-	out->v[13] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a01), xint_mul(b1, a11)), xint_mul(b2, a21)), xint_mul(b3, a31));
-	out->v[14] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a02), xint_mul(b1, a12)), xint_mul(b2, a22)), xint_mul(b3, a32));
-	out->v[15] = xint_add(xint_add(xint_add(
-		xint_mul(b0, a03), xint_mul(b1, a13)), xint_mul(b2, a23)), xint_mul(b3, a33));
+	out->v[12] = xint_dot4(b0, a00, b1, a10, b2, a20, b3, a30);
+	out->v[13] = xint_dot4(b0, a01, b1, a11, b2, a21, b3, a31);
+	out->v[14] = xint_dot4(b0, a02, b1, a12, b2, a22, b3, a32);
+	out->v[15] = xint_dot4(b0, a03, b1, a13, b2, a23, b3, a33);
 	return out;
 }
 
-xmat4 *xmat4_orthogonal(xmat4 *out, xint W, xint H, xint N, xint F){
+NVQM_API xmat4 *xmat4_orthogonal(xmat4 *out, xint W, xint H, xint N, xint F){
 	xint nf = xint_div(XINT1, xint_sub(N, F));
 	out->v[ 0] = xint_div(XINT(2), W);
 	out->v[ 1] = 0;
@@ -1841,7 +4104,7 @@ xmat4 *xmat4_orthogonal(xmat4 *out, xint W, xint H, xint N, xint F){
 	return out;
 }
 
-xmat4 *xmat4_perspective(xmat4 *out, xang fov, xint W, xint H, xint N, xint F){
+NVQM_API xmat4 *xmat4_perspective(xmat4 *out, xang fov, xint W, xint H, xint N, xint F){
 	xint
 		f  = xint_div(XINT1, xint_tan(fov >> 1)),
 		nf = xint_div(XINT1, xint_sub(N, F));
@@ -1864,7 +4127,7 @@ xmat4 *xmat4_perspective(xmat4 *out, xang fov, xint W, xint H, xint N, xint F){
 	return out;
 }
 
-xmat4 *xmat4_quat(xmat4 *out, xquat a){
+NVQM_API xmat4 *xmat4_quat(xmat4 *out, xquat a){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax << 1,
 		ay2 = ay << 1,
@@ -1897,7 +4160,7 @@ xmat4 *xmat4_quat(xmat4 *out, xquat a){
 	return out;
 }
 
-xmat4 *xmat4_rotate(xmat4 *out, xmat4 *a, xvec3 axis, xang ang){
+NVQM_API xmat4 *xmat4_rotate(xmat4 *out, xmat4 *a, xvec3 axis, xang ang){
 	xint
 		x = axis.v[0], y = axis.v[1], z = axis.v[2],
 		a00 = a->v[0], a01 = a->v[1], a02 = a->v[ 2], a03 = a->v[ 3],
@@ -1935,7 +4198,7 @@ xmat4 *xmat4_rotate(xmat4 *out, xmat4 *a, xvec3 axis, xang ang){
 	return out;
 }
 
-xmat4 *xmat4_rotation(xmat4 *out, xvec3 axis, xang ang){
+NVQM_API xmat4 *xmat4_rotation(xmat4 *out, xvec3 axis, xang ang){
 	xint x = axis.v[0], y = axis.v[1], z = axis.v[2],
 		s = xint_sin(ang), c = xint_cos(ang),
 		t = xint_sub(XINT1, c);
@@ -1958,7 +4221,7 @@ xmat4 *xmat4_rotation(xmat4 *out, xvec3 axis, xang ang){
 	return out;
 }
 
-xmat4 *xmat4_rottrans(xmat4 *out, xquat a, xvec3 b){
+NVQM_API xmat4 *xmat4_rottrans(xmat4 *out, xquat a, xvec3 b){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax << 1,
 		ay2 = ay << 1,
@@ -1991,7 +4254,7 @@ xmat4 *xmat4_rottrans(xmat4 *out, xquat a, xvec3 b){
 	return out;
 }
 
-xmat4 *xmat4_rottransorigin(xmat4 *out, xquat a, xvec3 b, xvec3 origin){
+NVQM_API xmat4 *xmat4_rottransorigin(xmat4 *out, xquat a, xvec3 b, xvec3 origin){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3],
 		ax2 = ax << 1,
 		ay2 = ay << 1,
@@ -2028,7 +4291,7 @@ xmat4 *xmat4_rottransorigin(xmat4 *out, xquat a, xvec3 b, xvec3 origin){
 	return out;
 }
 
-xmat4 *xmat4_scale(xmat4 *out, xmat4 *a, xvec3 b){
+NVQM_API xmat4 *xmat4_scale(xmat4 *out, xmat4 *a, xvec3 b){
 	xint bx = b.v[0], by = b.v[1], bz = b.v[2];
 	out->v[ 0] = xint_mul(a->v[ 0], bx);
 	out->v[ 1] = xint_mul(a->v[ 1], bx);
@@ -2049,7 +4312,7 @@ xmat4 *xmat4_scale(xmat4 *out, xmat4 *a, xvec3 b){
 	return out;
 }
 
-xmat4 *xmat4_scaling(xmat4 *out, xvec3 a){
+NVQM_API xmat4 *xmat4_scaling(xmat4 *out, xvec3 a){
 	out->v[ 0] = a.v[0]; out->v[ 1] =      0; out->v[ 2] =      0; out->v[ 3] =     0;
 	out->v[ 4] =      0; out->v[ 5] = a.v[1]; out->v[ 6] =      0; out->v[ 7] =     0;
 	out->v[ 8] =      0; out->v[ 9] =      0; out->v[10] = a.v[2]; out->v[11] =     0;
@@ -2057,7 +4320,7 @@ xmat4 *xmat4_scaling(xmat4 *out, xvec3 a){
 	return out;
 }
 
-xmat4 *xmat4_sub(xmat4 *out, xmat4 *a, xmat4 *b){
+NVQM_API xmat4 *xmat4_sub(xmat4 *out, xmat4 *a, xmat4 *b){
 	out->v[ 0] = xint_sub(a->v[ 0], b->v[ 0]);
 	out->v[ 1] = xint_sub(a->v[ 1], b->v[ 1]);
 	out->v[ 2] = xint_sub(a->v[ 2], b->v[ 2]);
@@ -2077,7 +4340,7 @@ xmat4 *xmat4_sub(xmat4 *out, xmat4 *a, xmat4 *b){
 	return out;
 }
 
-xmat4 *xmat4_translate(xmat4 *out, xmat4 *a, xvec3 b){
+NVQM_API xmat4 *xmat4_translate(xmat4 *out, xmat4 *a, xvec3 b){
 	xint bx = b.v[0], by = b.v[1], bz = b.v[2];
 	if (out == a){
 		out->v[12] = xint_add(xint_add(xint_add(
@@ -2118,7 +4381,7 @@ xmat4 *xmat4_translate(xmat4 *out, xmat4 *a, xvec3 b){
 	return out;
 }
 
-xmat4 *xmat4_translation(xmat4 *out, xvec3 a){
+NVQM_API xmat4 *xmat4_translation(xmat4 *out, xvec3 a){
 	out->v[ 0] = XINT1; out->v[ 1] =     0; out->v[ 2] =     0; out->v[ 3] =    0;
 	out->v[ 4] =     0; out->v[ 5] = XINT1; out->v[ 6] =     0; out->v[ 7] =    0;
 	out->v[ 8] =     0; out->v[ 9] =     0; out->v[10] = XINT1; out->v[11] =    0;
@@ -2126,7 +4389,7 @@ xmat4 *xmat4_translation(xmat4 *out, xvec3 a){
 	return out;
 }
 
-xmat4 *xmat4_transpose(xmat4 *out, xmat4 *a){
+NVQM_API xmat4 *xmat4_transpose(xmat4 *out, xmat4 *a){
 	if (out == a){
 		xint
 			a01 = a->v[1], a02 = a->v[2], a03 = a->v[ 3],
@@ -2154,8 +4417,719 @@ xmat4 *xmat4_transpose(xmat4 *out, xmat4 *a){
 	return out;
 }
 
+/*
+ * xarrays
+ * the kernels use the same operations in the same order as the inline functions, so the results
+ * are identical
+ */
+
+static size_t xint_scale_c(xint *out, xint *a, xint s, size_t n){
+	for (size_t i = 0; i < n; i++)
+		out[i] = xint_mul(a[i], s);
+	return n;
+}
+
+static size_t xvec3_applyquat_c(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	for (size_t i = 0; i < n; i++)
+		out[i] = xvec3_applyquat(a[i], *b);
+	return n;
+}
+
+static size_t xvec3_applyquatv_c(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	for (size_t i = 0; i < n; i++)
+		out[i] = xvec3_applyquat(a[i], b[i]);
+	return n;
+}
+
+static size_t xquat_mul_c(xquat *out, xquat *a, xquat *b, size_t n){
+	for (size_t i = 0; i < n; i++)
+		out[i] = xquat_mul(a[i], b[i]);
+	return n;
+}
+
+#ifdef NVQM_DISPATCH
+/* the SSE4.1 and AVX2 kernels return how many elements they finished, and the C code does the rest
+ * xint_mul multiplies the even and odd lanes into 64 bits separately (pmuldq), then blends bits
+ * 16..47 of each product back into place
+ */
+
+static inline void xsse_load3x4(xvec3 *p, __m128i *x, __m128i *y, __m128i *z){
+	__m128 fx, fy, fz;
+	sse_load3x4((float *)p->v, &fx, &fy, &fz);
+	*x = _mm_castps_si128(fx);
+	*y = _mm_castps_si128(fy);
+	*z = _mm_castps_si128(fz);
+}
+
+static inline void xsse_store3x4(xvec3 *p, __m128i x, __m128i y, __m128i z){
+	sse_store3x4((float *)p->v, _mm_castsi128_ps(x), _mm_castsi128_ps(y), _mm_castsi128_ps(z));
+}
+
+static inline void xsse_load4x4(xquat *p, __m128i *x, __m128i *y, __m128i *z, __m128i *w){
+	__m128
+		r0 = _mm_loadu_ps((float *)p[0].v),
+		r1 = _mm_loadu_ps((float *)p[1].v),
+		r2 = _mm_loadu_ps((float *)p[2].v),
+		r3 = _mm_loadu_ps((float *)p[3].v);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	*x = _mm_castps_si128(r0);
+	*y = _mm_castps_si128(r1);
+	*z = _mm_castps_si128(r2);
+	*w = _mm_castps_si128(r3);
+}
+
+static inline void xsse_store4x4(xquat *p, __m128i x, __m128i y, __m128i z, __m128i w){
+	__m128
+		r0 = _mm_castsi128_ps(x),
+		r1 = _mm_castsi128_ps(y),
+		r2 = _mm_castsi128_ps(z),
+		r3 = _mm_castsi128_ps(w);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps((float *)p[0].v, r0);
+	_mm_storeu_ps((float *)p[1].v, r1);
+	_mm_storeu_ps((float *)p[2].v, r2);
+	_mm_storeu_ps((float *)p[3].v, r3);
+}
+
+NVQM_TARGET("sse4.1")
+static inline __m128i xint_mul_sse41(__m128i a, __m128i b){
+	__m128i
+		ev = _mm_srli_epi64(_mm_mul_epi32(a, b), 16),
+		od = _mm_slli_epi64(_mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)), 16);
+	return _mm_blend_epi16(ev, od, 0xCC);
+}
+
+NVQM_TARGET("sse4.1")
+static inline void xapplyquat_sse41(__m128i *x, __m128i *y, __m128i *z,
+	__m128i bx, __m128i by, __m128i bz, __m128i bw){
+	#define M(a, b) xint_mul_sse41(a, b)
+	__m128i
+		ax = *x, ay = *y, az = *z,
+		zero = _mm_setzero_si128(),
+		nx = _mm_sub_epi32(zero, bx), ny = _mm_sub_epi32(zero, by), nz = _mm_sub_epi32(zero, bz),
+		ix = _mm_sub_epi32(_mm_add_epi32(M(bw, ax), M(by, az)), M(bz, ay)),
+		iy = _mm_sub_epi32(_mm_add_epi32(M(bw, ay), M(bz, ax)), M(bx, az)),
+		iz = _mm_sub_epi32(_mm_add_epi32(M(bw, az), M(bx, ay)), M(by, ax)),
+		iw = _mm_sub_epi32(_mm_sub_epi32(M(nx, ax), M(by, ay)), M(bz, az));
+	*x = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(M(ix, bw), M(iw, nx)), M(iy, nz)), M(iz, ny));
+	*y = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(M(iy, bw), M(iw, ny)), M(iz, nx)), M(ix, nz));
+	*z = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(M(iz, bw), M(iw, nz)), M(ix, ny)), M(iy, nx));
+	#undef M
+}
+
+NVQM_TARGET("sse4.1")
+static size_t xint_scale_sse41(xint *out, xint *a, xint s, size_t n){
+	__m128i c = _mm_set1_epi32(s);
+	size_t i = 0;
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4)
+		_mm_storeu_si128((__m128i *)&out[i],
+			xint_mul_sse41(_mm_loadu_si128((__m128i *)&a[i]), c));
+	return i;
+}
+
+NVQM_TARGET("sse4.1")
+static size_t xvec3_applyquat_sse41(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	__m128i
+		bx = _mm_set1_epi32(b->v[0]), by = _mm_set1_epi32(b->v[1]),
+		bz = _mm_set1_epi32(b->v[2]), bw = _mm_set1_epi32(b->v[3]);
+	size_t i = 0;
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128i x, y, z;
+		xsse_load3x4(&a[i], &x, &y, &z);
+		xapplyquat_sse41(&x, &y, &z, bx, by, bz, bw);
+		xsse_store3x4(&out[i], x, y, z);
+	}
+	return i;
+}
+
+NVQM_TARGET("sse4.1")
+static size_t xvec3_applyquatv_sse41(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	size_t i = 0;
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128i x, y, z, bx, by, bz, bw;
+		xsse_load3x4(&a[i], &x, &y, &z);
+		xsse_load4x4(&b[i], &bx, &by, &bz, &bw);
+		xapplyquat_sse41(&x, &y, &z, bx, by, bz, bw);
+		xsse_store3x4(&out[i], x, y, z);
+	}
+	return i;
+}
+
+NVQM_TARGET("sse4.1")
+static size_t xquat_mul_sse41(xquat *out, xquat *a, xquat *b, size_t n){
+	#define M(a, b) xint_mul_sse41(a, b)
+	size_t i = 0;
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128i ax, ay, az, aw, bx, by, bz, bw;
+		xsse_load4x4(&a[i], &ax, &ay, &az, &aw);
+		xsse_load4x4(&b[i], &bx, &by, &bz, &bw);
+		xsse_store4x4(&out[i],
+			_mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(M(ax, bw), M(aw, bx)), M(ay, bz)), M(az, by)),
+			_mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(M(ay, bw), M(aw, by)), M(az, bx)), M(ax, bz)),
+			_mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(M(az, bw), M(aw, bz)), M(ax, by)), M(ay, bx)),
+			_mm_sub_epi32(_mm_sub_epi32(_mm_sub_epi32(M(aw, bw), M(ax, bx)), M(ay, by)), M(az, bz)));
+	}
+	#undef M
+	return i;
+}
+
+/* the AVX2 kernels do 8 elements at a time, transposed as two halves of 4 */
+
+NVQM_TARGET("avx2")
+static inline __m256i xavx2_join(__m128i lo, __m128i hi){
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+NVQM_TARGET("avx2")
+static inline void xavx2_load3x8(xvec3 *p, __m256i *x, __m256i *y, __m256i *z){
+	__m128i x0, y0, z0, x1, y1, z1;
+	xsse_load3x4(&p[0], &x0, &y0, &z0);
+	xsse_load3x4(&p[4], &x1, &y1, &z1);
+	*x = xavx2_join(x0, x1);
+	*y = xavx2_join(y0, y1);
+	*z = xavx2_join(z0, z1);
+}
+
+NVQM_TARGET("avx2")
+static inline void xavx2_store3x8(xvec3 *p, __m256i x, __m256i y, __m256i z){
+	xsse_store3x4(&p[0], _mm256_castsi256_si128(x), _mm256_castsi256_si128(y),
+		_mm256_castsi256_si128(z));
+	xsse_store3x4(&p[4], _mm256_extracti128_si256(x, 1), _mm256_extracti128_si256(y, 1),
+		_mm256_extracti128_si256(z, 1));
+}
+
+NVQM_TARGET("avx2")
+static inline void xavx2_load4x8(xquat *p, __m256i *x, __m256i *y, __m256i *z, __m256i *w){
+	__m128i x0, y0, z0, w0, x1, y1, z1, w1;
+	xsse_load4x4(&p[0], &x0, &y0, &z0, &w0);
+	xsse_load4x4(&p[4], &x1, &y1, &z1, &w1);
+	*x = xavx2_join(x0, x1);
+	*y = xavx2_join(y0, y1);
+	*z = xavx2_join(z0, z1);
+	*w = xavx2_join(w0, w1);
+}
+
+NVQM_TARGET("avx2")
+static inline void xavx2_store4x8(xquat *p, __m256i x, __m256i y, __m256i z, __m256i w){
+	xsse_store4x4(&p[0], _mm256_castsi256_si128(x), _mm256_castsi256_si128(y),
+		_mm256_castsi256_si128(z), _mm256_castsi256_si128(w));
+	xsse_store4x4(&p[4], _mm256_extracti128_si256(x, 1), _mm256_extracti128_si256(y, 1),
+		_mm256_extracti128_si256(z, 1), _mm256_extracti128_si256(w, 1));
+}
+
+NVQM_TARGET("avx2")
+static inline __m256i xint_mul_avx2(__m256i a, __m256i b){
+	__m256i
+		ev = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 16),
+		od = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(a, 32),
+			_mm256_srli_epi64(b, 32)), 16);
+	return _mm256_blend_epi32(ev, od, 0xAA);
+}
+
+NVQM_TARGET("avx2")
+static inline void xapplyquat_avx2(__m256i *x, __m256i *y, __m256i *z,
+	__m256i bx, __m256i by, __m256i bz, __m256i bw){
+	#define M(a, b) xint_mul_avx2(a, b)
+	__m256i
+		ax = *x, ay = *y, az = *z,
+		zero = _mm256_setzero_si256(),
+		nx = _mm256_sub_epi32(zero, bx), ny = _mm256_sub_epi32(zero, by),
+		nz = _mm256_sub_epi32(zero, bz),
+		ix = _mm256_sub_epi32(_mm256_add_epi32(M(bw, ax), M(by, az)), M(bz, ay)),
+		iy = _mm256_sub_epi32(_mm256_add_epi32(M(bw, ay), M(bz, ax)), M(bx, az)),
+		iz = _mm256_sub_epi32(_mm256_add_epi32(M(bw, az), M(bx, ay)), M(by, ax)),
+		iw = _mm256_sub_epi32(_mm256_sub_epi32(M(nx, ax), M(by, ay)), M(bz, az));
+	*x = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+		M(ix, bw), M(iw, nx)), M(iy, nz)), M(iz, ny));
+	*y = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+		M(iy, bw), M(iw, ny)), M(iz, nx)), M(ix, nz));
+	*z = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+		M(iz, bw), M(iw, nz)), M(ix, ny)), M(iy, nx));
+	#undef M
+}
+
+NVQM_TARGET("avx2")
+static size_t xint_scale_avx2(xint *out, xint *a, xint s, size_t n){
+	__m256i c = _mm256_set1_epi32(s);
+	size_t i = 0;
+	for (size_t n8 = n & ~(size_t)7; i < n8; i += 8)
+		_mm256_storeu_si256((__m256i *)&out[i],
+			xint_mul_avx2(_mm256_loadu_si256((__m256i *)&a[i]), c));
+	return i;
+}
+
+NVQM_TARGET("avx2")
+static size_t xvec3_applyquat_avx2(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	__m256i
+		bx = _mm256_set1_epi32(b->v[0]), by = _mm256_set1_epi32(b->v[1]),
+		bz = _mm256_set1_epi32(b->v[2]), bw = _mm256_set1_epi32(b->v[3]);
+	size_t i = 0;
+	for (size_t n8 = n & ~(size_t)7; i < n8; i += 8){
+		__m256i x, y, z;
+		xavx2_load3x8(&a[i], &x, &y, &z);
+		xapplyquat_avx2(&x, &y, &z, bx, by, bz, bw);
+		xavx2_store3x8(&out[i], x, y, z);
+	}
+	return i;
+}
+
+NVQM_TARGET("avx2")
+static size_t xvec3_applyquatv_avx2(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	size_t i = 0;
+	for (size_t n8 = n & ~(size_t)7; i < n8; i += 8){
+		__m256i x, y, z, bx, by, bz, bw;
+		xavx2_load3x8(&a[i], &x, &y, &z);
+		xavx2_load4x8(&b[i], &bx, &by, &bz, &bw);
+		xapplyquat_avx2(&x, &y, &z, bx, by, bz, bw);
+		xavx2_store3x8(&out[i], x, y, z);
+	}
+	return i;
+}
+
+NVQM_TARGET("avx2")
+static size_t xquat_mul_avx2(xquat *out, xquat *a, xquat *b, size_t n){
+	#define M(a, b) xint_mul_avx2(a, b)
+	size_t i = 0;
+	for (size_t n8 = n & ~(size_t)7; i < n8; i += 8){
+		__m256i ax, ay, az, aw, bx, by, bz, bw;
+		xavx2_load4x8(&a[i], &ax, &ay, &az, &aw);
+		xavx2_load4x8(&b[i], &bx, &by, &bz, &bw);
+		xavx2_store4x8(&out[i],
+			_mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+				M(ax, bw), M(aw, bx)), M(ay, bz)), M(az, by)),
+			_mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+				M(ay, bw), M(aw, by)), M(az, bx)), M(ax, bz)),
+			_mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(
+				M(az, bw), M(aw, bz)), M(ax, by)), M(ay, bx)),
+			_mm256_sub_epi32(_mm256_sub_epi32(_mm256_sub_epi32(
+				M(aw, bw), M(ax, bx)), M(ay, by)), M(az, bz)));
+	}
+	#undef M
+	return i;
+}
+
+static size_t xint_scale_init(xint *out, xint *a, xint s, size_t n);
+static size_t (*xint_scale_f)(xint *out, xint *a, xint s, size_t n) = xint_scale_init;
+
+static size_t xint_scale_init(xint *out, xint *a, xint s, size_t n){
+	int f = cpu_features();
+	if (f & CPU_AVX2)
+		xint_scale_f = xint_scale_avx2;
+	else if (f & CPU_SSE41)
+		xint_scale_f = xint_scale_sse41;
+	else
+		xint_scale_f = xint_scale_c;
+	return xint_scale_f(out, a, s, n);
+}
+
+static size_t xvec3_applyquat_init(xvec3 *out, xvec3 *a, xquat *b, size_t n);
+static size_t (*xvec3_applyquat_f)(xvec3 *out, xvec3 *a, xquat *b, size_t n) =
+	xvec3_applyquat_init;
+
+static size_t xvec3_applyquat_init(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	int f = cpu_features();
+	if (f & CPU_AVX2)
+		xvec3_applyquat_f = xvec3_applyquat_avx2;
+	else if (f & CPU_SSE41)
+		xvec3_applyquat_f = xvec3_applyquat_sse41;
+	else
+		xvec3_applyquat_f = xvec3_applyquat_c;
+	return xvec3_applyquat_f(out, a, b, n);
+}
+
+static size_t xvec3_applyquatv_init(xvec3 *out, xvec3 *a, xquat *b, size_t n);
+static size_t (*xvec3_applyquatv_f)(xvec3 *out, xvec3 *a, xquat *b, size_t n) =
+	xvec3_applyquatv_init;
+
+static size_t xvec3_applyquatv_init(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	int f = cpu_features();
+	if (f & CPU_AVX2)
+		xvec3_applyquatv_f = xvec3_applyquatv_avx2;
+	else if (f & CPU_SSE41)
+		xvec3_applyquatv_f = xvec3_applyquatv_sse41;
+	else
+		xvec3_applyquatv_f = xvec3_applyquatv_c;
+	return xvec3_applyquatv_f(out, a, b, n);
+}
+
+static size_t xquat_mul_init(xquat *out, xquat *a, xquat *b, size_t n);
+static size_t (*xquat_mul_f)(xquat *out, xquat *a, xquat *b, size_t n) = xquat_mul_init;
+
+static size_t xquat_mul_init(xquat *out, xquat *a, xquat *b, size_t n){
+	int f = cpu_features();
+	if (f & CPU_AVX2)
+		xquat_mul_f = xquat_mul_avx2;
+	else if (f & CPU_SSE41)
+		xquat_mul_f = xquat_mul_sse41;
+	else
+		xquat_mul_f = xquat_mul_c;
+	return xquat_mul_f(out, a, b, n);
+}
+#endif /* NVQM_DISPATCH */
+
+NVQM_API xint *xint_div_array(xint *out, xint *a, xint b, size_t n){
+	xrecip r = xrecip_new(b);
+	size_t i = 0;
+#ifdef NVQM_SSE2
+	/* xint_div_by on 4 lanes, where the even and odd lanes each take two 32x32->64 bit multiplies
+	 * (pmuludq) */
+	__m128i
+		mlo  = _mm_set1_epi32((int)r.mlo),
+		mhi  = _mm_set1_epi32((int)r.mhi),
+		sh   = _mm_cvtsi32_si128(r.shift),
+		sb   = _mm_set1_epi32((int)r.sign),
+		even = _mm_set1_epi64x(0xFFFFFFFF);
+	for (size_t n4 = n & ~(size_t)3; i < n4; i += 4){
+		__m128i
+			v  = _mm_loadu_si128((__m128i *)&a[i]),
+			sa = _mm_srai_epi32(v, 31),
+			x  = _mm_sub_epi32(_mm_xor_si128(v, sa), sa),
+			xo = _mm_srli_epi64(x, 32),
+			qe = _mm_add_epi64(_mm_mul_epu32(x, mhi), _mm_srli_epi64(_mm_mul_epu32(x, mlo), 32)),
+			qo = _mm_add_epi64(_mm_mul_epu32(xo, mhi), _mm_srli_epi64(_mm_mul_epu32(xo, mlo), 32)),
+			q  = _mm_or_si128(_mm_and_si128(_mm_srl_epi64(qe, sh), even),
+				_mm_slli_epi64(_mm_srl_epi64(qo, sh), 32)),
+			s  = _mm_xor_si128(sa, sb);
+		_mm_storeu_si128((__m128i *)&out[i], _mm_sub_epi32(_mm_xor_si128(q, s), s));
+	}
+#endif
+	for (; i < n; i++)
+		out[i] = xint_div_by(a[i], &r);
+	return out;
+}
+
+NVQM_API xvec3 *xvec3_add_array(xvec3 *out, xvec3 *a, xvec3 *b, size_t n){
+	/* wrapping adds are simple enough for the compiler to vectorize on its own */
+	xint *o = (xint *)out, *p = (xint *)a, *q = (xint *)b;
+	for (size_t i = 0; i < n * 3; i++)
+		o[i] = xint_add(p[i], q[i]);
+	return out;
+}
+
+NVQM_API xvec3 *xvec3_applyquat_array(xvec3 *out, xvec3 *a, xquat b, size_t n){
+	size_t i = 0;
+#ifdef NVQM_DISPATCH
+	i = xvec3_applyquat_f(out, a, &b, n);
+#endif
+	xvec3_applyquat_c(out + i, a + i, &b, n - i);
+	return out;
+}
+
+NVQM_API xvec3 *xvec3_applyquatv_array(xvec3 *out, xvec3 *a, xquat *b, size_t n){
+	size_t i = 0;
+#ifdef NVQM_DISPATCH
+	i = xvec3_applyquatv_f(out, a, b, n);
+#endif
+	xvec3_applyquatv_c(out + i, a + i, b + i, n - i);
+	return out;
+}
+
+NVQM_API xvec3 *xvec3_divs_array(xvec3 *out, xvec3 *a, xint s, size_t n){
+	xint_div_array((xint *)out, (xint *)a, s, n * 3);
+	return out;
+}
+
+NVQM_API xvec3 *xvec3_scale_array(xvec3 *out, xvec3 *a, xint s, size_t n){
+	/* each component is scaled the same way, so the vectors are treated as one long xint array */
+	size_t i = 0;
+	n *= 3;
+#ifdef NVQM_DISPATCH
+	i = xint_scale_f((xint *)out, (xint *)a, s, n);
+#endif
+	xint_scale_c((xint *)out + i, (xint *)a + i, s, n - i);
+	return out;
+}
+
+NVQM_API xvec3 *xvec3_sub_array(xvec3 *out, xvec3 *a, xvec3 *b, size_t n){
+	xint *o = (xint *)out, *p = (xint *)a, *q = (xint *)b;
+	for (size_t i = 0; i < n * 3; i++)
+		o[i] = xint_sub(p[i], q[i]);
+	return out;
+}
+
+NVQM_API xquat *xquat_mul_array(xquat *out, xquat *a, xquat *b, size_t n){
+	size_t i = 0;
+#ifdef NVQM_DISPATCH
+	i = xquat_mul_f(out, a, b, n);
+#endif
+	xquat_mul_c(out + i, a + i, b + i, n - i);
+	return out;
+}
+
+#ifdef NVQM_QUARTER_LUT
+/* the first quadrant of sin and tan, packed with corrections that reproduce the full tables below
+ * bit for bit (see xint_sin__at and xint_tan__at in nvqm.h) */
+NVQM_LUT_DATA xint xint_sin__qlut[XANG__LUT / 4 + 1] = {
+	0x00AA0000, 0x00AA0065, 0x00AA00C9, 0x00AA012E, 0x00AA0192, 0x00AA01F7, 0x00AA025B, 0x00AA02C0,
+	0x00AA0324, 0x00AA0389, 0x00AA03ED, 0x00AA0452, 0x00AA04B6, 0x00AA051B, 0x00AA057F, 0x00AA05E4,
+	0x00AA0648, 0x00AA06AD, 0x00AA0711, 0x00AA0776, 0x00AA07DA, 0x00AA083F, 0x00AA08A3, 0x00AA0908,
+	0x00AA096C, 0x00AA09D1, 0x00AA0A35, 0x00AA0A9A, 0x00AA0AFE, 0x00AA0B62, 0x00AA0BC7, 0x00AA0C2B,
+	0x00AA0C90, 0x00AA0CF4, 0x00A20D59, 0x00AA0DBD, 0x00AA0E21, 0x00AA0E86, 0x00AA0EEA, 0x00AA0F4E,
+	0x00AA0FB3, 0x00AA1017, 0x00AA107B, 0x00AA10E0, 0x00AA1144, 0x00AA11A8, 0x00AA120D, 0x00AA1271,
+	0x00AA12D5, 0x00AA1339, 0x00AA139E, 0x00AA1402, 0x00AA1466, 0x00AA14CA, 0x00AA152E, 0x00AA1593,
+	0x00AA15F7, 0x00AA165B, 0x00AA16BF, 0x00AA1723, 0x00AA1787, 0x00AA17EB, 0x00AA1850, 0x00AA18B4,
+	0x00AA1918, 0x00AA197C, 0x00AA19E0, 0x00AA1A44, 0x00AA1AA8, 0x00AA1B0C, 0x00AA1B70, 0x00AA1BD4,
+	0x00AA1C38, 0x00AA1C9B, 0x00AA1CFF, 0x00AA1D63, 0x00AA1DC7, 0x00AA1E2B, 0x00AA1E8F, 0x00AA1EF3,
+	0x00AA1F56, 0x00AA1FBA, 0x00AA201E, 0x00AA2082, 0x00AA20E5, 0x00AA2149, 0x00AA21AD, 0x00AA2210,
+	0x00AA2274, 0x00AA22D7, 0x00AA233B, 0x00AA239F, 0x00AA2402, 0x00AA2466, 0x00AA24C9, 0x00AA252D,
+	0x00AA2590, 0x00AA25F4, 0x00AA2657, 0x00AA26BA, 0x00AA271E, 0x00AA2781, 0x00AA27E4, 0x00AA2848,
+	0x00AA28AB, 0x00AA290E, 0x00AA2971, 0x00AA29D5, 0x00AA2A38, 0x00AA2A9B, 0x00AA2AFE, 0x00AA2B61,
+	0x00AA2BC4, 0x00AA2C27, 0x00AA2C8A, 0x00AA2CED, 0x00AA2D50, 0x00AA2DB3, 0x00AA2E16, 0x00AA2E79,
+	0x00AA2EDC, 0x00AA2F3F, 0x00AA2FA1, 0x00AA3004, 0x00AA3067, 0x00AA30CA, 0x00AA312C, 0x00AA318F,
+	0x00AA31F1, 0x00AA3254, 0x00AA32B7, 0x00AA3319, 0x00AA337C, 0x00AA33DE, 0x00AA3440, 0x00AA34A3,
+	0x00AA3505, 0x00AA3568, 0x00AA35CA, 0x00AA362C, 0x00AA368E, 0x00AA36F1, 0x00AA3753, 0x00AA37B5,
+	0x00AA3817, 0x00AA3879, 0x00AA38DB, 0x00AA393D, 0x00AA399F, 0x00AA3A01, 0x00AA3A63, 0x00AA3AC5,
+	0x00AA3B27, 0x00AA3B88, 0x00AA3BEA, 0x00AA3C4C, 0x00AA3CAE, 0x00AA3D0F, 0x00AA3D71, 0x00AA3DD2,
+	0x00AA3E34, 0x00AA3E95, 0x00AA3EF7, 0x00AA3F58, 0x00AA3FBA, 0x00AA401B, 0x00AA407C, 0x00AA40DE,
+	0x00AA413F, 0x00AA41A0, 0x00AA4201, 0x00AA4262, 0x00AA42C3, 0x00AA4324, 0x00AA4385, 0x00AA43E6,
+	0x00AA4447, 0x00AA44A8, 0x00AA4509, 0x00AA456A, 0x002A45CB, 0x00AA462B, 0x00AA468C, 0x00CA46EC,
+	0x00AA474D, 0x00AA47AE, 0x00AA480E, 0x00AA486F, 0x00AA48CF, 0x00AA492F, 0x00AA4990, 0x00AA49F0,
+	0x00AA4A50, 0x00AA4AB0, 0x00AA4B10, 0x00224B71, 0x00AA4BD1, 0x00AA4C31, 0x00AA4C90, 0x00AA4CF0,
+	0x00AA4D50, 0x00AA4DB0, 0x00AA4E10, 0x00AA4E70, 0x00AA4ECF, 0x00AA4F2F, 0x00AA4F8E, 0x00AA4FEE,
+	0x00AA504D, 0x00AA50AD, 0x00AA510C, 0x00AA516C, 0x00AA51CB, 0x00AA522A, 0x00AA5289, 0x00AA52E8,
+	0x00AA5348, 0x00AA53A7, 0x00AA5406, 0x00CA5464, 0x00AA54C3, 0x00AA5522, 0x00AA5581, 0x00AA55E0,
+	0x00AA563E, 0x00AA569D, 0x00AA56FC, 0x00AA575A, 0x00AA57B9, 0x00AA5817, 0x00AA5875, 0x00AA58D4,
+	0x00AA5932, 0x00AA5990, 0x00AA59EE, 0x00AA5A4C, 0x00AA5AAA, 0x00AA5B08, 0x00AA5B66, 0x00AA5BC4,
+	0x00AA5C22, 0x00AA5C80, 0x00AA5CDE, 0x00AA5D3B, 0x00AA5D99, 0x00AA5DF6, 0x00AA5E54, 0x00AA5EB1,
+	0x00AA5F0F, 0x00AA5F6C, 0x00AA5FC9, 0x00AA6026, 0x00AA6084, 0x00AA60E1, 0x00AA613E, 0x00AA619B,
+	0x00AA61F8, 0x00AA6254, 0x00AA62B1, 0x00AA630E, 0x00AA636B, 0x00AA63C7, 0x00AA6424, 0x00AA6480,
+	0x00AA64DD, 0x00AA6539, 0x00AA6595, 0x00AA65F2, 0x00AA664E, 0x00AA66AA, 0x00AA6706, 0x00AA6762,
+	0x00AA67BE, 0x00AA681A, 0x00AA6876, 0x00AA68D1, 0x00AA692D, 0x00AA6989, 0x00AA69E4, 0x00AA6A40,
+	0x00AA6A9B, 0x00CA6AF6, 0x00AA6B52, 0x00AA6BAD, 0x00AA6C08, 0x00AA6C63, 0x00AA6CBE, 0x00AA6D19,
+	0x00AA6D74, 0x00AA6DCF, 0x00AA6E2A, 0x00AA6E85, 0x00AA6EDF, 0x00AA6F3A, 0x00AA6F94, 0x00AA6FEF,
+	0x00AA7049, 0x00AA70A3, 0x00AA70FE, 0x00AA7158, 0x00AA71B2, 0x00AA720C, 0x00AA7266, 0x00AA72C0,
+	0x00AA731A, 0x00AA7373, 0x00AA73CD, 0x00AA7427, 0x00AA7480, 0x00AA74DA, 0x00AA7533, 0x00AA758D,
+	0x00AA75E6, 0x00AA763F, 0x00AA7698, 0x00AA76F1, 0x00AA774A, 0x00AA77A3, 0x00AA77FC, 0x00AA7855,
+	0x00AA78AD, 0x00AA7906, 0x00AA795F, 0x00AA79B7, 0x00AA7A10, 0x00AA7A68, 0x00AA7AC0, 0x00AA7B18,
+	0x00AA7B70, 0x00AA7BC8, 0x00AA7C20, 0x00AA7C78, 0x00AA7CD0, 0x00AA7D28, 0x00AA7D7F, 0x00AA7DD7,
+	0x00AA7E2F, 0x00AA7E86, 0x00AA7EDD, 0x00AA7F35, 0x00AA7F8C, 0x00AA7FE3, 0x00AA803A, 0x00AA8091,
+	0x00AA80E8, 0x00AA813F, 0x00AA8195, 0x00AA81EC, 0x00AA8243, 0x00AA8299, 0x00AA82F0, 0x00AA8346,
+	0x00AA839C, 0x00AA83F2, 0x00AA8449, 0x00AA849F, 0x00AA84F5, 0x00AA854A, 0x00AA85A0, 0x00AA85F6,
+	0x00AA864C, 0x00AA86A1, 0x00AA86F7, 0x00AA874C, 0x00AA87A1, 0x00AA87F6, 0x00AA884C, 0x00AA88A1,
+	0x00AA88F6, 0x00AA894A, 0x00AA899F, 0x00AA89F4, 0x00AA8A49, 0x00AA8A9D, 0x00AA8AF2, 0x00AA8B46,
+	0x00AA8B9A, 0x00AA8BEF, 0x00AA8C43, 0x00AA8C97, 0x00AA8CEB, 0x00AA8D3F, 0x00A28D93, 0x00AA8DE6,
+	0x00AA8E3A, 0x00AA8E8D, 0x00AA8EE1, 0x00AA8F34, 0x002A8F88, 0x00AA8FDB, 0x00AA902E, 0x00AA9081,
+	0x00AA90D4, 0x00AA9127, 0x00AA9179, 0x00AA91CC, 0x00AA921F, 0x00AA9271, 0x00AA92C4, 0x00AA9316,
+	0x00AA9368, 0x00AA93BA, 0x00AA940C, 0x00AA945E, 0x00AA94B0, 0x00AA9502, 0x00AA9554, 0x00AA95A5,
+	0x00AA95F7, 0x00AA9648, 0x00AA969A, 0x00AA96EB, 0x00AA973C, 0x00AA978D, 0x00AA97DE, 0x00AA982F,
+	0x00AA9880, 0x00AA98D0, 0x00AA9921, 0x00AA9972, 0x00AA99C2, 0x00AA9A12, 0x00AA9A63, 0x00AA9AB3,
+	0x00AA9B03, 0x00AA9B53, 0x00AA9BA3, 0x00AA9BF2, 0x00AA9C42, 0x00AA9C92, 0x00AA9CE1, 0x00AA9D31,
+	0x00AA9D80, 0x00AA9DCF, 0x00AA9E1E, 0x00AA9E6D, 0x00AA9EBC, 0x00AA9F0B, 0x00AA9F5A, 0x00AA9FA8,
+	0x00AA9FF7, 0x00AAA045, 0x00AAA094, 0x00AAA0E2, 0x00AAA130, 0x00AAA17E, 0x00AAA1CC, 0x00AAA21A,
+	0x00AAA268, 0x00AAA2B5, 0x00AAA303, 0x00AAA350, 0x00AAA39E, 0x00AAA3EB, 0x00AAA438, 0x00AAA485,
+	0x00AAA4D2, 0x00AAA51F, 0x00AAA56C, 0x00AAA5B8, 0x00AAA605, 0x00AAA652, 0x00AAA69E, 0x00AAA6EA,
+	0x00AAA736, 0x00AAA782, 0x00AAA7CE, 0x00AAA81A, 0x00AAA866, 0x00AAA8B2, 0x00AAA8FD, 0x00AAA949,
+	0x00AAA994, 0x00AAA9DF, 0x0022AA2B, 0x00AAAA76, 0x00AAAAC1, 0x00AAAB0B, 0x00AAAB56, 0x00AAABA1,
+	0x00AAABEB, 0x00AAAC36, 0x00AAAC80, 0x00AAACCA, 0x00AAAD14, 0x00AAAD5E, 0x00AAADA8, 0x00AAADF2,
+	0x00AAAE3C, 0x00AAAE85, 0x00AAAECF, 0x00AAAF18, 0x00AAAF62, 0x00AAAFAB, 0x00AAAFF4, 0x00AAB03D,
+	0x00AAB086, 0x00AAB0CE, 0x00AAB117, 0x00AAB160, 0x00AAB1A8, 0x00AAB1F0, 0x00AAB239, 0x00AAB281,
+	0x00AAB2C9, 0x00AAB311, 0x00AAB358, 0x00AAB3A0, 0x00AAB3E8, 0x00AAB42F, 0x00AAB477, 0x00AAB4BE,
+	0x00AAB505, 0x00AAB54C, 0x00AAB593, 0x00AAB5DA, 0x00AAB620, 0x00AAB667, 0x002AB6AE, 0x00AAB6F4,
+	0x00AAB73A, 0x00AAB780, 0x00AAB7C6, 0x00AAB80C, 0x00AAB852, 0x00AAB898, 0x00AAB8DD, 0x00AAB923,
+	0x00AAB968, 0x00AAB9AE, 0x00AAB9F3, 0x00AABA38, 0x00AABA7D, 0x00AABAC1, 0x00AABB06, 0x00AABB4B,
+	0x00AABB8F, 0x00AABBD4, 0x00AABC18, 0x00AABC5C, 0x00AABCA0, 0x00AABCE4, 0x00AABD28, 0x00AABD6B,
+	0x00AABDAF, 0x00AABDF2, 0x00AABE36, 0x00AABE79, 0x00AABEBC, 0x00AABEFF, 0x00AABF42, 0x00AABF85,
+	0x00AABFC7, 0x00AAC00A, 0x00AAC04C, 0x00AAC08F, 0x00AAC0D1, 0x00AAC113, 0x00AAC155, 0x00AAC197,
+	0x00AAC1D8, 0x00AAC21A, 0x00AAC25C, 0x00AAC29D, 0x00AAC2DE, 0x00AAC31F, 0x00AAC360, 0x00AAC3A1,
+	0x00AAC3E2, 0x00AAC423, 0x00AAC463, 0x00AAC4A4, 0x00AAC4E4, 0x00AAC524, 0x00AAC564, 0x00AAC5A4,
+	0x00AAC5E4, 0x00AAC624, 0x00AAC663, 0x00AAC6A3, 0x00AAC6E2, 0x00AAC721, 0x00AAC761, 0x00AAC7A0,
+	0x00AAC7DE, 0x00AAC81D, 0x00AAC85C, 0x00AAC89A, 0x00AAC8D9, 0x00AAC917, 0x00AAC955, 0x00AAC993,
+	0x00AAC9D1, 0x00AACA0F, 0x00AACA4D, 0x00AACA8A, 0x00CACAC7, 0x00AACB05, 0x00AACB42, 0x00AACB7F,
+	0x00AACBBC, 0x00AACBF9, 0x00AACC35, 0x00AACC72, 0x00AACCAE, 0x00AACCEB, 0x00AACD27, 0x00AACD63,
+	0x00AACD9F, 0x00AACDDB, 0x00AACE17, 0x00AACE52, 0x00AACE8E, 0x00AACEC9, 0x00AACF04, 0x00AACF3F,
+	0x00AACF7A, 0x00AACFB5, 0x00AACFF0, 0x00AAD02A, 0x00AAD065, 0x00AAD09F, 0x00AAD0D9, 0x00AAD113,
+	0x00AAD14D, 0x00AAD187, 0x00AAD1C1, 0x00AAD1FA, 0x00AAD234, 0x00AAD26D, 0x00AAD2A6, 0x00AAD2DF,
+	0x00AAD318, 0x00AAD351, 0x00AAD38A, 0x00AAD3C2, 0x00AAD3FB, 0x00AAD433, 0x00AAD46B, 0x00AAD4A3,
+	0x00AAD4DB, 0x00AAD513, 0x00AAD54B, 0x00AAD582, 0x00AAD5BA, 0x00AAD5F1, 0x00AAD628, 0x00AAD65F,
+	0x00AAD696, 0x00AAD6CD, 0x00AAD703, 0x00AAD73A, 0x00AAD770, 0x00AAD7A6, 0x00CAD7DC, 0x00AAD812,
+	0x00AAD848, 0x00AAD87E, 0x00AAD8B4, 0x00AAD8E9, 0x00AAD91E, 0x00AAD954, 0x00AAD989, 0x00AAD9BE,
+	0x00AAD9F2, 0x00AADA27, 0x00AADA5C, 0x00AADA90, 0x00AADAC4, 0x00AADAF8, 0x00AADB2C, 0x00AADB60,
+	0x00AADB94, 0x00AADBC8, 0x00AADBFB, 0x00AADC2F, 0x00AADC62, 0x00AADC95, 0x00AADCC8, 0x00AADCFB,
+	0x00AADD2D, 0x00AADD60, 0x00AADD92, 0x00AADDC5, 0x00AADDF7, 0x00AADE29, 0x00AADE5B, 0x00AADE8C,
+	0x00AADEBE, 0x00AADEF0, 0x00AADF21, 0x00AADF52, 0x00AADF83, 0x00AADFB4, 0x00AADFE5, 0x00AAE016,
+	0x00AAE046, 0x00AAE077, 0x00AAE0A7, 0x00AAE0D7, 0x00AAE107, 0x00AAE137, 0x00AAE167, 0x00AAE196,
+	0x00AAE1C6, 0x00AAE1F5, 0x00AAE224, 0x00AAE253, 0x00AAE282, 0x00AAE2B1, 0x00AAE2DF, 0x00AAE30E,
+	0x00AAE33C, 0x00AAE36B, 0x00AAE399, 0x00AAE3C7, 0x00AAE3F4, 0x00AAE422, 0x00AAE450, 0x00AAE47D,
+	0x00AAE4AA, 0x00AAE4D7, 0x00AAE504, 0x00AAE531, 0x00AAE55E, 0x00AAE58B, 0x00AAE5B7, 0x00AAE5E3,
+	0x00AAE610, 0x00AAE63C, 0x00AAE667, 0x00AAE693, 0x00AAE6BF, 0x00AAE6EA, 0x00AAE716, 0x00AAE741,
+	0x00AAE76C, 0x00AAE797, 0x00AAE7C2, 0x00AAE7EC, 0x00AAE817, 0x00AAE841, 0x00AAE86B, 0x00AAE895,
+	0x00AAE8BF, 0x00AAE8E9, 0x00AAE913, 0x00AAE93C, 0x00AAE966, 0x00AAE98F, 0x00AAE9B8, 0x00AAE9E1,
+	0x00AAEA0A, 0x00AAEA32, 0x00AAEA5B, 0x00AAEA83, 0x00AAEAAB, 0x00AAEAD4, 0x00AAEAFC, 0x00AAEB23,
+	0x00AAEB4B, 0x00AAEB73, 0x00AAEB9A, 0x00AAEBC1, 0x00AAEBE8, 0x00AAEC0F, 0x00AAEC36, 0x00AAEC5D,
+	0x00AAEC83, 0x00AAECAA, 0x00AAECD0, 0x00AAECF6, 0x00AAED1C, 0x00AAED42, 0x00AAED68, 0x00AAED8D,
+	0x00AAEDB3, 0x00AAEDD8, 0x00AAEDFD, 0x00AAEE22, 0x00AAEE47, 0x00AAEE6B, 0x00AAEE90, 0x00AAEEB4,
+	0x00AAEED9, 0x00AAEEFD, 0x00AAEF21, 0x00AAEF45, 0x00AAEF68, 0x00AAEF8C, 0x00AAEFAF, 0x00AAEFD2,
+	0x00AAEFF5, 0x00AAF018, 0x00AAF03B, 0x00AAF05E, 0x00AAF080, 0x00AAF0A3, 0x00AAF0C5, 0x00AAF0E7,
+	0x00AAF109, 0x00AAF12B, 0x00AAF14C, 0x00AAF16E, 0x00AAF18F, 0x00AAF1B1, 0x00AAF1D2, 0x00AAF1F3,
+	0x00AAF213, 0x00AAF234, 0x00AAF254, 0x00AAF275, 0x00AAF295, 0x00AAF2B5, 0x00AAF2D5, 0x00AAF2F5,
+	0x00AAF314, 0x00AAF334, 0x00AAF353, 0x00AAF372, 0x00AAF391, 0x00AAF3B0, 0x00AAF3CF, 0x00AAF3ED,
+	0x00AAF40C, 0x00AAF42A, 0x00AAF448, 0x00AAF466, 0x00AAF484, 0x00AAF4A2, 0x00AAF4BF, 0x00AAF4DD,
+	0x00AAF4FA, 0x00AAF517, 0x00AAF534, 0x00AAF551, 0x00AAF56E, 0x00AAF58A, 0x00AAF5A6, 0x00AAF5C3,
+	0x00AAF5DF, 0x00AAF5FB, 0x00AAF616, 0x00AAF632, 0x00AAF64E, 0x00AAF669, 0x00AAF684, 0x00AAF69F,
+	0x00AAF6BA, 0x00AAF6D5, 0x00AAF6EF, 0x00AAF70A, 0x00AAF724, 0x00AAF73E, 0x00AAF758, 0x00AAF772,
+	0x00AAF78C, 0x00AAF7A5, 0x00AAF7BF, 0x00AAF7D8, 0x00AAF7F1, 0x00AAF80A, 0x00AAF823, 0x00AAF83B,
+	0x00AAF854, 0x00AAF86C, 0x00AAF885, 0x00AAF89D, 0x00AAF8B4, 0x00AAF8CC, 0x00AAF8E4, 0x00AAF8FB,
+	0x00AAF913, 0x00AAF92A, 0x00AAF941, 0x00AAF958, 0x00AAF96E, 0x00AAF985, 0x00AAF99B, 0x00AAF9B2,
+	0x00AAF9C8, 0x00AAF9DE, 0x00AAF9F3, 0x00AAFA09, 0x00AAFA1F, 0x00AAFA34, 0x00AAFA49, 0x00AAFA5E,
+	0x00AAFA73, 0x00AAFA88, 0x00AAFA9C, 0x00AAFAB1, 0x00AAFAC5, 0x00AAFAD9, 0x00AAFAED, 0x00AAFB01,
+	0x00AAFB15, 0x00AAFB28, 0x00AAFB3C, 0x00AAFB4F, 0x00AAFB62, 0x00AAFB75, 0x00AAFB88, 0x00AAFB9A,
+	0x00AAFBAD, 0x00AAFBBF, 0x00AAFBD1, 0x00AAFBE3, 0x00AAFBF5, 0x00AAFC07, 0x00AAFC18, 0x00AAFC2A,
+	0x00AAFC3B, 0x00AAFC4C, 0x00AAFC5D, 0x00AAFC6E, 0x00AAFC7F, 0x00AAFC8F, 0x00AAFCA0, 0x00AAFCB0,
+	0x00AAFCC0, 0x00AAFCD0, 0x00AAFCDF, 0x00AAFCEF, 0x00AAFCFE, 0x00AAFD0E, 0x00AAFD1D, 0x00AAFD2C,
+	0x00AAFD3B, 0x00AAFD49, 0x00AAFD58, 0x00AAFD66, 0x00AAFD74, 0x00AAFD83, 0x00AAFD90, 0x00AAFD9E,
+	0x00AAFDAC, 0x00AAFDB9, 0x00AAFDC7, 0x00AAFDD4, 0x00AAFDE1, 0x00AAFDEE, 0x00AAFDFA, 0x00AAFE07,
+	0x00AAFE13, 0x00AAFE1F, 0x00AAFE2B, 0x00AAFE37, 0x00AAFE43, 0x00AAFE4F, 0x00AAFE5A, 0x00AAFE66,
+	0x00AAFE71, 0x00AAFE7C, 0x00AAFE87, 0x00AAFE91, 0x00AAFE9C, 0x00AAFEA6, 0x00AAFEB0, 0x00AAFEBA,
+	0x00AAFEC4, 0x00AAFECE, 0x00AAFED8, 0x00AAFEE1, 0x00AAFEEB, 0x00AAFEF4, 0x00AAFEFD, 0x00AAFF06,
+	0x00AAFF0E, 0x00AAFF17, 0x00AAFF1F, 0x00AAFF28, 0x00AAFF30, 0x00AAFF38, 0x00AAFF3F, 0x00AAFF47,
+	0x00AAFF4E, 0x00AAFF56, 0x00AAFF5D, 0x00AAFF64, 0x00AAFF6B, 0x00AAFF71, 0x00AAFF78, 0x00AAFF7E,
+	0x00AAFF85, 0x00AAFF8B, 0x00AAFF91, 0x00AAFF96, 0x00AAFF9C, 0x00AAFFA2, 0x00AAFFA7, 0x00AAFFAC,
+	0x00AAFFB1, 0x00AAFFB6, 0x00AAFFBB, 0x00AAFFBF, 0x00AAFFC4, 0x00AAFFC8, 0x00AAFFCC, 0x00AAFFD0,
+	0x00AAFFD4, 0x00AAFFD7, 0x00AAFFDB, 0x00AAFFDE, 0x00AAFFE1, 0x00AAFFE4, 0x00AAFFE7, 0x00AAFFEA,
+	0x00AAFFEC, 0x00AAFFEF, 0x00AAFFF1, 0x00AAFFF3, 0x00AAFFF5, 0x00AAFFF7, 0x00AAFFF8, 0x00AAFFFA,
+	0x00AAFFFB, 0x00AAFFFC, 0x00AAFFFD, 0x00AAFFFE, 0x00AAFFFF, 0x00AAFFFF, 0x00AB0000, 0x00AB0000,
+	0x00AB0000
+};
+
+NVQM_LUT_DATA xint xint_tan__qlut[XANG__LUT / 4 + 1] = {
+	0x40000000, 0x40000065, 0x400000C9, 0x4000012E, 0x40000192, 0x400001F7, 0x4000025B, 0x400002C0,
+	0x40000324, 0x40000389, 0x400003ED, 0x40000452, 0x400004B7, 0x4000051B, 0x40000580, 0x400005E4,
+	0x40000649, 0x400006AD, 0x40000712, 0x40000777, 0x400007DB, 0x40000840, 0x400008A5, 0x40000909,
+	0x4000096E, 0x400009D3, 0x40000A37, 0x40000A9C, 0x40000B01, 0x40000B65, 0x40000BCA, 0x40000C2F,
+	0x40000C94, 0x40000CF8, 0x40000D5D, 0x40000DC2, 0x40000E27, 0x40000E8C, 0x44000EF1, 0x40000F55,
+	0x40000FBA, 0x4000101F, 0x40001084, 0x400010E9, 0x4000114E, 0x400011B3, 0x40001218, 0x4000127D,
+	0x400012E2, 0x40001347, 0x400013AC, 0x40001412, 0x40001477, 0x400014DC, 0x40001541, 0x400015A6,
+	0x4000160C, 0x40001671, 0x400016D6, 0x4000173C, 0x400017A1, 0x40001806, 0x4000186C, 0x400018D1,
+	0x40001937, 0x4000199C, 0x40001A02, 0x40001A67, 0x40001ACD, 0x40001B33, 0x40001B98, 0x40001BFE,
+	0x40001C64, 0x40001CCA, 0x40001D2F, 0x40001D95, 0x40001DFB, 0x40001E61, 0x40001EC7, 0x40001F2D,
+	0x40001F93, 0x40001FF9, 0x4000205F, 0x400020C5, 0x4000212C, 0x40002192, 0x400021F8, 0x4000225E,
+	0x400022C5, 0x4000232B, 0x40002392, 0x400023F8, 0x4000245F, 0x400024C5, 0x4000252C, 0x40002593,
+	0x400025F9, 0x40002660, 0x400026C7, 0x4000272E, 0x40002795, 0x400027FC, 0x40002863, 0x400028CA,
+	0x40002931, 0x40002998, 0x400029FF, 0x40002A66, 0x40002ACE, 0x40002B35, 0x40002B9D, 0x40002C04,
+	0x40002C6C, 0x40002CD3, 0x40002D3B, 0x40002DA2, 0x40002E0A, 0x40002E72, 0x40002EDA, 0x40002F42,
+	0x40002FAA, 0x40003012, 0x4000307A, 0x400030E2, 0x4000314A, 0x400031B3, 0x4000321B, 0x40003283,
+	0x400032EC, 0x40003354, 0x400033BD, 0x40003426, 0x4000348E, 0x400034F7, 0x40003560, 0x400035C9,
+	0x40003632, 0x4000369B, 0x40003704, 0x4000376D, 0x400037D7, 0x40003840, 0x400038AA, 0x40003913,
+	0x4000397D, 0x400039E6, 0x40003A50, 0x40003ABA, 0x40003B24, 0x40003B8E, 0x40003BF8, 0x40003C62,
+	0x40003CCC, 0x40003D36, 0x40003DA0, 0x40003E0B, 0x40003E75, 0x40003EE0, 0x40003F4A, 0x40003FB5,
+	0x40004020, 0x4000408B, 0x400040F6, 0x40004161, 0x400041CC, 0x40004237, 0x400042A2, 0x4000430E,
+	0x40004379, 0x400043E5, 0x40004451, 0x400044BC, 0x40004528, 0x40004594, 0x40004600, 0x4000466C,
+	0x400046D8, 0x40004745, 0x400047B1, 0x4000481D, 0x4000488A, 0x400048F7, 0x40004963, 0x400049D0,
+	0x40004A3D, 0x40004AAA, 0x40004B17, 0x40004B84, 0x40004BF2, 0x40004C5F, 0x40004CCD, 0x40004D3A,
+	0x40004DA8, 0x40004E16, 0x40004E84, 0x40004EF2, 0x40004F60, 0x40004FCE, 0x4000503D, 0x400050AB,
+	0x4000511A, 0x40005188, 0x400051F7, 0x40005266, 0x400052D5, 0x40005344, 0x400053B3, 0x40005423,
+	0x40005492, 0x40005502, 0x40005571, 0x400055E1, 0x40005651, 0x400056C1, 0x40005731, 0x400057A1,
+	0x40005812, 0x40005882, 0x400058F3, 0x40005964, 0x400059D5, 0x40005A46, 0x40005AB7, 0x40005B28,
+	0x40005B99, 0x40005C0B, 0x40005C7C, 0x40005CEE, 0x40005D60, 0x40005DD2, 0x40005E44, 0x40005EB6,
+	0x40005F28, 0x40005F9B, 0x4000600E, 0x40006080, 0x400060F3, 0x40006166, 0x400061D9, 0x4000624D,
+	0x400062C0, 0x40006334, 0x400063A7, 0x4000641B, 0x4000648F, 0x40006503, 0x40006577, 0x400065EC,
+	0x40006660, 0x400066D5, 0x4000674A, 0x400067BF, 0x40006834, 0x400068A9, 0x4000691F, 0x40006994,
+	0x40006A0A, 0x40006A80, 0x40006AF6, 0x40006B6C, 0x40006BE2, 0x40006C59, 0x40006CCF, 0x40006D46,
+	0x40006DBD, 0x40006E34, 0x40006EAB, 0x40006F23, 0x40006F9A, 0x40007012, 0x4000708A, 0x40007102,
+	0x4000717A, 0x400071F2, 0x4000726B, 0x400072E4, 0x4000735D, 0x400073D6, 0x4000744F, 0x400074C8,
+	0x40007542, 0x400075BB, 0x40007635, 0x400076AF, 0x4000772A, 0x400077A4, 0x4000781F, 0x40007899,
+	0x40007914, 0x4000798F, 0x40007A0B, 0x40007A86, 0x40007B02, 0x40007B7E, 0x40007BFA, 0x40007C76,
+	0x40007CF2, 0x40007D6F, 0x40007DEC, 0x40007E68, 0x40007EE6, 0x40007F63, 0x40007FE0, 0x4000805E,
+	0x400080DC, 0x4000815A, 0x400081D8, 0x40008257, 0x400082D6, 0x40008355, 0x400083D4, 0x40008453,
+	0x400084D2, 0x40008552, 0x400085D2, 0x40008652, 0x400086D2, 0x40008753, 0x400087D4, 0x40008855,
+	0x400088D6, 0x40008957, 0x400089D9, 0x40008A5A, 0x40008ADC, 0x40008B5F, 0x40008BE1, 0x40008C64,
+	0x40008CE7, 0x40008D6A, 0x40008DED, 0x40008E71, 0x40008EF4, 0x40008F78, 0x40008FFD, 0x40009081,
+	0x40009106, 0x4000918B, 0x40009210, 0x40009295, 0x4000931B, 0x400093A1, 0x40009427, 0x400094AD,
+	0x40009534, 0x400095BA, 0x40009641, 0x400096C9, 0x40009750, 0x400097D8, 0x40009860, 0x400098E8,
+	0x40009971, 0x400099FA, 0x40009A83, 0x40009B0C, 0x40009B95, 0x40009C1F, 0x40009CA9, 0x40009D34,
+	0x40009DBE, 0x40009E49, 0x40009ED4, 0x40009F5F, 0x40009FEB, 0x4000A077, 0x4000A103, 0x4400A190,
+	0x4000A21C, 0x4000A2A9, 0x4000A336, 0x4000A3C4, 0x4000A452, 0x4000A4E0, 0x4000A56E, 0x4000A5FD,
+	0x4000A68C, 0x4000A71B, 0x4000A7AB, 0x4000A83A, 0x4000A8CA, 0x4000A95B, 0x4000A9EC, 0x4000AA7C,
+	0x4000AB0E, 0x4000AB9F, 0x4000AC31, 0x4000ACC3, 0x4000AD56, 0x4000ADE9, 0x4000AE7C, 0x4000AF0F,
+	0x4000AFA3, 0x4000B037, 0x4000B0CB, 0x4000B160, 0x4000B1F5, 0x4000B28A, 0x4000B320, 0x4000B3B5,
+	0x4000B44C, 0x4000B4E2, 0x4000B579, 0x4000B610, 0x4000B6A8, 0x4000B740, 0x4000B7D8, 0x4000B870,
+	0x4000B909, 0x4000B9A3, 0x4000BA3C, 0x4000BAD6, 0x4000BB70, 0x4000BC0B, 0x4000BCA6, 0x4000BD41,
+	0x4000BDDD, 0x4000BE79, 0x4000BF15, 0x4000BFB2, 0x4000C04F, 0x4000C0EC, 0x4000C18A, 0x4000C228,
+	0x4000C2C7, 0x4000C366, 0x4000C405, 0x4000C4A5, 0x4000C545, 0x4000C5E5, 0x4000C686, 0x4000C727,
+	0x4000C7C9, 0x4000C86B, 0x4000C90D, 0x4000C9B0, 0x4000CA53, 0x4000CAF6, 0x4000CB9A, 0x4000CC3F,
+	0x4000CCE3, 0x4000CD89, 0x4000CE2E, 0x4000CED4, 0x4000CF7A, 0x4000D021, 0x4000D0C8, 0x4000D170,
+	0x4000D218, 0x4000D2C0, 0x4000D369, 0x4000D413, 0x4000D4BC, 0x4000D567, 0x4000D611, 0x4000D6BC,
+	0x4000D768, 0x4000D814, 0x4000D8C0, 0x4000D96D, 0x4000DA1A, 0x4000DAC8, 0x4000DB76, 0x4000DC25,
+	0x4000DCD4, 0x4000DD83, 0x4000DE33, 0x4000DEE4, 0x4000DF95, 0x4000E046, 0x4000E0F8, 0x4000E1AB,
+	0x4400E25E, 0x4000E311, 0x4000E3C5, 0x4000E479, 0x4000E52E, 0x4000E5E3, 0x4000E699, 0x4400E750,
+	0x4000E806, 0x4000E8BE, 0x4000E976, 0x4000EA2E, 0x4000EAE7, 0x4000EBA0, 0x4000EC5A, 0x4000ED15,
+	0x4000EDD0, 0x4000EE8B, 0x4000EF47, 0x4000F004, 0x4000F0C1, 0x4000F17F, 0x4000F23D, 0x4000F2FC,
+	0x4000F3BB, 0x4000F47B, 0x4000F53C, 0x4000F5FD, 0x4000F6BF, 0x4000F781, 0x4000F844, 0x4000F907,
+	0x4000F9CB, 0x4000FA8F, 0x4000FB55, 0x4000FC1A, 0x4000FCE1, 0x4000FDA8, 0x4000FE6F, 0x4000FF37,
+	0x40010000, 0x400100C9, 0x40010193, 0x4001025E, 0x40010329, 0x400103F5, 0x400104C2, 0x4001058F,
+	0x4001065D, 0x4001072B, 0x400107FA, 0x400108CA, 0x4001099A, 0x40010A6B, 0x40010B3D, 0x44010C10,
+	0x40010CE3, 0x40010DB6, 0x40010E8B, 0x40010F60, 0x40011036, 0x4001110C, 0x400111E4, 0x400112BC,
+	0x40011394, 0x4001146E, 0x40011548, 0x40011623, 0x400116FE, 0x400117DA, 0x400118B8, 0x40011995,
+	0x40011A74, 0x40011B53, 0x40011C33, 0x40011D14, 0x40011DF6, 0x40011ED8, 0x40011FBB, 0x4001209F,
+	0x40012184, 0x40012269, 0x44012350, 0x40012437, 0x4001251F, 0x40012607, 0x400126F1, 0x400127DB,
+	0x400128C6, 0x400129B2, 0x40012A9F, 0x40012B8D, 0x40012C7C, 0x40012D6B, 0x40012E5C, 0x40012F4D,
+	0x4001303F, 0x40013132, 0x40013226, 0x4001331A, 0x40013410, 0x40013507, 0x400135FE, 0x400136F7,
+	0x400137F0, 0x400138EA, 0x400139E5, 0x40013AE1, 0x40013BDF, 0x40013CDD, 0x40013DDC, 0x40013EDC,
+	0x40013FDD, 0x400140DF, 0x400141E2, 0x400142E6, 0x440143EB, 0x440144F1, 0x440145F8, 0x40014700,
+	0x40014809, 0x40014913, 0x40014A1E, 0x40014B2A, 0x40014C37, 0x40014D46, 0x40014E55, 0x40014F66,
+	0x40015077, 0x4001518A, 0x4001529E, 0x400153B3, 0x400154C9, 0x400155E0, 0x400156F9, 0x40015812,
+	0x4001592D, 0x40015A49, 0x40015B66, 0x40015C84, 0x40015DA4, 0x40015EC4, 0x40015FE6, 0x40016109,
+	0x4001622E, 0x40016353, 0x4001647A, 0x400165A2, 0x400166CC, 0x400167F6, 0x40016922, 0x40016A4F,
+	0x40016B7E, 0x40016CAE, 0x40016DDF, 0x40016F12, 0x44017046, 0x4001717B, 0x400172B1, 0x400173E9,
+	0x40017523, 0x4001765E, 0x4001779A, 0x3C0178D7, 0x40017A17, 0x40017B57, 0x40017C99, 0x40017DDD,
+	0x40017F22, 0x40018068, 0x400181B0, 0x400182F9, 0x40018444, 0x40018591, 0x400186DF, 0x4001882F,
+	0x40018980, 0x40018AD3, 0x40018C27, 0x40018D7D, 0x40018ED5, 0x4001902F, 0x4001918A, 0x400192E6,
+	0x40019445, 0x400195A5, 0x40019707, 0x4001986A, 0x400199CF, 0x40019B36, 0x40019C9F, 0x40019E0A,
+	0x40019F76, 0x4001A0E4, 0x4001A254, 0x4001A3C6, 0x4001A53A, 0x4001A6B0, 0x4001A827, 0x4001A9A1,
+	0x4001AB1C, 0x4001AC9A, 0x4001AE19, 0x4001AF9A, 0x4001B11D, 0x4001B2A3, 0x4001B42A, 0x4001B5B3,
+	0x4001B73F, 0x4001B8CC, 0x4001BA5C, 0x4001BBEE, 0x4001BD82, 0x4001BF18, 0x4001C0B0, 0x4001C24B,
+	0x4001C3E7, 0x4001C586, 0x4001C727, 0x4001C8CB, 0x4401CA71, 0x4001CC19, 0x4001CDC3, 0x4001CF70,
+	0x4001D11F, 0x4001D2D1, 0x4001D485, 0x4001D63B, 0x4001D7F4, 0x4001D9B0, 0x4001DB6E, 0x4001DD2E,
+	0x4001DEF1, 0x4001E0B7, 0x4001E27F, 0x4001E44A, 0x4001E618, 0x4001E7E8, 0x4001E9BB, 0x4001EB91,
+	0x4001ED6A, 0x4001EF45, 0x4001F123, 0x4001F304, 0x4001F4E8, 0x4001F6CF, 0x4001F8B9, 0x4001FAA6,
+	0x4001FC96, 0x4401FE89, 0x4002007E, 0x40020277, 0x40020473, 0x40020673, 0x40020875, 0x40020A7B,
+	0x40020C84, 0x40020E90, 0x440210A0, 0x400212B2, 0x400214C9, 0x400216E2, 0x400218FF, 0x40021B20,
+	0x40021D44, 0x40021F6C, 0x40022197, 0x400223C6, 0x400225F9, 0x4002282F, 0x40022A69, 0x40022CA7,
+	0x40022EE9, 0x4002312F, 0x40023378, 0x400235C6, 0x40023818, 0x40023A6D, 0x40023CC7, 0x40023F25,
+	0x40024187, 0x400243ED, 0x40024658, 0x400248C7, 0x40024B3A, 0x40024DB2, 0x4002502E, 0x400252AF,
+	0x40025534, 0x400257BE, 0x44025A4D, 0x40025CE0, 0x40025F78, 0x40026215, 0x400264B7, 0x4002675E,
+	0x40026A0A, 0x40026CBB, 0x40026F71, 0x4002722C, 0x400274ED, 0x400277B3, 0x40027A7E, 0x40027D4F,
+	0x40028026, 0x40028302, 0x400285E3, 0x440288CB, 0x40028BB8, 0x40028EAB, 0x400291A4, 0x400294A3,
+	0x400297A8, 0x40029AB3, 0x44029DC5, 0x4002A0DC, 0x4002A3FB, 0x4002A71F, 0x4002AA4B, 0x4002AD7D,
+	0x4002B0B5, 0x4002B3F5, 0x4002B73B, 0x4002BA89, 0x4002BDDD, 0x4002C139, 0x4002C49C, 0x4002C807,
+	0x4002CB79, 0x4002CEF2, 0x4002D274, 0x4002D5FD, 0x4002D98E, 0x4002DD27, 0x4002E0C8, 0x4002E471,
+	0x4002E823, 0x4002EBDD, 0x4002EFA0, 0x4002F36C, 0x4002F740, 0x4002FB1D, 0x4002FF04, 0x400302F3,
+	0x400306EC, 0x40030AEF, 0x40030EFB, 0x40031311, 0x40031730, 0x40031B5A, 0x40031F8E, 0x400323CD,
+	0x40032816, 0x40032C69, 0x400330C8, 0x40033531, 0x400339A6, 0x40033E26, 0x400342B1, 0x40034748,
+	0x40034BEB, 0x4003509A, 0x40035556, 0x44035A1E, 0x40035EF2, 0x400363D3, 0x400368C2, 0x40036DBD,
+	0x400372C6, 0x400377DD, 0x40037D02, 0x40038235, 0x40038776, 0x40038CC6, 0x40039225, 0x40039793,
+	0x40039D11, 0x4003A29E, 0x4003A83B, 0x4003ADE8, 0x4003B3A6, 0x4003B974, 0x4003BF54, 0x4003C545,
+	0x4003CB48, 0x4403D15D, 0x4403D784, 0x4003DDBD, 0x4003E40A, 0x4003EA6A, 0x4003F0DE, 0x4003F766,
+	0x4003FE02, 0x400404B4, 0x40040B7A, 0x40041256, 0x40041949, 0x40042051, 0x40042771, 0x40042EA8,
+	0x400435F7, 0x40043D5E, 0x400444DE, 0x40044C78, 0x4004542B, 0x40045BF9, 0x400463E1, 0x40046BE5,
+	0x40047405, 0x40047C42, 0x4004849B, 0x40048D13, 0x400495A9, 0x40049E5E, 0x4004A733, 0x4004B029,
+	0x4004B940, 0x4404C279, 0x4004CBD4, 0x4004D553, 0x4004DEF6, 0x4004E8BF, 0x4004F2AD, 0x4004FCC3,
+	0x40050700, 0x40051166, 0x40051BF5, 0x400526B0, 0x44053196, 0x40053CA8, 0x400547E9, 0x40055359,
+	0x40055EF9, 0x40056ACB, 0x400576CF, 0x40058307, 0x40058F75, 0x40059C19, 0x4005A8F6, 0x4005B60C,
+	0x4005C35D, 0x4405D0EC, 0x4005DEB8, 0x4005ECC5, 0x4005FB14, 0x400609A7, 0x4006187F, 0x440627A0,
+	0x4406370A, 0x440646C0, 0x400656C4, 0x44066719, 0x400677C0, 0x400688BD, 0x44069A13, 0x4406ABC3,
+	0x4006BDD0, 0x4006D03E, 0x4006E310, 0x4406F649, 0x440709EC, 0x40071DFC, 0x4007327E, 0x44074776,
+	0x40075CE6, 0x400772D4, 0x40078944, 0x4007A03A, 0x4007B7BB, 0x4407CFCD, 0x4407E874, 0x400801B5,
+	0x40081B98, 0x44083622, 0x44085159, 0x44086D44, 0x440889EA, 0x4408A753, 0x4008C586, 0x4008E48C,
+	0x4009046E, 0x40092535, 0x400946EB, 0x40096999, 0x40098D4C, 0x4009B20F, 0x4009D7EE, 0x4409FEF7,
+	0x400A2736, 0x440A50BC, 0x440A7B97, 0x440AA7D9, 0x440AD594, 0x440B04DA, 0x440B35C0, 0x440B685D,
+	0x440B9CC7, 0x440BD317, 0x440C0B6A, 0x440C45DB, 0x440C828A, 0x400CC199, 0x440D032D, 0x440D476D,
+	0x440D8E83, 0x440DD89E, 0x440E25F0, 0x440E76B1, 0x440ECB1C, 0x440F2372, 0x440F7FFC, 0x480FE106,
+	0x481046EA, 0x4810B206, 0x441122C3, 0x48119997, 0x48121703, 0x44129B97, 0x481327F7, 0x4C13BCD6,
+	0x4C145B01, 0x4C15035E, 0x4C15B6F2, 0x4C1676E6, 0x4C17448E, 0x4C182170, 0x50190F4D, 0x501A102E,
+	0x501B2674, 0x541C54EB, 0x541D9EDD, 0x541F0839, 0x582095B5, 0x5C224D04, 0x6024351F, 0x642656A3,
+	0x6828BC53, 0x402B73D2, 0x402E8EA8, 0x403223AE, 0x40365198, 0x403B4204, 0x40412F4C, 0x40486DB9,
+	0x40517BBA, 0x405D1FFB, 0x406CA59C, 0x408260A7, 0x40A2F92B, 0x40D94CAA, 0x4145F3B8, 0x428BEA34,
+	0x40000000
+};
+
+NVQM_LUT_DATA xint xint_tan__pole[16] = {
+	-2147483648, -42721456, -21360982, -14240667, -10680467, -8544325, -7120217, -6102985, -5340052,
+	-4746651, -4271924, -3883504, -3559815, -3285919, -3051164, -2847687
+};
+#else
 /* sorry for the mess, but this is the lookup table for sin and tan */
-const xint xint_sin__lut[XANG360] = {
+NVQM_LUT_DATA xint xint_sin__lut[XANG__LUT] = {
 	0, 101, 201, 302, 402, 503, 603, 704, 804, 905, 1005, 1106, 1206, 1307, 1407, 1508, 1608, 1709,
 	1809, 1910, 2010, 2111, 2211, 2312, 2412, 2513, 2613, 2714, 2814, 2914, 3015, 3115, 3216, 3316,
 	3417, 3517, 3617, 3718, 3818, 3918, 4019, 4119, 4219, 4320, 4420, 4520, 4621, 4721, 4821, 4921,
@@ -2482,7 +5456,7 @@ const xint xint_sin__lut[XANG360] = {
 	-704, -603, -503, -402, -302, -201, -101
 };
 
-const xint xint_tan__lut[XANG180] = {
+NVQM_LUT_DATA xint xint_tan__lut[XANG__LUT / 2] = {
 	0, 101, 201, 302, 402, 503, 603, 704, 804, 905, 1005, 1106, 1207, 1307, 1408, 1508, 1609, 1709,
 	1810, 1911, 2011, 2112, 2213, 2313, 2414, 2515, 2615, 2716, 2817, 2917, 3018, 3119, 3220, 3320,
 	3421, 3522, 3623, 3724, 3825, 3925, 4026, 4127, 4228, 4329, 4430, 4531, 4632, 4733, 4834, 4935,
@@ -2656,5 +5630,8 @@ const xint xint_tan__lut[XANG180] = {
 	-2313, -2213, -2112, -2011, -1911, -1810, -1709, -1609, -1508, -1408, -1307, -1207, -1106,
 	-1005, -905, -804, -704, -603, -503, -402, -302, -201, -101
 };
+#endif
 
 #endif /* NVQM_SKIP_FIXED_POINT */
+
+#endif /* NVQM__C */
@@ -6,12 +6,37 @@
 #ifndef NVQM__H
 #define NVQM__H
 
+/* by default, functions that aren't static inline are compiled once in nvqm.c
+ * define NVQM_IMPLEMENTATION in one source file to compile nvqm.c as part of that file instead
+ * define NVQM_INLINE_ALL to make every function static inline, so only the header is needed, and
+ * the compiler can inline matrix functions too
+ */
+#ifdef NVQM_INLINE_ALL
+#	define NVQM_API  static inline
+#	define NVQM_LUT  static const
+#else
+#	define NVQM_API
+#	define NVQM_LUT  extern const
+#endif
+
+/* SSE2 is used for the array functions and num_frsqrt when the compiler targets it
+ * define NVQM_SKIP_SIMD to force the plain C versions
+ */
+#if !defined(NVQM_SKIP_SIMD) && (defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#	define NVQM_SSE2
+#	include <emmintrin.h>
+#endif
+
 #ifndef NVQM_SKIP_FLOATING_POINT
 /* floating point library included by default
  * define NVQM_SKIP_FLOATING_POINT to skip including the implementation
  */
 
 #include <math.h>
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
 
 /*
  * 32-bit floating point
@@ -32,6 +57,12 @@ typedef struct { float v[ 4]; } mat2;
 typedef struct { float v[ 6]; } mat3x2;
 typedef struct { float v[ 9]; } mat3;
 typedef struct { float v[16]; } mat4;
+typedef struct { float v[12]; } mat4x3; /* affine mat4 without the [0, 0, 0, 1] bottom row */
+
+/* structure of arrays, each member points to `n` floats owned by the caller */
+typedef struct { float *x; float *y; float *z;           } vec3soa;
+typedef struct { float *x; float *y; float *z; float *w; } vec4soa;
+typedef struct { float *x; float *y; float *z; float *w; } quatsoa;
 
 static inline vec2 vec2_new(float x, float y){
 	vec2 res;
@@ -162,6 +193,19 @@ static inline float num_floor(float a){
 	return floorf(a);
 }
 
+static inline float num_frsqrt(float a){
+	/* fast 1 / sqrt(a) for normal positive floats, using the hardware estimate plus one
+	 * Newton-Raphson step, which is within 3 ulp of the correctly rounded result (see chk_frsqrt in
+	 * test.c); the estimate differs between CPU vendors, so results aren't portable bit for bit
+	 * falls back to the exact calculation without SSE2 */
+#ifdef NVQM_SSE2
+	float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(a)));
+	return y + y * (0.5f - 0.5f * a * y * y);
+#else
+	return 1.0f / sqrtf(a);
+#endif
+}
+
 static inline float num_lerp(float a, float b, float t){
 	return a + (b - a) * t;
 }
@@ -256,6 +300,17 @@ static inline float vec2_dot(vec2 a, vec2 b){
 	return a.v[0] * b.v[0] + a.v[1] * b.v[1];
 }
 
+static inline vec2 vec2_fnormal(vec2 a){
+	/* num_frsqrt instead of 1 / num_sqrt, so lengths below FLT_MIN are left alone */
+	float ax = a.v[0], ay = a.v[1],
+		len = ax * ax + ay * ay;
+	if (len >= FLT_MIN){
+		len = num_frsqrt(len);
+		return vec2_new(ax * len, ay * len);
+	}
+	return a;
+}
+
 static inline vec2 vec2_inverse(vec2 a){
 	return vec2_new(1.0f / a.v[0], 1.0f / a.v[1]);
 }
@@ -353,6 +408,15 @@ static inline vec3 vec3_applymat4(vec3 a, mat4 *b){
 	);
 }
 
+static inline vec3 vec3_applymat4x3(vec3 a, mat4x3 *b){
+	float ax = a.v[0], ay = a.v[1], az = a.v[2];
+	return vec3_new(
+		b->v[0] * ax + b->v[3] * ay + b->v[6] * az + b->v[ 9],
+		b->v[1] * ax + b->v[4] * ay + b->v[7] * az + b->v[10],
+		b->v[2] * ax + b->v[5] * ay + b->v[8] * az + b->v[11]
+	);
+}
+
 static inline vec3 vec3_applyquat(vec3 a, quat b){
 	float
 		ax = a.v[0], ay = a.v[1], az = a.v[2],
@@ -402,6 +466,16 @@ static inline float vec3_dot(vec3 a, vec3 b){
 	return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2];
 }
 
+static inline vec3 vec3_fnormal(vec3 a){
+	float ax = a.v[0], ay = a.v[1], az = a.v[2];
+	float len = ax * ax + ay * ay + az * az;
+	if (len >= FLT_MIN){
+		len = num_frsqrt(len);
+		return vec3_new(ax * len, ay * len, az * len);
+	}
+	return a;
+}
+
 static inline vec3 vec3_inverse(vec3 a){
 	return vec3_new(1.0f / a.v[0], 1.0f / a.v[1], 1.0f / a.v[2]);
 }
@@ -530,6 +604,16 @@ static inline float vec4_dot(vec4 a, vec4 b){
 	return a.v[0] * b.v[0] + a.v[1] * b.v[1] + a.v[2] * b.v[2] + a.v[3] * b.v[3];
 }
 
+static inline vec4 vec4_fnormal(vec4 a){
+	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3];
+	float len = ax * ax + ay * ay + az * az + aw * aw;
+	if (len >= FLT_MIN){
+		len = num_frsqrt(len);
+		return vec4_new(ax * len, ay * len, az * len, aw * len);
+	}
+	return a;
+}
+
 static inline vec4 vec4_inverse(vec4 a){
 	return vec4_new(1.0f / a.v[0], 1.0f / a.v[1], 1.0f / a.v[2], 1.0f / a.v[3]);
 }
@@ -685,6 +769,16 @@ static inline quat quat_euler_zyx(vec3 rot){
 	);
 }
 
+static inline quat quat_fnormal(quat a){
+	float ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3];
+	float len = ax * ax + ay * ay + az * az + aw * aw;
+	if (len >= FLT_MIN){
+		len = num_frsqrt(len);
+		return quat_new(ax * len, ay * len, az * len, aw * len);
+	}
+	return a;
+}
+
 static inline quat quat_identity(){
 	return quat_new(0.0f, 0.0f, 0.0f, 1.0f);
 }
@@ -981,51 +1075,162 @@ static inline mat3x2 mat3x2_translation(vec2 a){
  * mat3
  */
 
-mat3 *mat3_add        (mat3 *out, mat3 *a, mat3 *b);
-mat3 *mat3_adjoint    (mat3 *out, mat3 *a);
-mat3 *mat3_compmul    (mat3 *out, mat3 *a, mat3 *b);
-mat3 *mat3_copy       (mat3 *out, mat3 *a);
-float mat3_det        (mat3 *a);
-mat3 *mat3_identity   (mat3 *out);
-mat3 *mat3_invert     (mat3 *out, mat3 *a);
-mat3 *mat3_mul        (mat3 *out, mat3 *a, mat3 *b);
-mat3 *mat3_quat       (mat3 *out, quat a);
-mat3 *mat3_rotate     (mat3 *out, mat3 *a, float ang);
-mat3 *mat3_rotation   (mat3 *out, float ang);
-mat3 *mat3_scale      (mat3 *out, mat3 *a, vec2 b);
-mat3 *mat3_scaling    (mat3 *out, vec2 a);
-mat3 *mat3_sub        (mat3 *out, mat3 *a, mat3 *b);
-mat3 *mat3_translate  (mat3 *out, mat3 *a, vec2 b);
-mat3 *mat3_translation(mat3 *out, vec2 a);
-mat3 *mat3_transpose  (mat3 *out, mat3 *a);
+NVQM_API mat3 *mat3_add        (mat3 *out, mat3 *a, mat3 *b);
+NVQM_API mat3 *mat3_adjoint    (mat3 *out, mat3 *a);
+NVQM_API mat3 *mat3_compmul    (mat3 *out, mat3 *a, mat3 *b);
+NVQM_API mat3 *mat3_copy       (mat3 *out, mat3 *a);
+NVQM_API float mat3_det        (mat3 *a);
+NVQM_API mat3 *mat3_identity   (mat3 *out);
+NVQM_API mat3 *mat3_invert     (mat3 *out, mat3 *a);
+NVQM_API mat3 *mat3_mul        (mat3 *out, mat3 *a, mat3 *b);
+NVQM_API mat3 *mat3_quat       (mat3 *out, quat a);
+NVQM_API mat3 *mat3_rotate     (mat3 *out, mat3 *a, float ang);
+NVQM_API mat3 *mat3_rotation   (mat3 *out, float ang);
+NVQM_API mat3 *mat3_scale      (mat3 *out, mat3 *a, vec2 b);
+NVQM_API mat3 *mat3_scaling    (mat3 *out, vec2 a);
+NVQM_API mat3 *mat3_sub        (mat3 *out, mat3 *a, mat3 *b);
+NVQM_API mat3 *mat3_translate  (mat3 *out, mat3 *a, vec2 b);
+NVQM_API mat3 *mat3_translation(mat3 *out, vec2 a);
+NVQM_API mat3 *mat3_transpose  (mat3 *out, mat3 *a);
 
 /*
  * mat4
  */
 
-mat4 *mat4_add           (mat4 *out, mat4 *a, mat4 *b);
-mat4 *mat4_adjoint       (mat4 *out, mat4 *a);
-mat4 *mat4_compmul       (mat4 *out, mat4 *a, mat4 *b);
-mat4 *mat4_copy          (mat4 *out, mat4 *a);
-float mat4_det           (mat4 *a);
-mat4 *mat4_frustum       (mat4 *out, float L, float R, float B, float T, float N, float F);
-mat4 *mat4_identity      (mat4 *out);
-mat4 *mat4_invert        (mat4 *out, mat4 *a);
-mat4 *mat4_lookat        (mat4 *out, vec3 eye, vec3 position, vec3 up);
-mat4 *mat4_mul           (mat4 *out, mat4 *a, mat4 *b);
-mat4 *mat4_orthogonal    (mat4 *out, float W, float H, float N, float F);
-mat4 *mat4_perspective   (mat4 *out, float fov, float W, float H, float N, float F);
-mat4 *mat4_quat          (mat4 *out, quat a);
-mat4 *mat4_rotate        (mat4 *out, mat4 *a, vec3 axis, float ang);
-mat4 *mat4_rotation      (mat4 *out, vec3 axis, float ang);
-mat4 *mat4_rottrans      (mat4 *out, quat a, vec3 b);
-mat4 *mat4_rottransorigin(mat4 *out, quat a, vec3 b, vec3 origin);
-mat4 *mat4_scale         (mat4 *out, mat4 *a, vec3 b);
-mat4 *mat4_scaling       (mat4 *out, vec3 a);
-mat4 *mat4_sub           (mat4 *out, mat4 *a, mat4 *b);
-mat4 *mat4_translate     (mat4 *out, mat4 *a, vec3 b);
-mat4 *mat4_translation   (mat4 *out, vec3 a);
-mat4 *mat4_transpose     (mat4 *out, mat4 *a);
+NVQM_API mat4 *mat4_add           (mat4 *out, mat4 *a, mat4 *b);
+NVQM_API mat4 *mat4_adjoint       (mat4 *out, mat4 *a);
+NVQM_API mat4 *mat4_compmul       (mat4 *out, mat4 *a, mat4 *b);
+NVQM_API mat4 *mat4_copy          (mat4 *out, mat4 *a);
+NVQM_API float mat4_det           (mat4 *a);
+NVQM_API mat4 *mat4_frustum       (mat4 *out, float L, float R, float B, float T, float N, float F);
+NVQM_API mat4 *mat4_identity      (mat4 *out);
+NVQM_API mat4 *mat4_invert        (mat4 *out, mat4 *a);
+NVQM_API mat4 *mat4_invert_affine (mat4 *out, mat4 *a); /* bottom row is [0, 0, 0, 1] */
+NVQM_API mat4 *mat4_invert_fast   (mat4 *out, mat4 *a); /* picks the cheapest of the above */
+NVQM_API mat4 *mat4_invert_rigid  (mat4 *out, mat4 *a); /* rotation and translation only */
+NVQM_API mat4 *mat4_lookat        (mat4 *out, vec3 eye, vec3 position, vec3 up);
+NVQM_API mat4 *mat4_mul           (mat4 *out, mat4 *a, mat4 *b);
+NVQM_API mat4 *mat4_mul_affine    (mat4 *out, mat4 *a, mat4 *b); /* bottom rows are [0, 0, 0, 1] */
+NVQM_API mat4 *mat4_orthogonal    (mat4 *out, float W, float H, float N, float F);
+NVQM_API mat4 *mat4_perspective   (mat4 *out, float fov, float W, float H, float N, float F);
+NVQM_API mat4 *mat4_quat          (mat4 *out, quat a);
+NVQM_API mat4 *mat4_rotate        (mat4 *out, mat4 *a, vec3 axis, float ang);
+NVQM_API mat4 *mat4_rotation      (mat4 *out, vec3 axis, float ang);
+NVQM_API mat4 *mat4_rottrans      (mat4 *out, quat a, vec3 b);
+NVQM_API mat4 *mat4_rottransorigin(mat4 *out, quat a, vec3 b, vec3 origin);
+NVQM_API mat4 *mat4_scale         (mat4 *out, mat4 *a, vec3 b);
+NVQM_API mat4 *mat4_scaling       (mat4 *out, vec3 a);
+NVQM_API mat4 *mat4_sub           (mat4 *out, mat4 *a, mat4 *b);
+NVQM_API mat4 *mat4_translate     (mat4 *out, mat4 *a, vec3 b);
+NVQM_API mat4 *mat4_translation   (mat4 *out, vec3 a);
+NVQM_API mat4 *mat4_transpose     (mat4 *out, mat4 *a);
+
+/*
+ * mat4x3
+ */
+
+NVQM_API mat4x3 *mat4x3_copy    (mat4x3 *out, mat4x3 *a);
+NVQM_API mat4x3 *mat4x3_identity(mat4x3 *out);
+NVQM_API mat4x3 *mat4x3_invert  (mat4x3 *out, mat4x3 *a);
+NVQM_API mat4x3 *mat4x3_mat4    (mat4x3 *out, mat4 *a); /* drops the bottom row */
+NVQM_API mat4   *mat4_mat4x3    (mat4 *out, mat4x3 *a);
+NVQM_API mat4x3 *mat4x3_mul     (mat4x3 *out, mat4x3 *a, mat4x3 *b);
+NVQM_API mat4x3 *mat4x3_rottrans(mat4x3 *out, quat a, vec3 b);
+
+/*
+ * arrays
+ * operate on `n` contiguous elements, and `out` can be the same pointer as the input
+ */
+
+NVQM_API vec3 *vec3_applymat4_array      (vec3 *out, vec3 *a, mat4 *b, size_t n);
+NVQM_API vec3 *vec3_applymat4affine_array(vec3 *out, vec3 *a, mat4 *b, size_t n); /* skips the w divide */
+NVQM_API vec3 *vec3_fnormal_array        (vec3 *out, vec3 *a, size_t n);
+NVQM_API vec4 *vec4_fnormal_array        (vec4 *out, vec4 *a, size_t n);
+NVQM_API quat *quat_fnormal_array        (quat *out, quat *a, size_t n);
+NVQM_API quat *quat_nlerp_array          (quat *out, quat *a, quat *b, float t, size_t n);
+NVQM_API quat *quat_nlerpv_array         (quat *out, quat *a, quat *b, float *t, size_t n); /* t per element */
+NVQM_API quat *quat_slerp_array          (quat *out, quat *a, quat *b, float t, size_t n); /* polynomial */
+NVQM_API quat *quat_slerpv_array         (quat *out, quat *a, quat *b, float *t, size_t n);
+
+/*
+ * structure of arrays
+ * operate on `n` elements, and `out` can be the same as an input
+ */
+
+NVQM_API vec3soa *vec3soa_fromvec3 (vec3soa *out, vec3 *a, size_t n);
+NVQM_API vec3    *vec3soa_tovec3   (vec3 *out, vec3soa *a, size_t n);
+NVQM_API vec3soa *vec3soa_add      (vec3soa *out, vec3soa *a, vec3soa *b, size_t n);
+NVQM_API vec3soa *vec3soa_applymat4(vec3soa *out, vec3soa *a, mat4 *b, size_t n);
+NVQM_API vec3soa *vec3soa_applyquat(vec3soa *out, vec3soa *a, quat b, size_t n);
+NVQM_API vec3soa *vec3soa_cross    (vec3soa *out, vec3soa *a, vec3soa *b, size_t n);
+NVQM_API float   *vec3soa_dot      (float *out, vec3soa *a, vec3soa *b, size_t n);
+NVQM_API vec3soa *vec3soa_fnormal  (vec3soa *out, vec3soa *a, size_t n);
+NVQM_API vec3soa *vec3soa_lerp     (vec3soa *out, vec3soa *a, vec3soa *b, float t, size_t n);
+NVQM_API vec3soa *vec3soa_normal   (vec3soa *out, vec3soa *a, size_t n);
+NVQM_API vec3soa *vec3soa_scale    (vec3soa *out, vec3soa *a, float s, size_t n);
+NVQM_API vec3soa *vec3soa_sub      (vec3soa *out, vec3soa *a, vec3soa *b, size_t n);
+
+NVQM_API vec4soa *vec4soa_fromvec4 (vec4soa *out, vec4 *a, size_t n);
+NVQM_API vec4    *vec4soa_tovec4   (vec4 *out, vec4soa *a, size_t n);
+NVQM_API vec4soa *vec4soa_add      (vec4soa *out, vec4soa *a, vec4soa *b, size_t n);
+NVQM_API vec4soa *vec4soa_applymat4(vec4soa *out, vec4soa *a, mat4 *b, size_t n);
+NVQM_API float   *vec4soa_dot      (float *out, vec4soa *a, vec4soa *b, size_t n);
+NVQM_API vec4soa *vec4soa_fnormal  (vec4soa *out, vec4soa *a, size_t n);
+NVQM_API vec4soa *vec4soa_lerp     (vec4soa *out, vec4soa *a, vec4soa *b, float t, size_t n);
+NVQM_API vec4soa *vec4soa_normal   (vec4soa *out, vec4soa *a, size_t n);
+NVQM_API vec4soa *vec4soa_scale    (vec4soa *out, vec4soa *a, float s, size_t n);
+NVQM_API vec4soa *vec4soa_sub      (vec4soa *out, vec4soa *a, vec4soa *b, size_t n);
+
+NVQM_API quatsoa *quatsoa_fromquat (quatsoa *out, quat *a, size_t n);
+NVQM_API quat    *quatsoa_toquat   (quat *out, quatsoa *a, size_t n);
+NVQM_API float   *quatsoa_dot      (float *out, quatsoa *a, quatsoa *b, size_t n);
+NVQM_API quatsoa *quatsoa_fnormal  (quatsoa *out, quatsoa *a, size_t n);
+NVQM_API quatsoa *quatsoa_lerp     (quatsoa *out, quatsoa *a, quatsoa *b, float t, size_t n);
+NVQM_API quatsoa *quatsoa_mul      (quatsoa *out, quatsoa *a, quatsoa *b, size_t n);
+NVQM_API quatsoa *quatsoa_nlerp    (quatsoa *out, quatsoa *a, quatsoa *b, float t, size_t n);
+NVQM_API quatsoa *quatsoa_normal   (quatsoa *out, quatsoa *a, size_t n);
+
+/*
+ * transform hierarchy
+ * nodes are stored in topological order, so every parent index is less than the child's index, and
+ * roots have a parent of -1
+ * world[i] = world[parent[i]] * translation(pos[i]) * rotation(rot[i]) * scaling(scale[i])
+ * after changing a node's local transform, set dirty[i] to 1, and the next hierarchy_update will
+ * recompute that node and everything below it, then clear the flags
+ * the update returns NULL if a parent index is out of order, leaving nodes from that one on as-is
+ */
+
+typedef struct {
+	size_t         count;
+	int           *parent;
+	vec3soa        pos;
+	quatsoa        rot;
+	vec3soa        scale;
+	mat4          *world;
+	unsigned char *dirty;
+} hierarchy;
+
+NVQM_API hierarchy *hierarchy_update   (hierarchy *h); /* dirty nodes and their descendants */
+NVQM_API hierarchy *hierarchy_updateall(hierarchy *h); /* every node */
+
+/*
+ * frustum culling
+ * planes are (x, y, z, d) with unit normals pointing inward, so a point p is inside all of them when
+ * x * p.x + y * p.y + z * p.z + d >= 0
+ * the planes are in whatever space the matrix maps from, so use proj * view for world space bounds,
+ * or proj * view * model for object space bounds
+ * the cull functions set bit (i % 32) of out[i / 32] when element `i` may be visible, and clear it
+ * otherwise, so `out` needs room for (n + 31) / 32 words, and unused bits of the last word are zero
+ * a box near a corner of the frustum can pass even though it is outside, but nothing visible fails
+ */
+
+typedef struct { vec4 v[6]; } frustum; /* left, right, bottom, top, near, far */
+
+NVQM_API frustum  *frustum_frommat4   (frustum *out, mat4 *a);
+NVQM_API uint32_t *frustum_cullspheres(uint32_t *out, frustum *f, vec3soa *center, float *radius,
+	size_t n);
+NVQM_API uint32_t *frustum_cullaabbs  (uint32_t *out, frustum *f, vec3soa *min, vec3soa *max,
+	size_t n);
 
 #endif /* NVQM_SKIP_FLOATING_POINT */
 
@@ -1042,6 +1247,8 @@ mat4 *mat4_transpose     (mat4 *out, mat4 *a);
 
 /* signed 16.16 fixed-point */
 typedef int32_t xint;
+/* signed 32.32 fixed-point, for sums and products that don't fit in xint */
+typedef int64_t xlong;
 #ifndef NVQM_SKIP_COMPONENT_NAMES
 typedef union { xint v[ 2]; struct { xint x; xint y; };                 struct { xint r; xint g; };                 struct { xint s; xint t; };                 } xvec2;
 typedef union { xint v[ 3]; struct { xint x; xint y; xint z; };         struct { xint r; xint g; xint b; };         struct { xint s; xint t; xint p; };         } xvec3;
@@ -1058,6 +1265,9 @@ typedef struct { xint v[ 6]; } xmat3x2;
 typedef struct { xint v[ 9]; } xmat3;
 typedef struct { xint v[16]; } xmat4;
 
+/* a divisor prepared by xrecip_new for xint_div_by */
+typedef struct { uint32_t mlo; uint32_t mhi; int shift; uint32_t sign; } xrecip;
+
 static inline xvec2 xvec2_new(xint x, xint y){
 	xvec2 res;
 	res.v[0] = x;
@@ -1144,20 +1354,40 @@ static inline xmat4 xmat4_new(xint v00, xint v01, xint v02, xint v03, xint v10,
 #define XINT(v)  ((xint)((v) * XINT1))
 #define XINTMAX  INT32_MAX
 #define XINTMIN  INT32_MIN
+#define XLONG1   (INT64_C(1) << 32) /* the value 1 */
+#define XLONGMAX INT64_MAX
+#define XLONGMIN INT64_MIN
 
 /* note: angles for fixed-point operations are stored as 12 bit numbers (0 - 4095)
  * which means 0x000 = 0 degrees, 0x400 = 90 degrees, 0x800 = 180 degrees, etc
+ * define NVQM_XANG16 to store them as 16 bit numbers (0 - 65535) instead, so 0x4000 = 90 degrees,
+ * and xint_sin/xint_cos interpolate the same lookup tables
  */
 typedef int32_t xang;
-#define XANG0    0x0000
-#define XANG45   0x0200
-#define XANG90   0x0400
-#define XANG135  0x0600
-#define XANG180  0x0800
-#define XANG225  0x0A00
-#define XANG270  0x0C00
-#define XANG315  0x0E00
-#define XANG360  0x1000 /* can be thought of as TAU to some extent */
+#ifdef NVQM_XANG16
+#	define XANG0    0x00000
+#	define XANG45   0x02000
+#	define XANG90   0x04000
+#	define XANG135  0x06000
+#	define XANG180  0x08000
+#	define XANG225  0x0A000
+#	define XANG270  0x0C000
+#	define XANG315  0x0E000
+#	define XANG360  0x10000 /* can be thought of as TAU to some extent */
+#	define XANG__SHIFT  4   /* bits of xang below the lookup table index */
+#else
+#	define XANG0    0x0000
+#	define XANG45   0x0200
+#	define XANG90   0x0400
+#	define XANG135  0x0600
+#	define XANG180  0x0800
+#	define XANG225  0x0A00
+#	define XANG270  0x0C00
+#	define XANG315  0x0E00
+#	define XANG360  0x1000 /* can be thought of as TAU to some extent */
+#	define XANG__SHIFT  0
+#endif
+#define XANG__LUT  0x1000 /* entries per turn in the lookup tables */
 
 static inline int xint_toint(xint a){
 	return (int)(a >> 16);
@@ -1217,19 +1447,92 @@ static inline xint xint_mul(xint a, xint b){
 	return (xint)(m >> 16);
 }
 
+/* sums of products, where the Q32.32 products are added together before shifting down once, so
+ * there is one rounding instead of one per product
+ * define NVQM_XINT_ROUND_EACH to add xint_mul results instead, to replay results from older versions
+ */
+#ifdef NVQM_XINT_ROUND_EACH
+static inline xint xint_dot2(xint a, xint b, xint c, xint d){
+	return xint_add(xint_mul(a, b), xint_mul(c, d));
+}
+
+static inline xint xint_dot3(xint a, xint b, xint c, xint d, xint e, xint f){
+	return xint_add(xint_add(xint_mul(a, b), xint_mul(c, d)), xint_mul(e, f));
+}
+
+static inline xint xint_dot4(xint a, xint b, xint c, xint d, xint e, xint f, xint g, xint h){
+	return xint_add(xint_add(xint_add(xint_mul(a, b), xint_mul(c, d)), xint_mul(e, f)),
+		xint_mul(g, h));
+}
+#else
+/* the sums are unsigned so they can wrap like xint_add, which doesn't change bits 16 to 47 */
+static inline xint xint_dot2(xint a, xint b, xint c, xint d){
+	uint64_t m = (uint64_t)((int64_t)a * b) + (uint64_t)((int64_t)c * d);
+	return (xint)(uint32_t)(m >> 16);
+}
+
+static inline xint xint_dot3(xint a, xint b, xint c, xint d, xint e, xint f){
+	uint64_t m = (uint64_t)((int64_t)a * b) + (uint64_t)((int64_t)c * d) +
+		(uint64_t)((int64_t)e * f);
+	return (xint)(uint32_t)(m >> 16);
+}
+
+static inline xint xint_dot4(xint a, xint b, xint c, xint d, xint e, xint f, xint g, xint h){
+	uint64_t m = (uint64_t)((int64_t)a * b) + (uint64_t)((int64_t)c * d) +
+		(uint64_t)((int64_t)e * f) + (uint64_t)((int64_t)g * h);
+	return (xint)(uint32_t)(m >> 16);
+}
+#endif
+
 static inline xint xint_div(xint a, xint b){
 	int64_t m = (int64_t)a * XINT1;
 	return (xint)(m / b);
 }
 
+/* dividing many values by the same divisor is faster with a reciprocal prepared once, which gives
+ * the same results as xint_div bit for bit (b must not be 0, like xint_div)
+ * with |b| in (2^(shift - 1), 2^shift], m = ceil(2^(48 + shift) / |b|) is exact for every numerator
+ * below 2^48, and |a| * XINT1 is at most 2^47
+ */
+static inline xrecip xrecip_new(xint b){
+	xrecip res;
+	uint32_t d = b < 0 ? -(uint32_t)b : (uint32_t)b;
+	uint32_t t = d - 1;
+	int shift = 0;
+	for (int s = 16; s > 0; s >>= 1){
+		if (t >> s){
+			t >>= s;
+			shift += s;
+		}
+	}
+	shift += (int)t;
+	/* 2^(48 + shift) doesn't fit in 64 bits, so divide 32 bits at a time */
+	uint64_t n = UINT64_C(1) << (16 + shift);
+	uint64_t r = (n % d) << 32;
+	uint64_t m = ((n / d) << 32) + r / d + (r % d != 0);
+	res.mlo = (uint32_t)m;
+	res.mhi = (uint32_t)(m >> 32);
+	res.shift = shift;
+	res.sign = b < 0 ? UINT32_C(0xFFFFFFFF) : 0;
+	return res;
+}
+
+static inline xint xint_div_by(xint a, xrecip *b){
+	/* |a| * m >> 32 is split at the middle of m so the products fit in 64 bits */
+	uint32_t sa = (uint32_t)(a >> 31), s = sa ^ b->sign;
+	uint64_t x = ((uint32_t)a ^ sa) - sa;
+	uint64_t q = (x * b->mhi + ((x * b->mlo) >> 32)) >> b->shift;
+	return (xint)(((uint32_t)q ^ s) - s);
+}
+
 static inline xint xint_abs(xint a){
 	return a < 0 ? -a : a;
 }
 
-xang xint_acos(xint a);
-xang xint_asin(xint a);
-xang xint_atan2(xint a, xint b);
-xang xint_atan(xint a);
+NVQM_API xang xint_acos(xint a);
+NVQM_API xang xint_asin(xint a);
+NVQM_API xang xint_atan2(xint a, xint b);
+NVQM_API xang xint_atan(xint a);
 
 static inline xint xint_ceil(xint a){
 	return (a & INT32_C(0xFFFF0000)) + ((a & INT32_C(0x0000FFFF)) == 0 ? 0 : XINT1);
@@ -1244,7 +1547,7 @@ static inline xint xint_cos(xang a){
 	return xint_sin(a + XANG90);
 }
 
-xint xint_exp(xint a);
+NVQM_API xint xint_exp(xint a);
 
 static inline xint xint_floor(xint a){
 	return a & INT32_C(0xFFFF0000);
@@ -1254,7 +1557,7 @@ static inline xint xint_lerp(xint a, xint b, xint t){
 	return xint_add(a, xint_mul(xint_sub(b, a), t));
 }
 
-xint xint_log(xint a);
+NVQM_API xint xint_log(xint a);
 
 static inline xint xint_max(xint a, xint b){
 	return a > b ? a : b;
@@ -1268,22 +1571,147 @@ static inline xint xint_mod(xint a, xint b){
 	return a % b;
 }
 
-xint xint_pow(xint a, xint b);
+NVQM_API xint xint_pow(xint a, xint b);
+
+NVQM_API xint xint_rsqrt(xint a); /* 1 / sqrt(a) correctly rounded, or XINTMAX if a <= 0 */
 
 static inline xint xint_round(xint a){
 	return xint_floor(xint_add(a, XINT1 >> 1));
 }
 
-extern const xint xint_sin__lut[XANG360];
+/* define NVQM_QUARTER_LUT to store one quarter wave for sin and tan (8KB instead of 24KB), with
+ * results identical to the full tables
+ * the tables are indexed by 12 bit angles, even with NVQM_XANG16
+ */
+#ifdef NVQM_QUARTER_LUT
+NVQM_LUT xint xint_sin__qlut[XANG__LUT / 4 + 1];
+static inline xint xint_sin__at(uint32_t i){
+	/* the low 17 bits are sin of the first quadrant, and bits 17 to 24 are a correction of -1 to 1
+	 * (stored plus 1) for each quadrant, since the full table wasn't exactly symmetric
+	 * the mirror and the sign are done with masks, because random angles mispredict branches, and
+	 * the correction is picked with constant shifts, since shifting by a variable is slow on x86 */
+	i &= XANG__LUT - 1;
+	uint32_t m = 0u - ((i / (XANG__LUT / 4)) & 1);
+	uint32_t n = 0u - ((i / (XANG__LUT / 2)) & 1);
+	uint32_t e = (uint32_t)xint_sin__qlut[((i ^ m) - m) & (XANG__LUT / 2 - 1)];
+	uint32_t c = e >> 17;
+	c = i & (XANG__LUT / 2) ? c >> 4 : c;
+	c = i & (XANG__LUT / 4) ? c >> 2 : c;
+	uint32_t v = (e & 0x1FFFF) + (c & 3) - 1;
+	return (xint)((v ^ n) - n);
+}
+#else
+NVQM_LUT xint xint_sin__lut[XANG__LUT];
+static inline xint xint_sin__at(uint32_t i){
+	return xint_sin__lut[i & (XANG__LUT - 1)];
+}
+#endif
+
 static inline xint xint_sin(xang a){
-	return xint_sin__lut[xang_wrap(a)];
+#ifdef NVQM_XANG16
+	/* interpolate between the two nearest table entries, so the result is deterministic, and exact
+	 * at multiples of 16 */
+	uint32_t i = xang_wrap(a);
+	xint s0 = xint_sin__at(i >> XANG__SHIFT);
+	xint s1 = xint_sin__at((i >> XANG__SHIFT) + 1);
+	xint f = (xint)(i & ((1 << XANG__SHIFT) - 1));
+	return s0 + (((s1 - s0) * f + (1 << (XANG__SHIFT - 1))) >> XANG__SHIFT);
+#else
+	return xint_sin__at(xang_wrap(a));
+#endif
 }
 
-xint xint_sqrt(xint a);
+NVQM_API xint xint_sqrt(xint a);
+
+#ifdef NVQM_QUARTER_LUT
+NVQM_LUT xint xint_tan__qlut[XANG__LUT / 4 + 1];
+NVQM_LUT xint xint_tan__pole[16];
+static inline xint xint_tan__at(uint32_t i){
+	/* the low 26 bits are tan of the first quadrant, and the top bits are a correction of -16 to 15
+	 * (stored plus 16) for the mirrored entry
+	 * the mirror is too far off right past 90 degrees, so those entries are stored as they are */
+	if (i - XANG__LUT / 4 < 16)
+		return xint_tan__pole[i - XANG__LUT / 4];
+	uint32_t m = 0u - ((i / (XANG__LUT / 4)) & 1);
+	xint e = xint_tan__qlut[((i ^ m) - m) & (XANG__LUT / 2 - 1)];
+	uint32_t v = (uint32_t)(e & 0x3FFFFFF);
+	return (xint)(((v ^ m) - m) + (((uint32_t)(e >> 26) - 16) & m));
+}
+#else
+NVQM_LUT xint xint_tan__lut[XANG__LUT / 2];
+static inline xint xint_tan__at(uint32_t i){
+	return xint_tan__lut[i];
+}
+#endif
 
-extern const xint xint_tan__lut[XANG180];
 static inline xint xint_tan(xang a){
-	return xint_tan__lut[xang_wrap(a) >> 1];
+	/* not interpolated with NVQM_XANG16, since tan has no bound near 90 degrees */
+	return xint_tan__at(xang_wrap(a) >> (XANG__SHIFT + 1));
+}
+
+/*
+ * xlong
+ * like xint, results that don't fit wrap around
+ */
+
+static inline xlong xlong_fromxint(xint a){
+	return (xlong)a * XINT1;
+}
+
+static inline xint xlong_toxint(xlong a){
+	/* rounds down like xint_mul, and wraps if it doesn't fit */
+	return (xint)(uint32_t)(a >> 16);
+}
+
+static inline int xlong_toint(xlong a){
+	return (int)(a >> 32);
+}
+
+static inline xlong xlong_fromint(int a){
+	return (xlong)a * XLONG1;
+}
+
+static inline double xlong_todouble(xlong a){
+	return (double)a / (double)XLONG1;
+}
+
+static inline xlong xlong_fromdouble(double a){
+	return (xlong)round(a * (double)XLONG1);
+}
+
+static inline xlong xlong_add(xlong a, xlong b){
+	return (xlong)((uint64_t)a + (uint64_t)b);
+}
+
+static inline xlong xlong_sub(xlong a, xlong b){
+	return (xlong)((uint64_t)a - (uint64_t)b);
+}
+
+static inline xlong xlong_mul(xlong a, xlong b){
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef __int128 i128;
+	return (xlong)(uint64_t)(((i128)a * b) >> 32);
+#else
+	/* the middle of the 128 bit product, from the 32 bit halves, where a >> 32 keeps the sign */
+	int64_t ah = a >> 32, bh = b >> 32;
+	uint64_t al = (uint32_t)a, bl = (uint32_t)b;
+	return (xlong)(((uint64_t)(ah * bh) << 32) + (uint64_t)(ah * (int64_t)bl) +
+		(uint64_t)((int64_t)al * bh) + ((al * bl) >> 32));
+#endif
+}
+
+NVQM_API xlong xlong_div(xlong a, xlong b);
+NVQM_API xlong xlong_sqrt(xlong a); /* rounds down, and -sqrt(-a) for negative `a` like xint_sqrt */
+
+static inline xlong xlong__mul(xint a, xint b){
+	/* the exact product of two xints */
+	return (xlong)a * b;
+}
+
+static inline uint64_t xlong__sqdiff(xint a, xint b){
+	/* (a - b)^2 exactly, where the difference can need 33 bits, so it's squared unsigned */
+	uint64_t d = a < b ? (uint64_t)((int64_t)b - a) : (uint64_t)((int64_t)a - b);
+	return d * d;
 }
 
 /*
@@ -1307,32 +1735,32 @@ static inline xvec2 xvec2_add(xvec2 a, xvec2 b){
 static inline xvec2 xvec2_applymat2(xvec2 a, xmat2 b){
 	xint ax = a.v[0], ay = a.v[1];
 	return xvec2_new(
-		xint_add(xint_mul(b.v[0], ax), xint_mul(b.v[2], ay)),
-		xint_add(xint_mul(b.v[1], ax), xint_mul(b.v[3], ay))
+		xint_dot2(b.v[0], ax, b.v[2], ay),
+		xint_dot2(b.v[1], ax, b.v[3], ay)
 	);
 }
 
 static inline xvec2 xvec2_applymat3x2(xvec2 a, xmat3x2 b){
 	xint ax = a.v[0], ay = a.v[1];
 	return xvec2_new(
-		xint_add(xint_add(xint_mul(b.v[0], ax), xint_mul(b.v[2], ay)), b.v[4]),
-		xint_add(xint_add(xint_mul(b.v[1], ax), xint_mul(b.v[3], ay)), b.v[5])
+		xint_dot3(b.v[0], ax, b.v[2], ay, b.v[4], XINT1),
+		xint_dot3(b.v[1], ax, b.v[3], ay, b.v[5], XINT1)
 	);
 }
 
 static inline xvec2 xvec2_applymat3(xvec2 a, xmat3 *b){
 	xint ax = a.v[0], ay = a.v[1];
 	return xvec2_new(
-		xint_add(xint_add(xint_mul(b->v[0], ax), xint_mul(b->v[3], ay)), b->v[6]),
-		xint_add(xint_add(xint_mul(b->v[1], ax), xint_mul(b->v[4], ay)), b->v[7])
+		xint_dot3(b->v[0], ax, b->v[3], ay, b->v[6], XINT1),
+		xint_dot3(b->v[1], ax, b->v[4], ay, b->v[7], XINT1)
 	);
 }
 
 static inline xvec2 xvec2_applymat4(xvec2 a, xmat4 *b){
 	xint ax = a.v[0], ay = a.v[1];
 	return xvec2_new(
-		xint_add(xint_add(xint_mul(b->v[0], ax), xint_mul(b->v[4], ay)), b->v[12]),
-		xint_add(xint_add(xint_mul(b->v[1], ax), xint_mul(b->v[5], ay)), b->v[13])
+		xint_dot3(b->v[0], ax, b->v[4], ay, b->v[12], XINT1),
+		xint_dot3(b->v[1], ax, b->v[5], ay, b->v[13], XINT1)
 	);
 }
 
@@ -1350,19 +1778,31 @@ static inline xint xvec2_cross(xvec2 a, xvec2 b){
 static inline xint xvec2_len2(xvec2 a);
 static inline xvec2 xvec2_sub(xvec2 a, xvec2 b);
 static inline xint xvec2_dist(xvec2 a, xvec2 b){
-	return num_sqrt(xvec2_len2(xvec2_sub(a, b)));
+	return xint_sqrt(xvec2_len2(xvec2_sub(a, b)));
 }
 
 static inline xint xvec2_dist2(xvec2 a, xvec2 b){
 	return xvec2_len2(xvec2_sub(b, a));
 }
 
+static inline xlong xvec2_dist2l(xvec2 a, xvec2 b){
+	return (xlong)(xlong__sqdiff(a.v[0], b.v[0]) + xlong__sqdiff(a.v[1], b.v[1]));
+}
+
+static inline xlong xvec2_distl(xvec2 a, xvec2 b){
+	return xlong_sqrt(xvec2_dist2l(a, b));
+}
+
 static inline xvec2 xvec2_div(xvec2 a, xvec2 b){
 	return xvec2_new(xint_div(a.v[0], b.v[0]), xint_div(a.v[1], b.v[1]));
 }
 
 static inline xint xvec2_dot(xvec2 a, xvec2 b){
-	return xint_add(xint_mul(a.v[0], b.v[0]), xint_mul(a.v[1], b.v[1]));
+	return xint_dot2(a.v[0], b.v[0], a.v[1], b.v[1]);
+}
+
+static inline xlong xvec2_dotl(xvec2 a, xvec2 b){
+	return xlong_add(xlong__mul(a.v[0], b.v[0]), xlong__mul(a.v[1], b.v[1]));
 }
 
 static inline xvec2 xvec2_inverse(xvec2 a){
@@ -1370,7 +1810,7 @@ static inline xvec2 xvec2_inverse(xvec2 a){
 }
 
 static inline xint xvec2_len(xvec2 a){
-	return num_sqrt(xvec2_len2(a));
+	return xint_sqrt(xvec2_len2(a));
 }
 
 static inline xint xvec2_len2(xvec2 a){
@@ -1378,6 +1818,14 @@ static inline xint xvec2_len2(xvec2 a){
 	return xint_add(xint_mul(ax, ax), xint_mul(ay, ay));
 }
 
+static inline xlong xvec2_len2l(xvec2 a){
+	return xvec2_dotl(a, a);
+}
+
+static inline xlong xvec2_lenl(xvec2 a){
+	return xlong_sqrt(xvec2_len2l(a));
+}
+
 static inline xvec2 xvec2_lerp(xvec2 a, xvec2 b, xint t){
 	return xvec2_new(xint_lerp(a.v[0], b.v[0], t), xint_lerp(a.v[1], b.v[1], t));
 }
@@ -1402,7 +1850,7 @@ static inline xvec2 xvec2_normal(xvec2 a){
 	xint ax = a.v[0], ay = a.v[1],
 		len = xint_add(xint_mul(ax, ax), xint_mul(ay, ay));
 	if (len > 0){
-		len = xint_div(XINT1, xint_sqrt(len));
+		len = xint_rsqrt(len);
 		return xvec2_new(xint_mul(ax, len), xint_mul(ay, len));
 	}
 	return a;
@@ -1443,8 +1891,8 @@ static inline xint xvec3_angle(xvec3 a, xvec3 b){
 static inline xvec3 xvec3_applymat3x2(xvec3 a, xmat3x2 b){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2];
 	return xvec3_new(
-		xint_add(xint_add(xint_mul(ax, b.v[0]), xint_mul(ay, b.v[2])), xint_mul(az, b.v[4])),
-		xint_add(xint_add(xint_mul(ax, b.v[1]), xint_mul(ay, b.v[3])), xint_mul(az, b.v[5])),
+		xint_dot3(ax, b.v[0], ay, b.v[2], az, b.v[4]),
+		xint_dot3(ax, b.v[1], ay, b.v[3], az, b.v[5]),
 		az
 	);
 }
@@ -1452,44 +1900,23 @@ static inline xvec3 xvec3_applymat3x2(xvec3 a, xmat3x2 b){
 static inline xvec3 xvec3_applymat3(xvec3 a, xmat3 *b){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2];
 	return xvec3_new(
-		xint_add(xint_add(xint_mul(ax, b->v[0]), xint_mul(ay, b->v[3])), xint_mul(az, b->v[6])),
-		xint_add(xint_add(xint_mul(ax, b->v[1]), xint_mul(ay, b->v[4])), xint_mul(az, b->v[7])),
-		xint_add(xint_add(xint_mul(ax, b->v[2]), xint_mul(ay, b->v[5])), xint_mul(az, b->v[8]))
+		xint_dot3(ax, b->v[0], ay, b->v[3], az, b->v[6]),
+		xint_dot3(ax, b->v[1], ay, b->v[4], az, b->v[7]),
+		xint_dot3(ax, b->v[2], ay, b->v[5], az, b->v[8])
 	);
 }
 
 static inline xvec3 xvec3_applymat4(xvec3 a, xmat4 *b){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2];
-	xint w = xint_add(
-		xint_add(xint_mul(b->v[3], ax), xint_mul(b->v[7], ay)),
-		xint_add(xint_mul(b->v[11], az), b->v[15])
-	);
+	xint w = xint_dot4(b->v[3], ax, b->v[7], ay, b->v[11], az, b->v[15], XINT1);
 	if (w == 0)
 		w = XINT1;
 	else
 		w = xint_div(XINT1, w);
 	return xvec3_new(
-		xint_mul(w,
-			xint_add(xint_add(
-				xint_mul(b->v[ 0], ax),
-				xint_mul(b->v[ 4], ay)), xint_add(
-				xint_mul(b->v[ 8], az),
-				b->v[12]
-			))),
-		xint_mul(w,
-			xint_add(xint_add(
-				xint_mul(b->v[ 1], ax),
-				xint_mul(b->v[ 5], ay)), xint_add(
-				xint_mul(b->v[ 9], az),
-				b->v[13]
-			))),
-		xint_mul(w,
-			xint_add(xint_add(
-				xint_mul(b->v[ 2], ax),
-				xint_mul(b->v[ 6], ay)), xint_add(
-				xint_mul(b->v[10], az),
-				b->v[14]
-			)))
+		xint_mul(w, xint_dot4(b->v[ 0], ax, b->v[ 4], ay, b->v[ 8], az, b->v[12], XINT1)),
+		xint_mul(w, xint_dot4(b->v[ 1], ax, b->v[ 5], ay, b->v[ 9], az, b->v[13], XINT1)),
+		xint_mul(w, xint_dot4(b->v[ 2], ax, b->v[ 6], ay, b->v[10], az, b->v[14], XINT1))
 	);
 }
 
@@ -1541,13 +1968,26 @@ static inline xint xvec3_dist2(xvec3 a, xvec3 b){
 	return xvec3_len2(xvec3_sub(b, a));
 }
 
+static inline xlong xvec3_dist2l(xvec3 a, xvec3 b){
+	return (xlong)(xlong__sqdiff(a.v[0], b.v[0]) + xlong__sqdiff(a.v[1], b.v[1]) +
+		xlong__sqdiff(a.v[2], b.v[2]));
+}
+
+static inline xlong xvec3_distl(xvec3 a, xvec3 b){
+	return xlong_sqrt(xvec3_dist2l(a, b));
+}
+
 static inline xvec3 xvec3_div(xvec3 a, xvec3 b){
 	return xvec3_new(xint_div(a.v[0], b.v[0]), xint_div(a.v[1], b.v[1]), xint_div(a.v[2], b.v[2]));
 }
 
 static inline xint xvec3_dot(xvec3 a, xvec3 b){
-	return xint_add(xint_add(
-		xint_mul(a.v[0], b.v[0]), xint_mul(a.v[1], b.v[1])), xint_mul(a.v[2], b.v[2]));
+	return xint_dot3(a.v[0], b.v[0], a.v[1], b.v[1], a.v[2], b.v[2]);
+}
+
+static inline xlong xvec3_dotl(xvec3 a, xvec3 b){
+	return xlong_add(xlong_add(
+		xlong__mul(a.v[0], b.v[0]), xlong__mul(a.v[1], b.v[1])), xlong__mul(a.v[2], b.v[2]));
 }
 
 static inline xvec3 xvec3_inverse(xvec3 a){
@@ -1563,6 +2003,14 @@ static inline xint xvec3_len2(xvec3 a){
 	return xint_add(xint_add(xint_mul(ax, ax), xint_mul(ay, ay)), xint_mul(az, az));
 }
 
+static inline xlong xvec3_len2l(xvec3 a){
+	return xvec3_dotl(a, a);
+}
+
+static inline xlong xvec3_lenl(xvec3 a){
+	return xlong_sqrt(xvec3_len2l(a));
+}
+
 static inline xvec3 xvec3_lerp(xvec3 a, xvec3 b, xint t){
 	return xvec3_new(
 		xint_lerp(a.v[0], b.v[0], t),
@@ -1595,11 +2043,8 @@ static inline xvec3 xvec3_normal(xvec3 a){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2];
 	xint len = xint_add(xint_add(xint_mul(ax, ax), xint_mul(ay, ay)), xint_mul(az, az));
 	if (len > 0){
-		len = xint_sqrt(len);
-		if (len > 0){
-			len = xint_div(XINT1, len);
-			return xvec3_new(xint_mul(ax, len), xint_mul(ay, len), xint_mul(az, len));
-		}
+		len = xint_rsqrt(len);
+		return xvec3_new(xint_mul(ax, len), xint_mul(ay, len), xint_mul(az, len));
 	}
 	return a;
 }
@@ -1653,26 +2098,10 @@ static inline xvec4 xvec4_add(xvec4 a, xvec4 b){
 static inline xvec4 xvec4_applymat4(xvec4 a, xmat4 *b){
 	xint ax = a.v[0], ay = a.v[1], az = a.v[2], aw = a.v[3];
 	return xvec4_new(
-		xint_add(xint_add(xint_add(
-			xint_mul(b->v[ 0], ax),
-			xint_mul(b->v[ 4], ay)),
-			xint_mul(b->v[ 8], az)),
-			xint_mul(b->v[12], aw)),
-		xint_add(xint_add(xint_add(
-			xint_mul(b->v[ 1], ax),
-			xint_mul(b->v[ 5], ay)),
-			xint_mul(b->v[ 9], az)),
-			xint_mul(b->v[13], aw)),
-		xint_add(xint_add(xint_add(
-			xint_mul(b->v[ 2], ax),
-			xint_mul(b->v[ 6], ay)),
-			xint_mul(b->v[10], az)),
-			xint_mul(b->v[14], aw)),
-		xint_add(xint_add(xint_add(
-			xint_mul(b->v[ 3], ax),
-			xint_mul(b->v[ 7], ay)),
-			xint_mul(b->v[11], az)),
-			xint_mul(b->v[15], aw))
+		xint_dot4(b->v[ 0], ax, b->v[ 4], ay, b->v[ 8], az, b->v[12], aw),
+		xint_dot4(b->v[ 1], ax, b->v[ 5], ay, b->v[ 9], az, b->v[13], aw),
+		xint_dot4(b->v[ 2], ax, b->v[ 6], ay, b->v[10], az, b->v[14], aw),
+		xint_dot4(b->v[ 3], ax, b->v[ 7], ay, b->v[11], az, b->v[15], aw)
 	);
 }
 
@@ -1715,6 +2144,15 @@ static inline xint xvec4_dist2(xvec4 a, xvec4 b){
 	return xvec4_len2(xvec4_sub(b, a));
 }
 
+static inline xlong xvec4_dist2l(xvec4 a, xvec4 b){
+	return (xlong)(xlong__sqdiff(a.v[0], b.v[0]) + xlong__sqdiff(a.v[1], b.v[1]) +
+		xlong__sqdiff(a.v[2], b.v[2]) + xlong__sqdiff(a.v[3], b.v[3]));
+}
+
+static inline xlong xvec4_distl(xvec4 a, xvec4 b){
+	return xlong_sqrt(xvec4_dist2l(a, b));
+}
+
 static inline xvec4 xvec4_div(xvec4 a, xvec4 b){
 	return xvec4_new(
 		xint_div(a.v[0], b.v[0]),
@@ -1725,11 +2163,13 @@ static inline xvec4 xvec4_div(xvec4 a, xvec4 b){
 }
 
 static inline xint xvec4_dot(xvec4 a, xvec4 b){
-	return xint_add(xint_add(xint_add(
-		xint_mul(a.v[0], b.v[0]),
-		xint_mul(a.v[1], b.v[1])),
-		xint_mul(a.v[2], b.v[2])),
-		xint_mul(a.v[3], b.v[3]));
+	return xint_dot4(a.v[0], b.v[0], a.v[1], b.v[1], a.v[2], b.v[2], a.v[3], b.v[3]);
+}
+
+static inline xlong xvec4_dotl(xvec4 a, xvec4 b){
+	return xlong_add(xlong_add(xlong_add(
+		xlong__mul(a.v[0], b.v[0]), xlong__mul(a.v[1], b.v[1])), xlong__mul(a.v[2], b.v[2])),
+		xlong__mul(a.v[3], b.v[3]));
 }
 
 static inline xvec4 xvec4_inverse(xvec4 a){
@@ -1751,6 +2191,14 @@ static inline xint xvec4_len2(xvec4 a){
 		xint_mul(ax, ax), xint_mul(ay, ay)), xint_mul(az, az)), xint_mul(aw, aw));
 }
 
+static inline xlong xvec4_len2l(xvec4 a){
+	return xvec4_dotl(a, a);
+}
+
+static inline xlong xvec4_lenl(xvec4 a){
+	return xlong_sqrt(xvec4_len2l(a));
+}
+
 static inline xvec4 xvec4_lerp(xvec4 a, xvec4 b, xint t){
 	return xvec4_new(
 		xint_lerp(a.v[0], b.v[0], t),
@@ -1796,16 +2244,13 @@ static inline xvec4 xvec4_normal(xvec4 a){
 	xint len = xint_add(xint_add(xint_add(
 		xint_mul(ax, ax), xint_mul(ay, ay)), xint_mul(az, az)), xint_mul(aw, aw));
 	if (len > 0){
-		len = xint_sqrt(len);
-		if (len > 0){
-			len = xint_div(XINT1, len);
-			return xvec4_new(
-				xint_mul(ax, len),
-				xint_mul(ay, len),
-				xint_mul(az, len),
-				xint_mul(aw, len)
-			);
-		}
+		len = xint_rsqrt(len);
+		return xvec4_new(
+			xint_mul(ax, len),
+			xint_mul(ay, len),
+			xint_mul(az, len),
+			xint_mul(aw, len)
+		);
 	}
 	return a;
 }
@@ -1863,11 +2308,7 @@ static inline xquat xquat_between(xvec3 from, xvec3 to){
 }
 
 static inline xint xquat_dot(xquat a, xquat b){
-	return xint_add(xint_add(xint_add(
-		xint_mul(a.v[0], b.v[0]),
-		xint_mul(a.v[1], b.v[1])),
-		xint_mul(a.v[2], b.v[2])),
-		xint_mul(a.v[3], b.v[3]));
+	return xint_dot4(a.v[0], b.v[0], a.v[1], b.v[1], a.v[2], b.v[2], a.v[3], b.v[3]);
 }
 
 #define NVQM_XQUAT_EULER_ROT     \
@@ -2024,16 +2465,13 @@ static inline xquat xquat_normal(xquat a){
 	xint len = xint_add(xint_add(xint_add(
 		xint_mul(ax, ax), xint_mul(ay, ay)), xint_mul(az, az)), xint_mul(aw, aw));
 	if (len > 0){
-		len = xint_sqrt(len);
-		if (len > 0){
-			len = xint_div(XINT1, len);
-			return xquat_new(
-				xint_mul(ax, len),
-				xint_mul(ay, len),
-				xint_mul(az, len),
-				xint_mul(aw, len)
-			);
-		}
+		len = xint_rsqrt(len);
+		return xquat_new(
+			xint_mul(ax, len),
+			xint_mul(ay, len),
+			xint_mul(az, len),
+			xint_mul(aw, len)
+		);
 	}
 	return a;
 }
@@ -2119,6 +2557,10 @@ static inline xint xmat2_det(xmat2 a){
 	return xint_sub(xint_mul(a.v[0], a.v[3]), xint_mul(a.v[2], a.v[1]));
 }
 
+static inline xlong xmat2_detl(xmat2 a){
+	return xlong_sub(xlong__mul(a.v[0], a.v[3]), xlong__mul(a.v[2], a.v[1]));
+}
+
 static inline xmat2 xmat2_identity(){
 	return xmat2_new(XINT1, 0, 0, XINT1);
 }
@@ -2142,10 +2584,10 @@ static inline xmat2 xmat2_mul(xmat2 a, xmat2 b){
 		a0 = a.v[0], a1 = a.v[1], a2 = a.v[2], a3 = a.v[3],
 		b0 = b.v[0], b1 = b.v[1], b2 = b.v[2], b3 = b.v[3];
 	return xmat2_new(
-		xint_add(xint_mul(a0, b0), xint_mul(a2, b1)),
-		xint_add(xint_mul(a1, b0), xint_mul(a3, b1)),
-		xint_add(xint_mul(a0, b2), xint_mul(a2, b3)),
-		xint_add(xint_mul(a1, b2), xint_mul(a3, b3))
+		xint_dot2(a0, b0, a2, b1),
+		xint_dot2(a1, b0, a3, b1),
+		xint_dot2(a0, b2, a2, b3),
+		xint_dot2(a1, b2, a3, b3)
 	);
 }
 
@@ -2245,7 +2687,7 @@ static inline xmat3x2 xmat3x2_invert(xmat3x2 a){
 		a00 = a.v[0], a01 = a.v[1],
 		a10 = a.v[2], a11 = a.v[3],
 		a20 = a.v[4], a21 = a.v[5];
-	xint det = a00 * a11 - a01 * a10;
+	xint det = xint_sub(xint_mul(a00, a11), xint_mul(a01, a10));
 	if (det == 0)
 		return xmat3x2_new(0, 0, 0, 0, 0, 0);
 	det = xint_div(XINT1, det);
@@ -2266,12 +2708,12 @@ static inline xmat3x2 xmat3x2_mul(xmat3x2 a, xmat3x2 b){
 		b10 = b.v[2], b11 = b.v[3],
 		b20 = b.v[4], b21 = b.v[5];
 	return xmat3x2_new(
-		xint_add(xint_mul(b00, a00), xint_mul(b01, a10)),
-		xint_add(xint_mul(b00, a01), xint_mul(b01, a11)),
-		xint_add(xint_mul(b10, a00), xint_mul(b11, a10)),
-		xint_add(xint_mul(b10, a01), xint_mul(b11, a11)),
-		xint_add(xint_add(xint_mul(b20, a00), xint_mul(b21, a10)), a20),
-		xint_add(xint_add(xint_mul(b20, a01), xint_mul(b21, a11)), a21)
+		xint_dot2(b00, a00, b01, a10),
+		xint_dot2(b00, a01, b01, a11),
+		xint_dot2(b10, a00, b11, a10),
+		xint_dot2(b10, a01, b11, a11),
+		xint_dot3(b20, a00, b21, a10, a20, XINT1),
+		xint_dot3(b20, a01, b21, a11, a21, XINT1)
 	);
 }
 
@@ -2334,52 +2776,72 @@ static inline xmat3x2 xmat3x2_translation(xvec2 a){
  * xmat3
  */
 
-xmat3 *xmat3_add        (xmat3 *out, xmat3 *a, xmat3 *b);
-xmat3 *xmat3_adjoint    (xmat3 *out, xmat3 *a);
-xmat3 *xmat3_compmul    (xmat3 *out, xmat3 *a, xmat3 *b);
-xmat3 *xmat3_copy       (xmat3 *out, xmat3 *a);
-xint   xmat3_det        (xmat3 *a);
-xmat3 *xmat3_identity   (xmat3 *out);
-xmat3 *xmat3_invert     (xmat3 *out, xmat3 *a);
-xmat3 *xmat3_mul        (xmat3 *out, xmat3 *a, xmat3 *b);
-xmat3 *xmat3_quat       (xmat3 *out, xquat a);
-xmat3 *xmat3_rotate     (xmat3 *out, xmat3 *a, xang ang);
-xmat3 *xmat3_rotation   (xmat3 *out, xang ang);
-xmat3 *xmat3_scale      (xmat3 *out, xmat3 *a, xvec2 b);
-xmat3 *xmat3_scaling    (xmat3 *out, xvec2 a);
-xmat3 *xmat3_sub        (xmat3 *out, xmat3 *a, xmat3 *b);
-xmat3 *xmat3_translate  (xmat3 *out, xmat3 *a, xvec2 b);
-xmat3 *xmat3_translation(xmat3 *out, xvec2 a);
-xmat3 *xmat3_transpose  (xmat3 *out, xmat3 *a);
+NVQM_API xmat3 *xmat3_add        (xmat3 *out, xmat3 *a, xmat3 *b);
+NVQM_API xmat3 *xmat3_adjoint    (xmat3 *out, xmat3 *a);
+NVQM_API xmat3 *xmat3_compmul    (xmat3 *out, xmat3 *a, xmat3 *b);
+NVQM_API xmat3 *xmat3_copy       (xmat3 *out, xmat3 *a);
+NVQM_API xint   xmat3_det        (xmat3 *a);
+NVQM_API xlong  xmat3_detl       (xmat3 *a);
+NVQM_API xmat3 *xmat3_identity   (xmat3 *out);
+NVQM_API xmat3 *xmat3_invert     (xmat3 *out, xmat3 *a);
+NVQM_API xmat3 *xmat3_mul        (xmat3 *out, xmat3 *a, xmat3 *b);
+NVQM_API xmat3 *xmat3_quat       (xmat3 *out, xquat a);
+NVQM_API xmat3 *xmat3_rotate     (xmat3 *out, xmat3 *a, xang ang);
+NVQM_API xmat3 *xmat3_rotation   (xmat3 *out, xang ang);
+NVQM_API xmat3 *xmat3_scale      (xmat3 *out, xmat3 *a, xvec2 b);
+NVQM_API xmat3 *xmat3_scaling    (xmat3 *out, xvec2 a);
+NVQM_API xmat3 *xmat3_sub        (xmat3 *out, xmat3 *a, xmat3 *b);
+NVQM_API xmat3 *xmat3_translate  (xmat3 *out, xmat3 *a, xvec2 b);
+NVQM_API xmat3 *xmat3_translation(xmat3 *out, xvec2 a);
+NVQM_API xmat3 *xmat3_transpose  (xmat3 *out, xmat3 *a);
 
 /*
  * xmat4
  */
 
-xmat4 *xmat4_add           (xmat4 *out, xmat4 *a, xmat4 *b);
-xmat4 *xmat4_adjoint       (xmat4 *out, xmat4 *a);
-xmat4 *xmat4_compmul       (xmat4 *out, xmat4 *a, xmat4 *b);
-xmat4 *xmat4_copy          (xmat4 *out, xmat4 *a);
-xint   xmat4_det           (xmat4 *a);
-xmat4 *xmat4_frustum       (xmat4 *out, xint L, xint R, xint B, xint T, xint N, xint F);
-xmat4 *xmat4_identity      (xmat4 *out);
-xmat4 *xmat4_invert        (xmat4 *out, xmat4 *a);
-xmat4 *xmat4_lookat        (xmat4 *out, xvec3 eye, xvec3 position, xvec3 up);
-xmat4 *xmat4_mul           (xmat4 *out, xmat4 *a, xmat4 *b);
-xmat4 *xmat4_orthogonal    (xmat4 *out, xint W, xint H, xint N, xint F);
-xmat4 *xmat4_perspective   (xmat4 *out, xang fov, xint W, xint H, xint N, xint F);
-xmat4 *xmat4_quat          (xmat4 *out, xquat a);
-xmat4 *xmat4_rotate        (xmat4 *out, xmat4 *a, xvec3 axis, xang ang);
-xmat4 *xmat4_rotation      (xmat4 *out, xvec3 axis, xang ang);
-xmat4 *xmat4_rottrans      (xmat4 *out, xquat a, xvec3 b);
-xmat4 *xmat4_rottransorigin(xmat4 *out, xquat a, xvec3 b, xvec3 origin);
-xmat4 *xmat4_scale         (xmat4 *out, xmat4 *a, xvec3 b);
-xmat4 *xmat4_scaling       (xmat4 *out, xvec3 a);
-xmat4 *xmat4_sub           (xmat4 *out, xmat4 *a, xmat4 *b);
-xmat4 *xmat4_translate     (xmat4 *out, xmat4 *a, xvec3 b);
-xmat4 *xmat4_translation   (xmat4 *out, xvec3 a);
-xmat4 *xmat4_transpose     (xmat4 *out, xmat4 *a);
+NVQM_API xmat4 *xmat4_add           (xmat4 *out, xmat4 *a, xmat4 *b);
+NVQM_API xmat4 *xmat4_adjoint       (xmat4 *out, xmat4 *a);
+NVQM_API xmat4 *xmat4_compmul       (xmat4 *out, xmat4 *a, xmat4 *b);
+NVQM_API xmat4 *xmat4_copy          (xmat4 *out, xmat4 *a);
+NVQM_API xint   xmat4_det           (xmat4 *a);
+NVQM_API xlong  xmat4_detl          (xmat4 *a);
+NVQM_API xmat4 *xmat4_frustum       (xmat4 *out, xint L, xint R, xint B, xint T, xint N, xint F);
+NVQM_API xmat4 *xmat4_identity      (xmat4 *out);
+NVQM_API xmat4 *xmat4_invert        (xmat4 *out, xmat4 *a);
+NVQM_API xmat4 *xmat4_lookat        (xmat4 *out, xvec3 eye, xvec3 position, xvec3 up);
+NVQM_API xmat4 *xmat4_mul           (xmat4 *out, xmat4 *a, xmat4 *b);
+NVQM_API xmat4 *xmat4_orthogonal    (xmat4 *out, xint W, xint H, xint N, xint F);
+NVQM_API xmat4 *xmat4_perspective   (xmat4 *out, xang fov, xint W, xint H, xint N, xint F);
+NVQM_API xmat4 *xmat4_quat          (xmat4 *out, xquat a);
+NVQM_API xmat4 *xmat4_rotate        (xmat4 *out, xmat4 *a, xvec3 axis, xang ang);
+NVQM_API xmat4 *xmat4_rotation      (xmat4 *out, xvec3 axis, xang ang);
+NVQM_API xmat4 *xmat4_rottrans      (xmat4 *out, xquat a, xvec3 b);
+NVQM_API xmat4 *xmat4_rottransorigin(xmat4 *out, xquat a, xvec3 b, xvec3 origin);
+NVQM_API xmat4 *xmat4_scale         (xmat4 *out, xmat4 *a, xvec3 b);
+NVQM_API xmat4 *xmat4_scaling       (xmat4 *out, xvec3 a);
+NVQM_API xmat4 *xmat4_sub           (xmat4 *out, xmat4 *a, xmat4 *b);
+NVQM_API xmat4 *xmat4_translate     (xmat4 *out, xmat4 *a, xvec3 b);
+NVQM_API xmat4 *xmat4_translation   (xmat4 *out, xvec3 a);
+NVQM_API xmat4 *xmat4_transpose     (xmat4 *out, xmat4 *a);
+
+/*
+ * xarrays
+ * operate on `n` contiguous elements, and `out` can be the same pointer as the input
+ */
+
+NVQM_API xint  *xint_div_array        (xint *out, xint *a, xint b, size_t n);
+NVQM_API xvec3 *xvec3_add_array       (xvec3 *out, xvec3 *a, xvec3 *b, size_t n);
+NVQM_API xvec3 *xvec3_applyquat_array (xvec3 *out, xvec3 *a, xquat b, size_t n);
+NVQM_API xvec3 *xvec3_applyquatv_array(xvec3 *out, xvec3 *a, xquat *b, size_t n); /* b per element */
+NVQM_API xvec3 *xvec3_divs_array      (xvec3 *out, xvec3 *a, xint s, size_t n); /* a / s */
+NVQM_API xvec3 *xvec3_scale_array     (xvec3 *out, xvec3 *a, xint s, size_t n);
+NVQM_API xvec3 *xvec3_sub_array       (xvec3 *out, xvec3 *a, xvec3 *b, size_t n);
+NVQM_API xquat *xquat_mul_array       (xquat *out, xquat *a, xquat *b, size_t n);
 
 #endif /* NVQM_SKIP_FIXED_POINT */
 
+#if defined(NVQM_INLINE_ALL) || defined(NVQM_IMPLEMENTATION)
+#	include "nvqm.c"
+#endif
+
 #endif /* NVQM__H */
@@ -1380,6 +1380,91 @@ export namespace mat4 {
 		return out;
 	}
 
+	export function invert_affine(out: mat4, a: mat4): mat4 {
+		let
+			a00 = a[ 0], a01 = a[ 1], a02 = a[ 2],
+			a10 = a[ 4], a11 = a[ 5], a12 = a[ 6],
+			a20 = a[ 8], a21 = a[ 9], a22 = a[10],
+			a30 = a[12], a31 = a[13], a32 = a[14],
+			b01 =  a22 * a11 - a12 * a21,
+			b11 = -a22 * a10 + a12 * a20,
+			b21 =  a21 * a10 - a11 * a20;
+		let det = a00 * b01 + a01 * b11 + a02 * b21;
+		if (det == 0)
+			throw new Error('Cannot invert mat4');
+		det = 1 / det;
+		let
+			c00 =   b01                    * det,
+			c01 = (-a22 * a01 + a02 * a21) * det,
+			c02 = ( a12 * a01 - a02 * a11) * det,
+			c10 =   b11                    * det,
+			c11 = ( a22 * a00 - a02 * a20) * det,
+			c12 = (-a12 * a00 + a02 * a10) * det,
+			c20 =   b21                    * det,
+			c21 = (-a21 * a00 + a01 * a20) * det,
+			c22 = ( a11 * a00 - a01 * a10) * det;
+		out[ 0] = c00;
+		out[ 1] = c01;
+		out[ 2] = c02;
+		out[ 3] = 0;
+		out[ 4] = c10;
+		out[ 5] = c11;
+		out[ 6] = c12;
+		out[ 7] = 0;
+		out[ 8] = c20;
+		out[ 9] = c21;
+		out[10] = c22;
+		out[11] = 0;
+		out[12] = -(c00 * a30 + c10 * a31 + c20 * a32);
+		out[13] = -(c01 * a30 + c11 * a31 + c21 * a32);
+		out[14] = -(c02 * a30 + c12 * a31 + c22 * a32);
+		out[15] = 1;
+		return out;
+	}
+
+	export function invert_fast(out: mat4, a: mat4): mat4 {
+		if (a[3] != 0 || a[7] != 0 || a[11] != 0 || a[15] != 1)
+			return invert(out, a);
+		let
+			a00 = a[0], a01 = a[1], a02 = a[ 2],
+			a10 = a[4], a11 = a[5], a12 = a[ 6],
+			a20 = a[8], a21 = a[9], a22 = a[10],
+			d0 = a00 * a00 + a01 * a01 + a02 * a02 - 1,
+			d1 = a10 * a10 + a11 * a11 + a12 * a12 - 1,
+			d2 = a20 * a20 + a21 * a21 + a22 * a22 - 1,
+			d3 = a00 * a10 + a01 * a11 + a02 * a12,
+			d4 = a00 * a20 + a01 * a21 + a02 * a22,
+			d5 = a10 * a20 + a11 * a21 + a12 * a22;
+		if (d0 * d0 + d1 * d1 + d2 * d2 + d3 * d3 + d4 * d4 + d5 * d5 < 1e-10)
+			return invert_rigid(out, a);
+		return invert_affine(out, a);
+	}
+
+	export function invert_rigid(out: mat4, a: mat4): mat4 {
+		let
+			a00 = a[ 0], a01 = a[ 1], a02 = a[ 2],
+			a10 = a[ 4], a11 = a[ 5], a12 = a[ 6],
+			a20 = a[ 8], a21 = a[ 9], a22 = a[10],
+			a30 = a[12], a31 = a[13], a32 = a[14];
+		out[ 0] = a00;
+		out[ 1] = a10;
+		out[ 2] = a20;
+		out[ 3] = 0;
+		out[ 4] = a01;
+		out[ 5] = a11;
+		out[ 6] = a21;
+		out[ 7] = 0;
+		out[ 8] = a02;
+		out[ 9] = a12;
+		out[10] = a22;
+		out[11] = 0;
+		out[12] = -(a00 * a30 + a01 * a31 + a02 * a32);
+		out[13] = -(a10 * a30 + a11 * a31 + a12 * a32);
+		out[14] = -(a20 * a30 + a21 * a31 + a22 * a32);
+		out[15] = 1;
+		return out;
+	}
+
 	export function lookat(out: mat4, eye: vec3, position: vec3, up: vec3): mat4 {
 		let
 			ex = eye[0], ey = eye[1], ez = eye[2],
@@ -1491,6 +1576,44 @@ export namespace mat4 {
 		return out;
 	}
 
+	export function mul_affine(out: mat4, a: mat4, b: mat4): mat4 {
+		let
+			a00 = a[ 0], a01 = a[ 1], a02 = a[ 2],
+			a10 = a[ 4], a11 = a[ 5], a12 = a[ 6],
+			a20 = a[ 8], a21 = a[ 9], a22 = a[10],
+			a30 = a[12], a31 = a[13], a32 = a[14];
+		let b0, b1, b2;
+		b0 = b[ 0];
+		b1 = b[ 1];
+		b2 = b[ 2];
+		out[ 0] = b0 * a00 + b1 * a10 + b2 * a20;
+		out[ 1] = b0 * a01 + b1 * a11 + b2 * a21;
+		out[ 2] = b0 * a02 + b1 * a12 + b2 * a22;
+		out[ 3] = 0;
+		b0 = b[ 4];
+		b1 = b[ 5];
+		b2 = b[ 6];
+		out[ 4] = b0 * a00 + b1 * a10 + b2 * a20;
+		out[ 5] = b0 * a01 + b1 * a11 + b2 * a21;
+		out[ 6] = b0 * a02 + b1 * a12 + b2 * a22;
+		out[ 7] = 0;
+		b0 = b[ 8];
+		b1 = b[ 9];
+		b2 = b[10];
+		out[ 8] = b0 * a00 + b1 * a10 + b2 * a20;
+		out[ 9] = b0 * a01 + b1 * a11 + b2 * a21;
+		out[10] = b0 * a02 + b1 * a12 + b2 * a22;
+		out[11] = 0;
+		b0 = b[12];
+		b1 = b[13];
+		b2 = b[14];
+		out[12] = b0 * a00 + b1 * a10 + b2 * a20 + a30;
+		out[13] = b0 * a01 + b1 * a11 + b2 * a21 + a31;
+		out[14] = b0 * a02 + b1 * a12 + b2 * a22 + a32;
+		out[15] = 1;
+		return out;
+	}
+
 	export function orthogonal(out: mat4, W: number, H: number, N: number, F: number): mat4 {
 		let nf = 1 / (N - F);
 		out[ 0] = 2 / W;
@@ -0,0 +1,54 @@
+// (c) Copyright 2017, Sean Connelly (@voidqk), http://syntheti.cc
+// MIT License
+// Project Home: https://github.com/voidqk/nvqm
+
+//
+// Reference versions of library functions that have been replaced, shared by test.c and bench.c so
+// the accuracy checks and the speed comparisons use the same code
+//
+
+#ifndef NVQM_REF__H
+#define NVQM_REF__H
+
+#include "nvqm.h"
+
+static xint ref_xint_sqrt(xint a){
+	// the original bitwise search, which xint_sqrt must still match (test chk_sqrt), and is timed
+	// against it (bench sqrt)
+	if (a < 0)
+		return -ref_xint_sqrt(-a);
+	xint res = 0;
+	xint res2, m;
+	#define X(b)                  \
+		res2 = res | b;           \
+		m = xint_mul(res2, res2); \
+		if (m >= 0 && m < a)      \
+			res = res2;
+	X(0x00800000);
+	X(0x00400000);
+	X(0x00200000);
+	X(0x00100000);
+	X(0x00080000);
+	X(0x00040000);
+	X(0x00020000);
+	X(0x00010000);
+	X(0x00008000);
+	X(0x00004000);
+	X(0x00002000);
+	X(0x00001000);
+	X(0x00000800);
+	X(0x00000400);
+	X(0x00000200);
+	X(0x00000100);
+	X(0x00000080);
+	X(0x00000040);
+	X(0x00000010);
+	X(0x00000008);
+	X(0x00000004);
+	X(0x00000002);
+	X(0x00000001);
+	#undef X
+	return res;
+}
+
+#endif // NVQM_REF__H
@@ -4,6 +4,8 @@
 
 #include "sink_vqm.h"
 #include "nvqm.h"
+#include <stdlib.h>
+#include <string.h>
 
 #define FUNCS(P0, P1, P2, P3, P4, P5, P6, P7)                                                  \
 	P2("vec2.add"           , vec2  , vec2_add           , vec2, vec2                        ) \
@@ -140,8 +142,12 @@
 	P7("mat4.frustum"       , mat4  , mat4_frustum       , mat4, num, num, num, num, num, num) \
 	P1("mat4.identity"      , mat4  , mat4_identity      , mat4                              ) \
 	P2("mat4.invert"        , mat4  , mat4_invert        , mat4, mat4                        ) \
+	P2("mat4.invert_affine" , mat4  , mat4_invert_affine , mat4, mat4                        ) \
+	P2("mat4.invert_fast"   , mat4  , mat4_invert_fast   , mat4, mat4                        ) \
+	P2("mat4.invert_rigid"  , mat4  , mat4_invert_rigid  , mat4, mat4                        ) \
 	P4("mat4.lookat"        , mat4  , mat4_lookat        , mat4, vec3, vec3, vec3            ) \
 	P3("mat4.mul"           , mat4  , mat4_mul           , mat4, mat4, mat4                  ) \
+	P3("mat4.mul_affine"    , mat4  , mat4_mul_affine    , mat4, mat4, mat4                  ) \
 	P5("mat4.orthogonal"    , mat4  , mat4_orthogonal    , mat4, num, num, num, num          ) \
 	P6("mat4.perspective"   , mat4  , mat4_perspective   , mat4, num, num, num, num, num     ) \
 	P2("mat4.quat"          , mat4  , mat4_quat          , mat4, quat                        ) \
@@ -156,41 +162,74 @@
 	P2("mat4.translation"   , mat4  , mat4_translation   , mat4, vec3                        ) \
 	P2("mat4.transpose"     , mat4  , mat4_transpose     , mat4, mat4                        )
 
+// batches take lists of values, and are type-checked and converted once for the whole list
+#define BATCHES(B)                                               \
+	B("vec3.applymat4_all"  , vec3_applymat4_all                ) \
+	B("quat.slerp_all"      , quat_slerp_all                    )
+
+// handles keep a native mat3, mat4, or quat in C memory, and can be passed anywhere a value of its
+// type is expected, so chains of functions don't convert to and from lists at every step
+#define HANDLES(B)                                               \
+	B("mat3.new"            , mat3_new                          ) \
+	B("mat3.import"         , mat3_import                       ) \
+	B("mat3.export"         , mat3_export                       ) \
+	B("mat4.new"            , mat4_new                          ) \
+	B("mat4.import"         , mat4_import                       ) \
+	B("mat4.export"         , mat4_export                       ) \
+	B("quat.new"            , quat_new                          ) \
+	B("quat.import"         , quat_import                       ) \
+	B("quat.export"         , quat_export                       )
+
+// state kept for each context by sink_vqm_ctx, and passed to every native as its `nuser`
+typedef struct {
+	sink_user mat3_type, mat4_type, quat_type; // user types of the handles
+	void *scratch_ptr[3];                      // scratch space for batches, see scratch()
+	size_t scratch_size[3];
+} vqm_st, *vqm;
+
 #define FUNC(F, R) \
 	static sink_val L_ ## F(sink_ctx ctx, int size, sink_val *args, void *nuser){ \
+		vqm vq = nuser;                                                           \
 		return R;                                                                 \
 	}
 
-static inline sink_val return_num(sink_ctx tx, float a, sink_val d){
+// true when `d` is a list of at least `n` values that can be written over, and not a handle
+static inline bool is_out(sink_ctx ctx, vqm vq, sink_val d, int n){
+	return sink_islist(d) && !sink_isuser(ctx, d, vq->mat3_type) &&
+		!sink_isuser(ctx, d, vq->mat4_type) && !sink_isuser(ctx, d, vq->quat_type) &&
+		sink_castlist(ctx, d)->size >= n;
+}
+
+static inline sink_val return_num(sink_ctx tx, vqm vq, float a, sink_val d){
 	return sink_num(a);
 }
 
-static inline sink_val return_vec2(sink_ctx ctx, vec2 a, sink_val d){
+static inline sink_val return_vec2(sink_ctx ctx, vqm vq, vec2 a, sink_val d){
 	sink_val v[2] = { sink_num(a.v[0]), sink_num(a.v[1]) };
 	return sink_list_newblob(ctx, 2, v);
 }
 
-static inline sink_val return_vec3(sink_ctx ctx, vec3 a, sink_val d){
+static inline sink_val return_vec3(sink_ctx ctx, vqm vq, vec3 a, sink_val d){
 	sink_val v[3] = { sink_num(a.v[0]), sink_num(a.v[1]), sink_num(a.v[2]) };
 	return sink_list_newblob(ctx, 3, v);
 }
 
-static inline sink_val return_vec4(sink_ctx ctx, vec4 a, sink_val d){
+static inline sink_val return_vec4(sink_ctx ctx, vqm vq, vec4 a, sink_val d){
 	sink_val v[4] = { sink_num(a.v[0]), sink_num(a.v[1]), sink_num(a.v[2]), sink_num(a.v[3]) };
 	return sink_list_newblob(ctx, 4, v);
 }
 
-static inline sink_val return_quat(sink_ctx ctx, quat a, sink_val d){
+static inline sink_val return_quat(sink_ctx ctx, vqm vq, quat a, sink_val d){
 	sink_val v[4] = { sink_num(a.v[0]), sink_num(a.v[1]), sink_num(a.v[2]), sink_num(a.v[3]) };
 	return sink_list_newblob(ctx, 4, v);
 }
 
-static inline sink_val return_mat2(sink_ctx ctx, mat2 a, sink_val d){
+static inline sink_val return_mat2(sink_ctx ctx, vqm vq, mat2 a, sink_val d){
 	sink_val v[4] = { sink_num(a.v[0]), sink_num(a.v[1]), sink_num(a.v[2]), sink_num(a.v[3]) };
 	return sink_list_newblob(ctx, 4, v);
 }
 
-static inline sink_val return_mat3x2(sink_ctx ctx, mat3x2 a, sink_val d){
+static inline sink_val return_mat3x2(sink_ctx ctx, vqm vq, mat3x2 a, sink_val d){
 	sink_val v[6] = {
 		sink_num(a.v[0]), sink_num(a.v[1]),
 		sink_num(a.v[2]), sink_num(a.v[3]),
@@ -199,7 +238,15 @@ static inline sink_val return_mat3x2(sink_ctx ctx, mat3x2 a, sink_val d){
 	return sink_list_newblob(ctx, 6, v);
 }
 
-static inline sink_val return_mat3(sink_ctx ctx, mat3 *a, sink_val d){
+static inline sink_val return_mat3(sink_ctx ctx, vqm vq, mat3 *a, sink_val d){
+	if (sink_isuser(ctx, d, vq->mat3_type)){
+		*(mat3 *)sink_list_getuser(ctx, d) = *a;
+		return d;
+	}
+	if (!is_out(ctx, vq, d, 9)){
+		sink_abortcstr(ctx, "Expecting mat3");
+		return SINK_NIL;
+	}
 	sink_list ls = sink_castlist(ctx, d);
 	ls->vals[0] = sink_num(a->v[0]);
 	ls->vals[1] = sink_num(a->v[1]);
@@ -213,7 +260,15 @@ static inline sink_val return_mat3(sink_ctx ctx, mat3 *a, sink_val d){
 	return d;
 }
 
-static inline sink_val return_mat4(sink_ctx ctx, mat4 *a, sink_val d){
+static inline sink_val return_mat4(sink_ctx ctx, vqm vq, mat4 *a, sink_val d){
+	if (sink_isuser(ctx, d, vq->mat4_type)){
+		*(mat4 *)sink_list_getuser(ctx, d) = *a;
+		return d;
+	}
+	if (!is_out(ctx, vq, d, 16)){
+		sink_abortcstr(ctx, "Expecting mat4");
+		return SINK_NIL;
+	}
 	sink_list ls = sink_castlist(ctx, d);
 	ls->vals[0] = sink_num(a->v[0]);
 	ls->vals[1] = sink_num(a->v[1]);
@@ -234,7 +289,7 @@ static inline sink_val return_mat4(sink_ctx ctx, mat4 *a, sink_val d){
 	return d;
 }
 
-static inline float fix_num(sink_ctx ctx, sink_val a){
+static inline float fix_num(sink_ctx ctx, vqm vq, sink_val a){
 	if (!sink_isnum(a)){
 		sink_abortcstr(ctx, "Expecting num");
 		return 0;
@@ -242,7 +297,7 @@ static inline float fix_num(sink_ctx ctx, sink_val a){
 	return sink_castnum(a);
 }
 
-static inline vec2 fix_vec2(sink_ctx ctx, sink_val a){
+static inline vec2 fix_vec2(sink_ctx ctx, vqm vq, sink_val a){
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting vec2");
 		return (vec2){ 0, 0 };
@@ -259,7 +314,7 @@ static inline vec2 fix_vec2(sink_ctx ctx, sink_val a){
 	return (vec2){ sink_castnum(ls->vals[0]), sink_castnum(ls->vals[1]) };
 }
 
-static inline vec3 fix_vec3(sink_ctx ctx, sink_val a){
+static inline vec3 fix_vec3(sink_ctx ctx, vqm vq, sink_val a){
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting vec3");
 		return (vec3){ 0, 0, 0 };
@@ -276,7 +331,7 @@ static inline vec3 fix_vec3(sink_ctx ctx, sink_val a){
 	return (vec3){ sink_castnum(ls->vals[0]), sink_castnum(ls->vals[1]), sink_castnum(ls->vals[2]) };
 }
 
-static inline vec4 fix_vec4(sink_ctx ctx, sink_val a){
+static inline vec4 fix_vec4(sink_ctx ctx, vqm vq, sink_val a){
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting vec4");
 		return (vec4){ 0, 0, 0, 0 };
@@ -295,7 +350,9 @@ static inline vec4 fix_vec4(sink_ctx ctx, sink_val a){
 		sink_castnum(ls->vals[3]) };
 }
 
-static inline quat fix_quat(sink_ctx ctx, sink_val a){
+static inline quat fix_quat(sink_ctx ctx, vqm vq, sink_val a){
+	if (sink_isuser(ctx, a, vq->quat_type))
+		return *(quat *)sink_list_getuser(ctx, a);
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting quat");
 		return (quat){ 0, 0, 0, 0 };
@@ -314,7 +371,7 @@ static inline quat fix_quat(sink_ctx ctx, sink_val a){
 		sink_castnum(ls->vals[3]) };
 }
 
-static inline mat2 fix_mat2(sink_ctx ctx, sink_val a){
+static inline mat2 fix_mat2(sink_ctx ctx, vqm vq, sink_val a){
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting mat2");
 		return (mat2){ 0, 0, 0, 0 };
@@ -333,7 +390,7 @@ static inline mat2 fix_mat2(sink_ctx ctx, sink_val a){
 		sink_castnum(ls->vals[3]) };
 }
 
-static inline mat3x2 fix_mat3x2(sink_ctx ctx, sink_val a){
+static inline mat3x2 fix_mat3x2(sink_ctx ctx, vqm vq, sink_val a){
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting mat3x2");
 		return (mat3x2){ 0, 0, 0, 0, 0, 0 };
@@ -361,7 +418,13 @@ static inline mat3 *next_mat3(float a, float b, float c, float d, float e, float
 	return &mat3_cache[mat3_next];
 }
 
-static inline mat3 *fix_mat3(sink_ctx ctx, sink_val a){
+static inline mat3 *fix_mat3(sink_ctx ctx, vqm vq, sink_val a){
+	if (sink_isuser(ctx, a, vq->mat3_type)){
+		// copied like lists are, so `out` can be the same handle as an input
+		mat3_next = (mat3_next + 1) % 4;
+		mat3_cache[mat3_next] = *(mat3 *)sink_list_getuser(ctx, a);
+		return &mat3_cache[mat3_next];
+	}
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting mat3");
 		return next_mat3(0, 0, 0, 0, 0, 0, 0, 0, 0);
@@ -391,7 +454,13 @@ static inline mat4 *next_mat4(float a, float b, float c, float d, float e, float
 	return &mat4_cache[mat4_next];
 }
 
-static inline mat4 *fix_mat4(sink_ctx ctx, sink_val a){
+static inline mat4 *fix_mat4(sink_ctx ctx, vqm vq, sink_val a){
+	if (sink_isuser(ctx, a, vq->mat4_type)){
+		// copied like lists are, so `out` can be the same handle as an input
+		mat4_next = (mat4_next + 1) % 4;
+		mat4_cache[mat4_next] = *(mat4 *)sink_list_getuser(ctx, a);
+		return &mat4_cache[mat4_next];
+	}
 	if (!sink_islist(a)){
 		sink_abortcstr(ctx, "Expecting mat4");
 		return next_mat4(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
@@ -427,43 +496,46 @@ static inline bool check_args(sink_ctx ctx, int req, int actual, const char *err
 }
 
 #define P0(N, R, F) \
-	FUNC(F, return_ ## R(ctx, F(), SINK_NIL))
+	FUNC(F, return_ ## R(ctx, vq, F(), SINK_NIL))
 
 #define P1(N, R, F, T1) \
 	FUNC(F, check_args(ctx, 1, size, "Expecting " #T1) ? \
-		return_ ## R(ctx, F(fix_ ## T1(ctx, args[0])), args[0]) : SINK_NIL)
+		return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0])), args[0]) : SINK_NIL)
 
 #define P2(N, R, F, T1, T2) \
 	FUNC(F, check_args(ctx, 2, size, "Expecting " #T1 ", " #T2) ? \
-		return_ ## R(ctx, F(fix_ ## T1(ctx, args[0]), fix_ ## T2(ctx, args[1])), args[0]) : SINK_NIL)
+		return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0]), fix_ ## T2(ctx, vq, args[1])), \
+			args[0]) : SINK_NIL)
 
 #define P3(N, R, F, T1, T2, T3) \
 	FUNC(F, check_args(ctx, 3, size, "Expecting " #T1 ", " #T2 ", " #T3) ? \
-		return_ ## R(ctx, F(fix_ ## T1(ctx, args[0]), fix_ ## T2(ctx, args[1]), \
-			fix_ ## T3(ctx, args[2])), args[0]) : SINK_NIL)
+		return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0]), fix_ ## T2(ctx, vq, args[1]), \
+			fix_ ## T3(ctx, vq, args[2])), args[0]) : SINK_NIL)
 
 #define P4(N, R, F, T1, T2, T3, T4) \
 	FUNC(F, check_args(ctx, 4, size, "Expecting " #T1 ", " #T2 ", " #T3 ", " #T4) ? \
-		return_ ## R(ctx, F(fix_ ## T1(ctx, args[0]), fix_ ## T2(ctx, args[1]), \
-			fix_ ## T3(ctx, args[2]), fix_ ## T4(ctx, args[3])), args[0]) : SINK_NIL)
+		return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0]), fix_ ## T2(ctx, vq, args[1]), \
+			fix_ ## T3(ctx, vq, args[2]), fix_ ## T4(ctx, vq, args[3])), args[0]) : SINK_NIL)
 
 #define P5(N, R, F, T1, T2, T3, T4, T5) \
 	FUNC(F, check_args(ctx, 5, size, "Expecting " #T1 ", " #T2 ", " #T3 ", " #T4 ", " #T5) ? \
-		return_ ## R(ctx, F(fix_ ## T1(ctx, args[0]), fix_ ## T2(ctx, args[1]), \
-			fix_ ## T3(ctx, args[2]), fix_ ## T4(ctx, args[3]), fix_ ## T5(ctx, args[4])), \
-		args[0]) : SINK_NIL)
+		return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0]), fix_ ## T2(ctx, vq, args[1]), \
+			fix_ ## T3(ctx, vq, args[2]), fix_ ## T4(ctx, vq, args[3]), \
+			fix_ ## T5(ctx, vq, args[4])), args[0]) : SINK_NIL)
 
 #define P6(N, R, F, T1, T2, T3, T4, T5, T6) \
 	FUNC(F, check_args(ctx, 6, size, "Expecting " #T1 ", " #T2 ", " #T3 ", " #T4 ", " #T5 ", " \
-		#T6) ? return_ ## R(ctx, F(fix_ ## T1(ctx, args[0]), fix_ ## T2(ctx, args[1]), \
-			fix_ ## T3(ctx, args[2]), fix_ ## T4(ctx, args[3]), fix_ ## T5(ctx, args[4]), \
-			fix_ ## T6(ctx, args[5])), args[0]) : SINK_NIL)
+		#T6) ? return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0]), \
+			fix_ ## T2(ctx, vq, args[1]), fix_ ## T3(ctx, vq, args[2]), \
+			fix_ ## T4(ctx, vq, args[3]), fix_ ## T5(ctx, vq, args[4]), \
+			fix_ ## T6(ctx, vq, args[5])), args[0]) : SINK_NIL)
 
 #define P7(N, R, F, T1, T2, T3, T4, T5, T6, T7) \
 	FUNC(F, check_args(ctx, 7, size, "Expecting " #T1 ", " #T2 ", " #T3 ", " #T4 ", " #T5 ", " \
-		#T6 ", " #T7) ? return_ ## R(ctx, F(fix_ ## T1(ctx, args[0]), fix_ ## T2(ctx, args[1]), \
-			fix_ ## T3(ctx, args[2]), fix_ ## T4(ctx, args[3]), fix_ ## T5(ctx, args[4]), \
-			fix_ ## T6(ctx, args[5]), fix_ ## T7(ctx, args[6])), args[0]) : SINK_NIL)
+		#T6 ", " #T7) ? return_ ## R(ctx, vq, F(fix_ ## T1(ctx, vq, args[0]), \
+			fix_ ## T2(ctx, vq, args[1]), fix_ ## T3(ctx, vq, args[2]), \
+			fix_ ## T4(ctx, vq, args[3]), fix_ ## T5(ctx, vq, args[4]), \
+			fix_ ## T6(ctx, vq, args[5]), fix_ ## T7(ctx, vq, args[6])), args[0]) : SINK_NIL)
 
 FUNCS(P0, P1, P2, P3, P4, P5, P6, P7)
 
@@ -476,6 +548,233 @@ FUNCS(P0, P1, P2, P3, P4, P5, P6, P7)
 #undef P6
 #undef P7
 
+// scratch space for batches, kept by each context, grown as needed and reused between calls
+static inline void *scratch(vqm vq, int slot, size_t size){
+	if (size > vq->scratch_size[slot]){
+		free(vq->scratch_ptr[slot]);
+		vq->scratch_ptr[slot] = malloc(size);
+		vq->scratch_size[slot] = vq->scratch_ptr[slot] ? size : 0;
+	}
+	return vq->scratch_ptr[slot];
+}
+
+static void vqm_free(void *ptr){
+	vqm vq = ptr;
+	for (int i = 0; i < 3; i++)
+		free(vq->scratch_ptr[i]);
+	free(vq);
+}
+
+static inline bool is_nums(sink_ctx ctx, sink_val a, int n){
+	if (!sink_islist(a))
+		return false;
+	sink_list ls = sink_castlist(ctx, a);
+	if (ls->size < n)
+		return false;
+	for (int i = 0; i < n; i++){
+		if (!sink_isnum(ls->vals[i]))
+			return false;
+	}
+	return true;
+}
+
+// reads a list of `n` component values (or of nums, when `n` is 1) into scratch `slot`, returns
+// NULL after aborting on error
+static float *fix_all(sink_ctx ctx, vqm vq, sink_val a, int n, int slot, int *count,
+	const char *err){
+	if (!sink_islist(a)){
+		sink_abortcstr(ctx, err);
+		return NULL;
+	}
+	sink_list ls = sink_castlist(ctx, a);
+	float *out = scratch(vq, slot, sizeof(float) * n * (ls->size > 0 ? ls->size : 1));
+	if (out == NULL){
+		sink_abortcstr(ctx, "Out of memory");
+		return NULL;
+	}
+	for (int i = 0; i < ls->size; i++){
+		if (n == 1){
+			if (!sink_isnum(ls->vals[i])){
+				sink_abortcstr(ctx, err);
+				return NULL;
+			}
+			out[i] = sink_castnum(ls->vals[i]);
+			continue;
+		}
+		if (!is_nums(ctx, ls->vals[i], n)){
+			sink_abortcstr(ctx, err);
+			return NULL;
+		}
+		sink_list e = sink_castlist(ctx, ls->vals[i]);
+		for (int k = 0; k < n; k++)
+			out[i * n + k] = sink_castnum(e->vals[k]);
+	}
+	*count = ls->size;
+	return out;
+}
+
+// writes `count` values of `n` components into the lists of `d` when it's a list of at least
+// `count` lists, so scripts can reuse one output list, otherwise returns a new list of new lists
+static sink_val return_all(sink_ctx ctx, vqm vq, const float *a, int n, int count, sink_val d,
+	const char *err){
+	if (!sink_isnil(d)){
+		if (!is_out(ctx, vq, d, count)){
+			sink_abortcstr(ctx, err);
+			return SINK_NIL;
+		}
+		sink_list ls = sink_castlist(ctx, d);
+		for (int i = 0; i < count; i++){
+			if (!is_out(ctx, vq, ls->vals[i], n)){
+				sink_abortcstr(ctx, err);
+				return SINK_NIL;
+			}
+		}
+		for (int i = 0; i < count; i++){
+			sink_list e = sink_castlist(ctx, ls->vals[i]);
+			for (int k = 0; k < n; k++)
+				e->vals[k] = sink_num(a[i * n + k]);
+		}
+		return d;
+	}
+	// each new list is pushed as soon as it's made, so the pinned outer list keeps it alive through
+	// the allocations that follow
+	sink_val res = sink_list_newblob(ctx, 0, NULL);
+	sink_gc_pin(ctx, res);
+	for (int i = 0; i < count; i++){
+		sink_val v[4];
+		for (int k = 0; k < n; k++)
+			v[k] = sink_num(a[i * n + k]);
+		sink_list_push(ctx, res, sink_list_newblob(ctx, n, v));
+	}
+	sink_gc_unpin(ctx, res);
+	return res;
+}
+
+// vec3.applymat4_all points, m[, out]
+static sink_val L_vec3_applymat4_all(sink_ctx ctx, int size, sink_val *args, void *nuser){
+	vqm vq = nuser;
+	if (!check_args(ctx, 2, size, "Expecting list of vec3, mat4"))
+		return SINK_NIL;
+	int count;
+	float *a = fix_all(ctx, vq, args[0], 3, 0, &count, "Expecting list of vec3");
+	if (a == NULL)
+		return SINK_NIL;
+	mat4 *m = fix_mat4(ctx, vq, args[1]);
+	vec3_applymat4_array((vec3 *)a, (vec3 *)a, m, count);
+	return return_all(ctx, vq, a, 3, count, size > 2 ? args[2] : SINK_NIL, "Expecting list of vec3");
+}
+
+// quat.slerp_all a, b, t[, out] where t is a num, or a list of nums with one per quat
+static sink_val L_quat_slerp_all(sink_ctx ctx, int size, sink_val *args, void *nuser){
+	vqm vq = nuser;
+	if (!check_args(ctx, 3, size, "Expecting list of quat, list of quat, num"))
+		return SINK_NIL;
+	int count, bcount;
+	float *a = fix_all(ctx, vq, args[0], 4, 0, &count, "Expecting list of quat");
+	if (a == NULL)
+		return SINK_NIL;
+	float *b = fix_all(ctx, vq, args[1], 4, 1, &bcount, "Expecting list of quat");
+	if (b == NULL)
+		return SINK_NIL;
+	if (bcount != count){
+		sink_abortcstr(ctx, "Expecting lists of quat with the same size");
+		return SINK_NIL;
+	}
+	if (sink_isnum(args[2]))
+		quat_slerp_array((quat *)a, (quat *)a, (quat *)b, sink_castnum(args[2]), count);
+	else{
+		int tcount;
+		float *t = fix_all(ctx, vq, args[2], 1, 2, &tcount, "Expecting num or list of num");
+		if (t == NULL)
+			return SINK_NIL;
+		if (tcount != count){
+			sink_abortcstr(ctx, "Expecting list of num with the same size");
+			return SINK_NIL;
+		}
+		quat_slerpv_array((quat *)a, (quat *)a, (quat *)b, t, count);
+	}
+	return return_all(ctx, vq, a, 4, count, size > 3 ? args[3] : SINK_NIL, "Expecting list of quat");
+}
+
+static sink_val new_handle(sink_ctx ctx, sink_user type, const float *v, int n){
+	float *h = malloc(sizeof(float) * n);
+	if (h == NULL){
+		sink_abortcstr(ctx, "Out of memory");
+		return SINK_NIL;
+	}
+	memcpy(h, v, sizeof(float) * n);
+	return sink_user_new(ctx, type, h);
+}
+
+static inline void *fix_handle(sink_ctx ctx, sink_val a, sink_user type, const char *err){
+	if (!sink_isuser(ctx, a, type)){
+		sink_abortcstr(ctx, err);
+		return NULL;
+	}
+	return sink_list_getuser(ctx, a);
+}
+
+// writes the values into `d` when it's a list, otherwise returns a new list
+static sink_val export_handle(sink_ctx ctx, vqm vq, const float *v, int n, sink_val d,
+	const char *err){
+	if (!sink_isnil(d)){
+		if (!is_out(ctx, vq, d, n)){
+			sink_abortcstr(ctx, err);
+			return SINK_NIL;
+		}
+		sink_list ls = sink_castlist(ctx, d);
+		for (int i = 0; i < n; i++)
+			ls->vals[i] = sink_num(v[i]);
+		return d;
+	}
+	sink_val vals[16];
+	for (int i = 0; i < n; i++)
+		vals[i] = sink_num(v[i]);
+	return sink_list_newblob(ctx, n, vals);
+}
+
+static inline mat3 get_mat3(sink_ctx ctx, vqm vq, sink_val a){ return *fix_mat3(ctx, vq, a); }
+static inline mat4 get_mat4(sink_ctx ctx, vqm vq, sink_val a){ return *fix_mat4(ctx, vq, a); }
+static inline quat get_quat(sink_ctx ctx, vqm vq, sink_val a){ return fix_quat(ctx, vq, a); }
+static inline mat3 identity_mat3(){ mat3 a; mat3_identity(&a); return a; }
+static inline mat4 identity_mat4(){ mat4 a; mat4_identity(&a); return a; }
+static inline quat identity_quat(){ return quat_identity(); }
+
+// T.new [a] returns a handle holding a copy of `a`, or the identity
+// T.import h, a copies `a` into the handle
+// T.export h[, out] copies the handle into `out`, or a new list
+#define HANDLE(T, N)                                                                             \
+	static sink_val L_ ## T ## _new(sink_ctx ctx, int size, sink_val *args, void *nuser){        \
+		vqm vq = nuser;                                                                          \
+		T a = size > 0 && !sink_isnil(args[0]) ? get_ ## T(ctx, vq, args[0]) : identity_ ## T(); \
+		return new_handle(ctx, vq->T ## _type, a.v, N);                                          \
+	}                                                                                            \
+	static sink_val L_ ## T ## _import(sink_ctx ctx, int size, sink_val *args, void *nuser){     \
+		vqm vq = nuser;                                                                          \
+		if (!check_args(ctx, 2, size, "Expecting " #T " handle, " #T))                           \
+			return SINK_NIL;                                                                     \
+		T *h = fix_handle(ctx, args[0], vq->T ## _type, "Expecting " #T " handle");              \
+		if (h == NULL)                                                                           \
+			return SINK_NIL;                                                                     \
+		*h = get_ ## T(ctx, vq, args[1]);                                                        \
+		return args[0];                                                                          \
+	}                                                                                            \
+	static sink_val L_ ## T ## _export(sink_ctx ctx, int size, sink_val *args, void *nuser){     \
+		vqm vq = nuser;                                                                          \
+		if (!check_args(ctx, 1, size, "Expecting " #T " handle"))                                \
+			return SINK_NIL;                                                                     \
+		T *h = fix_handle(ctx, args[0], vq->T ## _type, "Expecting " #T " handle");              \
+		if (h == NULL)                                                                           \
+			return SINK_NIL;                                                                     \
+		return export_handle(ctx, vq, h->v, N, size > 1 ? args[1] : SINK_NIL, "Expecting list"); \
+	}
+
+HANDLE(mat3, 9)
+HANDLE(mat4, 16)
+HANDLE(quat, 4)
+
+#undef HANDLE
+
 void sink_vqm_scr(sink_scr scr){
 	#define P0(N, R, F)                             "declare " N " 'sink.vqm." N "';"
 	#define P1(N, R, F, T1)                         "declare " N " 'sink.vqm." N "';"
@@ -485,8 +784,11 @@ void sink_vqm_scr(sink_scr scr){
 	#define P5(N, R, F, T1, T2, T3, T4, T5)         "declare " N " 'sink.vqm." N "';"
 	#define P6(N, R, F, T1, T2, T3, T4, T5, T6)     "declare " N " 'sink.vqm." N "';"
 	#define P7(N, R, F, T1, T2, T3, T4, T5, T6, T7) "declare " N " 'sink.vqm." N "';"
+	#define B(N, F)                                 "declare " N " 'sink.vqm." N "';"
 	sink_scr_incbody(scr, "vqm",
 		FUNCS(P0, P1, P2, P3, P4, P5, P6, P7)
+		BATCHES(B)
+		HANDLES(B)
 	);
 	#undef P0
 	#undef P1
@@ -496,18 +798,29 @@ void sink_vqm_scr(sink_scr scr){
 	#undef P5
 	#undef P6
 	#undef P7
+	#undef B
 }
 
 void sink_vqm_ctx(sink_ctx ctx){
-	#define P0(N, R, F)                             sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P1(N, R, F, T1)                         sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P2(N, R, F, T1, T2)                     sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P3(N, R, F, T1, T2, T3)                 sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P4(N, R, F, T1, T2, T3, T4)             sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P5(N, R, F, T1, T2, T3, T4, T5)         sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P6(N, R, F, T1, T2, T3, T4, T5, T6)     sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
-	#define P7(N, R, F, T1, T2, T3, T4, T5, T6, T7) sink_ctx_native(ctx, "sink.vqm." N, NULL, L_ ## F);
+	#define P0(N, R, F)                             sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P1(N, R, F, T1)                         sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P2(N, R, F, T1, T2)                     sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P3(N, R, F, T1, T2, T3)                 sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P4(N, R, F, T1, T2, T3, T4)             sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P5(N, R, F, T1, T2, T3, T4, T5)         sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P6(N, R, F, T1, T2, T3, T4, T5, T6)     sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define P7(N, R, F, T1, T2, T3, T4, T5, T6, T7) sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	#define B(N, F)                                 sink_ctx_native(ctx, "sink.vqm." N, vq, L_ ## F);
+	vqm vq = calloc(1, sizeof(vqm_st));
+	if (vq == NULL)
+		return;
+	sink_ctx_cleanup(ctx, vq, vqm_free);
+	vq->mat3_type = sink_ctx_addusertype(ctx, "sink.vqm.mat3", free);
+	vq->mat4_type = sink_ctx_addusertype(ctx, "sink.vqm.mat4", free);
+	vq->quat_type = sink_ctx_addusertype(ctx, "sink.vqm.quat", free);
 	FUNCS(P0, P1, P2, P3, P4, P5, P6, P7)
+	BATCHES(B)
+	HANDLES(B)
 	#undef P0
 	#undef P1
 	#undef P2
@@ -516,4 +829,5 @@ void sink_vqm_ctx(sink_ctx ctx){
 	#undef P5
 	#undef P6
 	#undef P7
+	#undef B
 }
@@ -53,6 +53,73 @@ function SinkVqm(){
 		return ct(a, 16, 'mat4 or nil');
 	}
 
+	// batches: `f(i)` computes element `i`, written into the lists of `out` when it's given
+	function all(n, f, out, name){
+		if (typeof out === 'undefined' || out === null){
+			out = [];
+			for (var i = 0; i < n; i++)
+				out.push(f(i));
+			return out;
+		}
+		if (Object.prototype.toString.call(out) !== '[object Array]' || out.length < n)
+			throw new Error('Expecting list of ' + name);
+		for (var i = 0; i < n; i++){
+			if (Object.prototype.toString.call(out[i]) !== '[object Array]')
+				throw new Error('Expecting list of ' + name);
+		}
+		for (var i = 0; i < n; i++){
+			var r = f(i);
+			for (var k = 0; k < r.length; k++)
+				out[i][k] = r[k];
+		}
+		return out;
+	}
+
+	function la(a, ck, name){
+		if (Object.prototype.toString.call(a) !== '[object Array]')
+			throw new Error('Expecting list of ' + name);
+		for (var i = 0; i < a.length; i++)
+			ck(a[i]);
+		return a;
+	}
+
+	function vec3_applymat4_all(pts, m, out){
+		la(pts, v3, 'vec3');
+		m4(m);
+		return all(pts.length, function(i){ return vec3_applymat4(pts[i], m); }, out, 'vec3');
+	}
+
+	function quat_slerp_all(a, b, t, out){
+		la(a, qt, 'quat');
+		la(b, qt, 'quat');
+		if (b.length !== a.length)
+			throw new Error('Expecting lists of quat with the same size');
+		if (typeof t === 'number')
+			return all(a.length, function(i){ return quat_slerp(a[i], b[i], t); }, out, 'quat');
+		la(t, nm, 'num');
+		if (t.length !== a.length)
+			throw new Error('Expecting list of num with the same size');
+		return all(a.length, function(i){ return quat_slerp(a[i], b[i], t[i]); }, out, 'quat');
+	}
+
+	// handles are plain arrays here, since values are native already
+	function handle(ck, identity){
+		return {
+			create: function(a){ return (typeof a === 'undefined' || a === null) ? identity() : ck(a).concat(); },
+			import: function(h, a){ ck(h); ck(a); for (var i = 0; i < a.length; i++) h[i] = a[i]; return h; },
+			export: function(h, out){
+				ck(h);
+				if (typeof out === 'undefined' || out === null)
+					return h.concat();
+				for (var i = 0; i < h.length; i++) out[i] = h[i];
+				return out;
+			}
+		};
+	}
+	var hm3 = handle(m3, mat3_identity);
+	var hm4 = handle(m4, mat4_identity);
+	var hqt = handle(qt, quat_identity);
+
 	var funcs = {
 		// vec2
 		'vec2.add'        : function(a, b       ){ return vec2_add        (v2(a), v2(b)           ); },
@@ -205,8 +272,12 @@ function SinkVqm(){
 		'mat4.frustum':        function(out, L, R, B, T, N, F        ){ return mat4_frustum       (m4(out), nm(L), nm(R), nm(B), nm(T), nm(N), nm(F)    ); },
 		'mat4.identity':       function(out                          ){ return mat4_identity      (m4u(out)                                             ); },
 		'mat4.invert':         function(out, a                       ){ return mat4_invert        (m4(out), m4(a)                                       ); },
+		'mat4.invert_affine':  function(out, a                       ){ return mat4_invert_affine (m4(out), m4(a)                                       ); },
+		'mat4.invert_fast':    function(out, a                       ){ return mat4_invert_fast   (m4(out), m4(a)                                       ); },
+		'mat4.invert_rigid':   function(out, a                       ){ return mat4_invert_rigid  (m4(out), m4(a)                                       ); },
 		'mat4.lookat':         function(out, eye, position, up       ){ return mat4_lookat        (m4(out), v3(eye), v3(position), v3(up)               ); },
 		'mat4.mul':            function(out, a, b                    ){ return mat4_mul           (m4(out), m4(a), m4(b)                                ); },
+		'mat4.mul_affine':     function(out, a, b                    ){ return mat4_mul_affine    (m4(out), m4(a), m4(b)                                ); },
 		'mat4.orthogonal':     function(out, W, H, N, F              ){ return mat4_orthogonal    (m4(out), nm(W), nm(H), nm(N), nm(F)                  ); },
 		'mat4.perspective':    function(out, fov, width, height, N, F){ return mat4_perspective   (m4(out), nm(fov), nm(width), nm(height), nm(N), nm(F)); },
 		'mat4.quat':           function(out, a                       ){ return mat4_quat          (m4(out), qt(a)                                       ); },
@@ -219,7 +290,22 @@ function SinkVqm(){
 		'mat4.sub':            function(out, a, b                    ){ return mat4_sub           (m4(out), m4(a), m4(b)                                ); },
 		'mat4.translate':      function(out, a, b                    ){ return mat4_translate     (m4(out), m4(a), v3(b)                                ); },
 		'mat4.translation':    function(out, a                       ){ return mat4_translation   (m4(out), v3(a)                                       ); },
-		'mat4.transpose':      function(out, a                       ){ return mat4_transpose     (m4(out), m4(a)                                       ); }
+		'mat4.transpose':      function(out, a                       ){ return mat4_transpose     (m4(out), m4(a)                                       ); },
+
+		// batches
+		'vec3.applymat4_all': vec3_applymat4_all,
+		'quat.slerp_all'    : quat_slerp_all,
+
+		// handles
+		'mat3.new'   : hm3.create,
+		'mat3.import': hm3.import,
+		'mat3.export': hm3.export,
+		'mat4.new'   : hm4.create,
+		'mat4.import': hm4.import,
+		'mat4.export': hm4.export,
+		'quat.new'   : hqt.create,
+		'quat.import': hqt.import,
+		'quat.export': hqt.export
 	};
 
 	var include = '';
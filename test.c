@@ -7,74 +7,222 @@
 //
 // It includes "nvqm.c" directly, so it's easy to compile:
 //
-// $ clang      \
-//     -O2      \ # optimization level 2
-//     -Wall    \ # warn on anything
-//     -fwrapv  \ # wrap overflow
-//     -o test  \ # output to `test`
-//     test.c     # the single file that needs to be compiled
+// $ clang               \
+//     -O2               \ # optimization level 2
+//     -Wall             \ # warn on anything
+//     -fwrapv           \ # wrap overflow
+//     -ffp-contract=off \ # don't fuse multiplies and adds, which the bit for bit checks need
+//     -pthread          \ # the error sweeps run on a thread per CPU
+//     -o test           \ # output to `test`
+//     test.c              # the single file that needs to be compiled
+//
+// The chk_ tests that compare SIMD kernels bit for bit against the C code fail when the compiler
+// fuses the C code's multiplies and adds, which GCC does by default with -march=native and other
+// FMA targets, so keep -ffp-contract=off.
 //
 
 #include "nvqm.c"
+#include "nvqm_ref.h"
 #include <time.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <pthread.h>
+#include <unistd.h>
 
-static int err_rang(const char *hint, xang (*est_func)(xint v), float (*ans_func)(float v),
-	xint min, xint max){
-	int max_err = -1;
-	int64_t dot = ((int64_t)max - (int64_t)min) / 75;
-	printf("_________________________________ Progress ________________________________\n");
-	for (int64_t i = min; i <= max; i++){
-		if (i % dot == 0){
+// the exhaustive error sweeps split their inputs into chunks, which a pool of threads take in order,
+// each keeping its own maximum error and the smallest input that gave it, so the results don't
+// depend on the number of threads
+static int threads = 1;
+
+typedef struct sweep_st sweep;
+struct sweep_st {
+	int (*diff)(const sweep *s, int64_t i); // error in units for input i
+	xang (*est_rang)(xint v);
+	xint (*est_aang)(xang v);
+	xint (*est_xint)(xint v);
+	float (*ans)(float v);
+	const xint *v;                          // err_atan2 pairs up v[i / n] and v[i % n]
+	int64_t n;
+	int64_t min, max;                       // inclusive
+	pthread_mutex_t lock;
+	int64_t next, done;
+	int dots;
+};
+
+typedef struct {
+	sweep *s;
+	int max_err;
+	int64_t max_at;
+} sweep_part;
+
+static void *sweep_worker(void *arg){
+	sweep_part *part = arg;
+	sweep *s = part->s;
+	const int64_t chunk = 1 << 16;
+	int64_t total = s->max - s->min + 1;
+	for (;;){
+		pthread_mutex_lock(&s->lock);
+		int64_t lo = s->next;
+		s->next += chunk;
+		pthread_mutex_unlock(&s->lock);
+		if (lo > s->max)
+			break;
+		int64_t hi = lo + chunk - 1 < s->max ? lo + chunk - 1 : s->max;
+		for (int64_t i = lo; i <= hi; i++){
+			int diff = s->diff(s, i);
+			if (diff > part->max_err || (diff == part->max_err && i < part->max_at)){
+				part->max_err = diff;
+				part->max_at = i;
+			}
+		}
+		pthread_mutex_lock(&s->lock);
+		s->done += hi - lo + 1;
+		bool dot = false;
+		while (s->dots < s->done * 75 / total){
 			printf(".");
+			s->dots++;
+			dot = true;
+		}
+		if (dot)
 			fflush(stdout);
+		pthread_mutex_unlock(&s->lock);
+	}
+	return NULL;
+}
+
+static double sweep_run(sweep *s, int *max_err, int64_t *max_at){
+	// returns the seconds taken
+	sweep_part *parts = malloc(sizeof(sweep_part) * threads);
+	pthread_t *tids = malloc(sizeof(pthread_t) * threads);
+	if (parts == NULL || tids == NULL){
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+	pthread_mutex_init(&s->lock, NULL);
+	s->next = s->min;
+	s->done = 0;
+	s->dots = 0;
+	printf("_________________________________ Progress ________________________________\n");
+	struct timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (int k = 0; k < threads; k++){
+		parts[k].s = s;
+		parts[k].max_err = -1;
+		parts[k].max_at = s->max;
+		if (k > 0 && pthread_create(&tids[k], NULL, sweep_worker, &parts[k]) != 0){
+			fprintf(stderr, "Failed to create thread\n");
+			exit(1);
+		}
+	}
+	sweep_worker(&parts[0]);
+	*max_err = parts[0].max_err;
+	*max_at = parts[0].max_at;
+	for (int k = 1; k < threads; k++){
+		pthread_join(tids[k], NULL);
+		if (parts[k].max_err > *max_err ||
+			(parts[k].max_err == *max_err && parts[k].max_at < *max_at)){
+			*max_err = parts[k].max_err;
+			*max_at = parts[k].max_at;
 		}
-		xint x = (xint)i;
-		xang est = est_func(x);
-		xang ans = xang_fromfloat(ans_func(xint_tofloat(x)));
-		ans = ((ans % XANG360) + XANG360) % XANG360;
-		int diff = est - ans;
-		if (diff < 0)
-			diff = -diff;
-		if (diff > XANG180)
-			diff = XANG360 - diff;
-		if (diff > max_err)
-			max_err = diff;
 	}
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+	pthread_mutex_destroy(&s->lock);
+	free(parts);
+	free(tids);
+	return (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+}
+
+static int diff_ang(xang est, xang ans){
+	ans = ((ans % XANG360) + XANG360) % XANG360;
+	int diff = est - ans;
+	if (diff < 0)
+		diff = -diff;
+	if (diff > XANG180)
+		diff = XANG360 - diff;
+	return diff;
+}
+
+static int diff_rang(const sweep *s, int64_t i){
+	xint x = (xint)i;
+	return diff_ang(s->est_rang(x), xang_fromfloat(s->ans(xint_tofloat(x))));
+}
+
+static int err_rang(const char *hint, xang (*est_func)(xint v), float (*ans_func)(float v),
+	xint min, xint max){
+	sweep s = { .diff = diff_rang, .est_rang = est_func, .ans = ans_func, .min = min, .max = max };
+	int max_err;
+	int64_t max_at;
+	double sec = sweep_run(&s, &max_err, &max_at);
 	printf("\n\n"
 		"Results\n"
 		"-----------------------------------\n"
 		"Error Test   : %s(i)\n"
 		"Range `i`    : %f to %f\n"
 		"Maximum Error: +-%f radians\n"
-		"               +-%d / %d units\n",
+		"               +-%d / %d units\n"
+		"               at %s(%f)\n"
+		"Threads      : %d, %.1f seconds\n",
 		hint, xint_tofloat(min), xint_tofloat(max),
-		xang_todouble(max_err), max_err, XANG360
+		xang_todouble(max_err), max_err, XANG360,
+		hint, xint_tofloat((xint)max_at),
+		threads, sec
 	);
 	return 0;
 }
 
+static int diff_atan2(const sweep *s, int64_t i){
+	xint y = s->v[i / s->n], x = s->v[i % s->n];
+	if (y == 0 && x == 0)
+		return 0;
+	return diff_ang(xint_atan2(y, x), xang_fromfloat(num_atan2(xint_tofloat(y), xint_tofloat(x))));
+}
+
+static int err_atan2(){
+	// every xint is too many pairs, so both `i` and `j` walk 0 and +- a ladder of values that is
+	// dense near zero and spaced about 1/256 apart relative to the value up to the limits
+	static xint v[12000];
+	int n = 0;
+	v[n++] = 0;
+	for (int64_t m = 1; m <= XINTMAX; m += 1 + (m >> 8)){
+		v[n++] = (xint)m;
+		v[n++] = (xint)-m;
+	}
+	v[n++] = XINTMIN;
+	sweep s = { .diff = diff_atan2, .v = v, .n = n, .min = 0, .max = (int64_t)n * n - 1 };
+	int max_err;
+	int64_t max_at;
+	double sec = sweep_run(&s, &max_err, &max_at);
+	printf("\n\n"
+		"Results\n"
+		"-----------------------------------\n"
+		"Error Test   : atan2(i, j)\n"
+		"Range `i`,`j`: %f to %f, %d values each\n"
+		"Maximum Error: +-%f radians\n"
+		"               +-%d / %d units\n"
+		"               at atan2(%f, %f)\n"
+		"Threads      : %d, %.1f seconds\n",
+		xint_tofloat(XINTMIN), xint_tofloat(XINTMAX), n,
+		xang_todouble(max_err), max_err, XANG360,
+		xint_tofloat(v[max_at / n]), xint_tofloat(v[max_at % n]),
+		threads, sec
+	);
+	return 0;
+}
+
+static int diff_aang(const sweep *s, int64_t i){
+	xang x = (xang)i;
+	int diff = s->est_aang(x) - xint_fromfloat(s->ans(xang_tofloat(x)));
+	return diff < 0 ? -diff : diff;
+}
+
 static int err_aang(const char *hint, xint (*est_func)(xang v), float (*ans_func)(float v),
 	int32_t min, int32_t max){
-	int max_err = -1;
-	int64_t dot = ((int64_t)max - (int64_t)min) / 75;
-	printf("_________________________________ Progress ________________________________\n");
-	for (int64_t i = min; i <= max; i++){
-		if (i % dot == 0){
-			printf(".");
-			fflush(stdout);
-		}
-		xang x = (xang)i;
-		xint est = est_func(x);
-		xint ans = xint_fromfloat(ans_func(xang_tofloat(x)));
-		int diff = est - ans;
-		if (diff < 0)
-			diff = -diff;
-		if (diff > max_err)
-			max_err = diff;
-	}
+	sweep s = { .diff = diff_aang, .est_aang = est_func, .ans = ans_func, .min = min, .max = max };
+	int max_err;
+	int64_t max_at;
+	double sec = sweep_run(&s, &max_err, &max_at);
 	printf("\n\n"
 		"Results\n"
 		"-----------------------------------\n"
@@ -82,84 +230,1316 @@ static int err_aang(const char *hint, xint (*est_func)(xang v), float (*ans_func
 		"Range `i`    : %f to %f radians\n"
 		"               %d to %d units\n"
 		"Maximum Error: +-%f radians\n"
-		"               +-%d / %d units\n",
+		"               +-%d / %d units\n"
+		"               at %s(%d units)\n"
+		"Threads      : %d, %.1f seconds\n",
 		hint, xang_tofloat(min), xang_tofloat(max), min, max,
-		xang_todouble(max_err), max_err, XANG360
+		xang_todouble(max_err), max_err, XANG360,
+		hint, (int)max_at,
+		threads, sec
 	);
 	return 0;
 }
 
+static int diff_xint(const sweep *s, int64_t i){
+	xint x = (xint)i;
+	int diff = s->est_xint(x) - xint_fromfloat(s->ans(xint_tofloat(x)));
+	return diff < 0 ? -diff : diff;
+}
+
 static int err_xint(const char *hint, xint (*est_func)(xint v), float (*ans_func)(float v),
 	xint min, xint max){
-	int max_err = -1;
-	int64_t dot = ((int64_t)max - (int64_t)min) / 75;
+	sweep s = { .diff = diff_xint, .est_xint = est_func, .ans = ans_func, .min = min, .max = max };
+	int max_err;
+	int64_t max_at;
+	double sec = sweep_run(&s, &max_err, &max_at);
+	printf("\n\n"
+		"Results\n"
+		"-----------------------------------\n"
+		"Error Test   : %s(i)\n"
+		"Range `i`    : %f to %f\n"
+		"Maximum Error: +-%f\n"
+		"               +-%d / %d\n"
+		"               at %s(%f)\n"
+		"Threads      : %d, %.1f seconds\n",
+		hint, xint_tofloat(min), xint_tofloat(max),
+		xang_todouble(max_err), max_err, XINT1,
+		hint, xint_tofloat((xint)max_at),
+		threads, sec
+	);
+	return 0;
+}
+
+static int err_pow(){
+	// xint_pow against the exact power of the same fixed-point inputs, computed in double
+	// both magnitudes are spread over every power of two, so results cover the whole range from
+	// underflow to saturation
+	double max_err = -1;
+	xint max_a = 0, max_b = 0;
+	int64_t total = 40000000;
+	int64_t dot = total / 75;
+	srand(1);
 	printf("_________________________________ Progress ________________________________\n");
-	for (int64_t i = min; i <= max; i++){
+	for (int64_t i = 0; i < total; i++){
 		if (i % dot == 0){
 			printf(".");
 			fflush(stdout);
 		}
-		xint x = (xint)i;
-		xint est = est_func(x);
-		xint ans = xint_fromfloat(ans_func(xint_tofloat(x)));
-		int diff = est - ans;
-		if (diff < 0)
-			diff = -diff;
-		if (diff > max_err)
+		xint x = (xint)(((uint32_t)rand() >> (rand() % 31)) | 1);
+		xint y = (xint)((uint32_t)rand() >> (rand() % 31));
+		if (rand() & 1)
+			y = -y;
+		xint est = xint_pow(x, y);
+		double ans = pow((double)x / XINT1, (double)y / XINT1) * XINT1;
+		if (ans > XINTMAX)
+			ans = XINTMAX;
+		double diff = fabs(est - ans);
+		if (diff > max_err){
 			max_err = diff;
+			max_a = x;
+			max_b = y;
+		}
 	}
 	printf("\n\n"
 		"Results\n"
 		"-----------------------------------\n"
-		"Error Test   : %s(i)\n"
+		"Error Test   : pow(i, j)\n"
 		"Range `i`    : %f to %f\n"
-		"Maximum Error: +-%f\n"
-		"               +-%d / %d\n",
-		hint, xint_tofloat(min), xint_tofloat(max),
-		xang_todouble(max_err), max_err, XINT1
+		"Range `j`    : %f to %f\n"
+		"Samples      : %lld\n"
+		"Maximum Error: +-%f / %d units\n"
+		"               at pow(%f, %f)\n",
+		xint_tofloat(1), xint_tofloat(XINTMAX),
+		xint_tofloat(-XINTMAX), xint_tofloat(XINTMAX),
+		(long long)total, max_err, XINT1,
+		xint_tofloat(max_a), xint_tofloat(max_b)
 	);
 	return 0;
 }
 
-static int err_pow(){
-	int max_err = -1;
-	int64_t a_min = 0;
-	int64_t a_max = 512;
-	int64_t b_min = -XINT1 + 1;
-	int64_t b_max = -XINT1 + 1;
-	int64_t step = 1;
-	int64_t dot = (a_max - a_min) / (75 * step);
+static float rndf(){
+	return (float)rand() / RAND_MAX * 20.0f - 10.0f;
+}
+
+static int chk_applymat4_run(vec3 *(*func)(vec3 *out, vec3 *a, mat4 *b, size_t n), mat4 *m){
+	// compare against vec3_applymat4 for every count up to a few SIMD widths, so the SSE2 loop, the
+	// scalar remainder, and both together get used, with separate and in-place output, and starting
+	// at an unaligned element
+	enum { N = 37 };
+	static vec3 a[N + 1], out[N + 1];
+	int bad = 0;
+	for (size_t start = 0; start < 2; start++){
+		for (size_t n = 0; n <= N - start; n++){
+			for (size_t i = 0; i < N + 1; i++){
+				a[i] = vec3_new(rndf(), rndf(), rndf());
+				out[i] = vec3_new(-1.0f, -1.0f, -1.0f);
+			}
+			func(out + start, a + start, m, n);
+			for (size_t i = 0; i < N + 1; i++){
+				vec3 ans = i >= start && i < start + n ? vec3_applymat4(a[i], m) :
+					vec3_new(-1.0f, -1.0f, -1.0f);
+				bad += memcmp(&ans, &out[i], sizeof(vec3)) != 0;
+			}
+			// out == a
+			memcpy(out, a, sizeof(a));
+			func(out + start, out + start, m, n);
+			for (size_t i = 0; i < N + 1; i++){
+				vec3 ans = i >= start && i < start + n ? vec3_applymat4(a[i], m) : a[i];
+				bad += memcmp(&ans, &out[i], sizeof(vec3)) != 0;
+			}
+		}
+	}
+	return bad;
+}
+
+static int chk_applymat4(){
+	// the array functions must match vec3_applymat4 bit for bit, for projections, affine
+	// transforms, and a zero bottom row that makes every w zero (which is left undivided)
+	int bad_proj = 0, bad_affine = 0, bad_affine_array = 0, bad_zero = 0;
+	srand(1);
+	for (int k = 0; k < 100; k++){
+		mat4 proj, affine;
+		for (int j = 0; j < 16; j++)
+			proj.v[j] = rndf();
+		mat4_rottrans(&affine, quat_normal(quat_new(rndf(), rndf(), rndf(), rndf())),
+			vec3_new(rndf(), rndf(), rndf()));
+		bad_proj += chk_applymat4_run(vec3_applymat4_array, &proj);
+		bad_affine += chk_applymat4_run(vec3_applymat4_array, &affine);
+		bad_affine_array += chk_applymat4_run(vec3_applymat4affine_array, &affine);
+	}
+	mat4 flat;
+	for (int j = 0; j < 16; j++)
+		flat.v[j] = (j & 3) == 3 ? 0.0f : rndf();
+	bad_zero += chk_applymat4_run(vec3_applymat4_array, &flat);
+	printf(
+		"vec3_applymat4_array       projection : %s (%d mismatches)\n"
+		"vec3_applymat4_array       affine     : %s (%d mismatches)\n"
+		"vec3_applymat4_array       w = 0      : %s (%d mismatches)\n"
+		"vec3_applymat4affine_array affine     : %s (%d mismatches)\n",
+		bad_proj ? "FAIL" : "pass", bad_proj,
+		bad_affine ? "FAIL" : "pass", bad_affine,
+		bad_zero ? "FAIL" : "pass", bad_zero,
+		bad_affine_array ? "FAIL" : "pass", bad_affine_array
+	);
+	return bad_proj || bad_affine || bad_zero || bad_affine_array ? 1 : 0;
+}
+
+static void ref_mat4_mul(mat4 *out, mat4 *a, mat4 *b){
+	// the plain C version of mat4_mul, which the SIMD kernels must match bit for bit
+	mat4 res;
+	for (int c = 0; c < 4; c++){
+		for (int r = 0; r < 4; r++){
+			res.v[c * 4 + r] =
+				b->v[c * 4 + 0] * a->v[ 0 + r] +
+				b->v[c * 4 + 1] * a->v[ 4 + r] +
+				b->v[c * 4 + 2] * a->v[ 8 + r] +
+				b->v[c * 4 + 3] * a->v[12 + r];
+		}
+	}
+	*out = res;
+}
+
+static bool mat4_close(mat4 *ans, mat4 *est, mat4 *a, mat4 *b){
+	// each element within a few roundings of the sum of the magnitudes of its products, for kernels
+	// that round in a different order than the C version
+	for (int c = 0; c < 4; c++){
+		for (int r = 0; r < 4; r++){
+			float mag = 0;
+			for (int k = 0; k < 4; k++)
+				mag += num_abs(b->v[c * 4 + k] * a->v[k * 4 + r]);
+			if (num_abs(ans->v[c * 4 + r] - est->v[c * 4 + r]) > 4.0f * FLT_EPSILON * mag)
+				return false;
+		}
+	}
+	return true;
+}
+
+static int chk_mat4_kernel(const char *hint, mat4 *(*func)(mat4 *out, mat4 *a, mat4 *b),
+	bool exact){
+	// exact kernels must match bit for bit, which needs -ffp-contract=off so the compiler doesn't
+	// fuse the multiplies and adds of the reference
+	#define SAME(ans, est) \
+		(exact ? memcmp(&(ans), &(est), sizeof(mat4)) == 0 : mat4_close(&(ans), &(est), &a, &b))
+	int bad = 0;
+	srand(1);
+	for (int i = 0; i < 1000000; i++){
+		mat4 a, b, ans, est;
+		for (int j = 0; j < 16; j++){
+			a.v[j] = rndf();
+			b.v[j] = rndf();
+		}
+		ref_mat4_mul(&ans, &a, &b);
+		func(&est, &a, &b);
+		if (!SAME(ans, est))
+			bad++;
+		// out == a
+		est = a;
+		func(&est, &est, &b);
+		if (!SAME(ans, est))
+			bad++;
+		// out == b
+		est = b;
+		func(&est, &a, &est);
+		if (!SAME(ans, est))
+			bad++;
+	}
+	#undef SAME
+	printf("%-14s %s (%d %s)\n", hint, bad ? "FAIL" : "pass", bad,
+		exact ? "mismatches" : "outside tolerance");
+	return bad ? 1 : 0;
+}
+
+static int chk_mat4_mul(){
+#ifdef NVQM_FMA
+	// mat4_mul can pick the FMA kernel, which only agrees with the C version within rounding
+	int res = chk_mat4_kernel("mat4_mul", mat4_mul, false);
+#else
+	int res = chk_mat4_kernel("mat4_mul", mat4_mul, true);
+#endif
+#ifdef NVQM_SSE2
+	res |= chk_mat4_kernel("mat4_mul_sse2", mat4_mul_sse2, true);
+#endif
+#ifdef NVQM_DISPATCH
+	if (cpu_features() & CPU_AVX)
+		res |= chk_mat4_kernel("mat4_mul_avx", mat4_mul_avx, true);
+	else
+		printf("mat4_mul_avx   skipped (CPU lacks AVX)\n");
+#ifdef NVQM_FMA
+	if ((cpu_features() & CPU_AVX) && (cpu_features() & CPU_FMA))
+		res |= chk_mat4_kernel("mat4_mul_fma", mat4_mul_fma, false);
+	else
+		printf("mat4_mul_fma   skipped (CPU lacks FMA)\n");
+#endif
+#endif
+	return res;
+}
+
+static int chk_soa(){
+	// compare each structure of arrays function against the AoS version, bit for bit
+	enum { N = 10007 }; // odd size to exercise any remainder loops
+	static vec3 a3[N], b3[N], r3[N];
+	static vec4 a4[N], b4[N], r4[N];
+	static quat aq[N], bq[N], rq[N];
+	static float ax[N], ay[N], az[N], aw[N], bx[N], by[N], bz[N], bw[N], d[N];
+	vec3soa s3a = { ax, ay, az }, s3b = { bx, by, bz };
+	vec4soa s4a = { ax, ay, az, aw }, s4b = { bx, by, bz, bw };
+	quatsoa sqa = { ax, ay, az, aw }, sqb = { bx, by, bz, bw };
+	mat4 m;
+	for (int j = 0; j < 16; j++)
+		m.v[j] = rndf();
+	quat q = quat_normal(quat_new(rndf(), rndf(), rndf(), rndf()));
+	int bad = 0;
+	srand(1);
+	for (int i = 0; i < N; i++){
+		a3[i] = vec3_new(rndf(), rndf(), rndf());
+		b3[i] = vec3_new(rndf(), rndf(), rndf());
+		a4[i] = vec4_new(rndf(), rndf(), rndf(), rndf());
+		b4[i] = vec4_new(rndf(), rndf(), rndf(), rndf());
+		aq[i] = quat_new(rndf(), rndf(), rndf(), rndf());
+		bq[i] = quat_new(rndf(), rndf(), rndf(), rndf());
+	}
+	a3[0] = vec3_new(0, 0, 0); // zero length for normal
+
+	#define CHK3(name, soa, aos)                                     \
+		vec3soa_fromvec3(&s3a, a3, N);                               \
+		vec3soa_fromvec3(&s3b, b3, N);                               \
+		soa;                                                         \
+		vec3soa_tovec3(r3, &s3a, N);                                 \
+		for (int i = 0; i < N; i++){                                 \
+			vec3 ans = aos;                                          \
+			if (memcmp(&ans, &r3[i], sizeof(vec3)) != 0){ bad++;     \
+				printf("%s mismatch at %d\n", name, i); break; }     \
+		}
+	#define CHK4(name, type, soa, aos, from, to, sa, sb, av, bv, rv) \
+		from(&sa, av, N);                                            \
+		from(&sb, bv, N);                                            \
+		soa;                                                         \
+		to(rv, &sa, N);                                              \
+		for (int i = 0; i < N; i++){                                 \
+			type ans = aos;                                          \
+			if (memcmp(&ans, &rv[i], sizeof(type)) != 0){ bad++;     \
+				printf("%s mismatch at %d\n", name, i); break; }     \
+		}
+	#define CHKDOT(name, soa, aos)                                   \
+		soa;                                                         \
+		for (int i = 0; i < N; i++){                                 \
+			float ans = aos;                                         \
+			if (memcmp(&ans, &d[i], sizeof(float)) != 0){ bad++;     \
+				printf("%s mismatch at %d\n", name, i); break; }     \
+		}
+
+	CHK3("vec3soa_add"      , vec3soa_add(&s3a, &s3a, &s3b, N)         , vec3_add(a3[i], b3[i]))
+	CHK3("vec3soa_applymat4", vec3soa_applymat4(&s3a, &s3a, &m, N)     , vec3_applymat4(a3[i], &m))
+	CHK3("vec3soa_applyquat", vec3soa_applyquat(&s3a, &s3a, q, N)      , vec3_applyquat(a3[i], q))
+	CHK3("vec3soa_cross"    , vec3soa_cross(&s3a, &s3a, &s3b, N)       , vec3_cross(a3[i], b3[i]))
+	CHK3("vec3soa_lerp"     , vec3soa_lerp(&s3a, &s3a, &s3b, 0.3f, N)  , vec3_lerp(a3[i], b3[i], 0.3f))
+	CHK3("vec3soa_normal"   , vec3soa_normal(&s3a, &s3a, N)            , vec3_normal(a3[i]))
+	CHK3("vec3soa_scale"    , vec3soa_scale(&s3a, &s3a, 1.7f, N)       , vec3_scale(a3[i], 1.7f))
+	CHK3("vec3soa_sub"      , vec3soa_sub(&s3a, &s3a, &s3b, N)         , vec3_sub(a3[i], b3[i]))
+	vec3soa_fromvec3(&s3a, a3, N);
+	vec3soa_fromvec3(&s3b, b3, N);
+	CHKDOT("vec3soa_dot"    , vec3soa_dot(d, &s3a, &s3b, N)            , vec3_dot(a3[i], b3[i]))
+
+	#define V4(name, soa, aos) \
+		CHK4(name, vec4, soa, aos, vec4soa_fromvec4, vec4soa_tovec4, s4a, s4b, a4, b4, r4)
+	V4("vec4soa_add"        , vec4soa_add(&s4a, &s4a, &s4b, N)         , vec4_add(a4[i], b4[i]))
+	V4("vec4soa_applymat4"  , vec4soa_applymat4(&s4a, &s4a, &m, N)     , vec4_applymat4(a4[i], &m))
+	V4("vec4soa_lerp"       , vec4soa_lerp(&s4a, &s4a, &s4b, 0.3f, N)  , vec4_lerp(a4[i], b4[i], 0.3f))
+	V4("vec4soa_normal"     , vec4soa_normal(&s4a, &s4a, N)            , vec4_normal(a4[i]))
+	V4("vec4soa_scale"      , vec4soa_scale(&s4a, &s4a, 1.7f, N)       , vec4_scale(a4[i], 1.7f))
+	V4("vec4soa_sub"        , vec4soa_sub(&s4a, &s4a, &s4b, N)         , vec4_sub(a4[i], b4[i]))
+	vec4soa_fromvec4(&s4a, a4, N);
+	vec4soa_fromvec4(&s4b, b4, N);
+	CHKDOT("vec4soa_dot"    , vec4soa_dot(d, &s4a, &s4b, N)            , vec4_dot(a4[i], b4[i]))
+
+	#define Q(name, soa, aos) \
+		CHK4(name, quat, soa, aos, quatsoa_fromquat, quatsoa_toquat, sqa, sqb, aq, bq, rq)
+	Q("quatsoa_lerp"        , quatsoa_lerp(&sqa, &sqa, &sqb, 0.3f, N)  , quat_lerp(aq[i], bq[i], 0.3f))
+	Q("quatsoa_mul"         , quatsoa_mul(&sqa, &sqa, &sqb, N)         , quat_mul(aq[i], bq[i]))
+	Q("quatsoa_nlerp"       , quatsoa_nlerp(&sqa, &sqa, &sqb, 0.3f, N) , quat_nlerp(aq[i], bq[i], 0.3f))
+	Q("quatsoa_normal"      , quatsoa_normal(&sqa, &sqa, N)            , quat_normal(aq[i]))
+	quatsoa_fromquat(&sqa, aq, N);
+	quatsoa_fromquat(&sqb, bq, N);
+	CHKDOT("quatsoa_dot"    , quatsoa_dot(d, &sqa, &sqb, N)            , quat_dot(aq[i], bq[i]))
+
+	#undef CHK3
+	#undef CHK4
+	#undef CHKDOT
+	#undef V4
+	#undef Q
+	printf("structure of arrays %s (%d mismatches)\n", bad ? "FAIL" : "pass", bad);
+	return bad ? 1 : 0;
+}
+
+static float max_diff4(mat4 *a, mat4 *b){
+	float res = 0;
+	for (int i = 0; i < 16; i++){
+		float d = num_abs(a->v[i] - b->v[i]);
+		if (d > res)
+			res = d;
+	}
+	return res;
+}
+
+static int chk_invert(){
+	// compare the affine and rigid inverses against the full mat4_invert
+	float err_affine = 0, err_rigid = 0, err_fast = 0;
+	srand(1);
+	for (int i = 0; i < 1000000; i++){
+		mat4 rigid, scale, affine, ans, est;
+		quat q = quat_normal(quat_new(rndf(), rndf(), rndf(), rndf()));
+		mat4_rottrans(&rigid, q, vec3_new(rndf(), rndf(), rndf()));
+		mat4_scaling(&scale, vec3_new(rndf(), rndf(), rndf()));
+		mat4_mul(&affine, &rigid, &scale);
+		mat4_invert(&ans, &rigid);
+		mat4_invert_rigid(&est, &rigid);
+		float d = max_diff4(&ans, &est);
+		if (d > err_rigid)
+			err_rigid = d;
+		mat4_invert_fast(&est, &rigid);
+		d = max_diff4(&ans, &est);
+		if (d > err_fast)
+			err_fast = d;
+		// affine inverses grow with 1/scale, so compare relative to the largest element
+		if (mat4_invert(&ans, &affine) == NULL)
+			continue;
+		mat4_invert_affine(&est, &affine);
+		float mx = 0;
+		for (int j = 0; j < 16; j++){
+			if (num_abs(ans.v[j]) > mx)
+				mx = num_abs(ans.v[j]);
+		}
+		d = max_diff4(&ans, &est) / mx;
+		if (d > err_affine)
+			err_affine = d;
+		mat4_invert_fast(&est, &affine);
+		d = max_diff4(&ans, &est) / mx;
+		if (d > err_fast)
+			err_fast = d;
+	}
+	printf(
+		"Maximum difference from mat4_invert\n"
+		"-----------------------------------\n"
+		"mat4_invert_rigid : %g\n"
+		"mat4_invert_affine: %g (relative)\n"
+		"mat4_invert_fast  : %g\n",
+		err_rigid, err_affine, err_fast
+	);
+	return err_rigid < 0.001f && err_affine < 0.001f && err_fast < 0.001f ? 0 : 1;
+}
+
+static int chk_affine_kernel(const char *hint, mat4 *(*func)(mat4 *out, mat4 *a, mat4 *b)){
+	// mat4_mul_affine should agree with the C version of mat4_mul, not the dispatched one, which can
+	// be the FMA kernel, and mat4x3 should match the mat4 versions exactly
+	int bad = 0;
+	srand(1);
+	for (int i = 0; i < 100000; i++){
+		mat4 a, b, scale, ans, est, tmp;
+		mat4x3 a3, b3, est3;
+		mat4_rottrans(&a, quat_normal(quat_new(rndf(), rndf(), rndf(), rndf())),
+			vec3_new(rndf(), rndf(), rndf()));
+		mat4_scaling(&scale, vec3_new(rndf(), rndf(), rndf()));
+		ref_mat4_mul(&a, &a, &scale);
+		mat4_rottrans(&b, quat_normal(quat_new(rndf(), rndf(), rndf(), rndf())),
+			vec3_new(rndf(), rndf(), rndf()));
+		ref_mat4_mul(&ans, &a, &b);
+		func(&est, &a, &b);
+		for (int j = 0; j < 16; j++){
+			if (ans.v[j] != est.v[j]){
+				bad++;
+				break;
+			}
+		}
+		// aliasing
+		mat4_copy(&tmp, &a);
+		func(&tmp, &tmp, &b);
+		bad += memcmp(&tmp, &est, sizeof(mat4)) != 0;
+		mat4_copy(&tmp, &b);
+		func(&tmp, &a, &tmp);
+		bad += memcmp(&tmp, &est, sizeof(mat4)) != 0;
+		// mat4x3
+		mat4x3_mat4(&a3, &a);
+		mat4x3_mat4(&b3, &b);
+		mat4x3_mul(&est3, &a3, &b3);
+		mat4_mat4x3(&tmp, &est3);
+		bad += memcmp(&tmp, &est, sizeof(mat4)) != 0;
+		mat4x3_mul(&b3, &a3, &b3);
+		bad += memcmp(&b3, &est3, sizeof(mat4x3)) != 0;
+		mat4_invert_affine(&est, &a);
+		mat4x3_invert(&est3, &a3);
+		mat4_mat4x3(&tmp, &est3);
+		bad += memcmp(&tmp, &est, sizeof(mat4)) != 0;
+		vec3 p = vec3_new(rndf(), rndf(), rndf());
+		vec3 pa = vec3_applymat4(p, &a), pe = vec3_applymat4x3(p, &a3);
+		bad += memcmp(&pa, &pe, sizeof(vec3)) != 0;
+	}
+	printf("%-20s %s (%d mismatches)\n", hint, bad ? "FAIL" : "pass", bad);
+	return bad ? 1 : 0;
+}
+
+static int chk_affine(){
+	int res = chk_affine_kernel("mat4_mul_affine", mat4_mul_affine);
+#ifdef NVQM_SSE2
+	res |= chk_affine_kernel("mat4_mul_affine_sse2", mat4_mul_affine_sse2);
+#endif
+#ifdef NVQM_DISPATCH
+	if (cpu_features() & CPU_AVX)
+		res |= chk_affine_kernel("mat4_mul_affine_avx", mat4_mul_affine_avx);
+	else
+		printf("mat4_mul_affine_avx  skipped (CPU lacks AVX)\n");
+#endif
+	return res;
+}
+
+static void ref_slerp(double *out, quat a, quat b, double t){
+	double x = 0;
+	for (int k = 0; k < 4; k++)
+		x += (double)a.v[k] * b.v[k];
+	double s = 1, s0, s1;
+	if (x < 0){
+		x = -x;
+		s = -1;
+	}
+	if (x > 1)
+		x = 1;
+	double ang = acos(x);
+	if (ang < 1e-12){
+		s0 = 1 - t;
+		s1 = t;
+	}
+	else{
+		s0 = sin((1 - t) * ang) / sin(ang);
+		s1 = sin(t * ang) / sin(ang);
+	}
+	for (int k = 0; k < 4; k++)
+		out[k] = s0 * a.v[k] + s * s1 * b.v[k];
+}
+
+static int chk_slerp(){
+	// compare the polynomial slerp against a double precision slerp, and check that the SIMD and
+	// remainder paths of the array functions agree with each other and with quat_nlerp
+	enum { N = 1000003 };
+	quat *a = malloc(sizeof(quat) * N), *b = malloc(sizeof(quat) * N);
+	quat *r1 = malloc(sizeof(quat) * N), *r2 = malloc(sizeof(quat) * N);
+	float *t = malloc(sizeof(float) * N);
+	if (a == NULL || b == NULL || r1 == NULL || r2 == NULL || t == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (int i = 0; i < N; i++){
+		a[i] = quat_normal(quat_new(rndf(), rndf(), rndf(), rndf()));
+		switch (i % 4){
+			case 0: // nearly the same
+				b[i] = quat_normal(quat_new(a[i].v[0] + rndf() * 1e-5f, a[i].v[1] + rndf() * 1e-5f,
+					a[i].v[2] + rndf() * 1e-5f, a[i].v[3] + rndf() * 1e-5f));
+				break;
+			case 1: // 180 degrees apart
+				b[i] = quat_new(a[i].v[1], -a[i].v[0], a[i].v[3], -a[i].v[2]);
+				break;
+			default:
+				b[i] = quat_normal(quat_new(rndf(), rndf(), rndf(), rndf()));
+				break;
+		}
+		t[i] = (float)rand() / RAND_MAX;
+	}
+	double err_poly = 0, err_libm = 0;
+	quat_slerpv_array(r1, a, b, t, N);
+	for (int i = 0; i < N; i++){
+		double ans[4];
+		ref_slerp(ans, a[i], b[i], t[i]);
+		quat est = quat_slerp(a[i], b[i], t[i]);
+		for (int k = 0; k < 4; k++){
+			double d = fabs(r1[i].v[k] - ans[k]);
+			if (d > err_poly)
+				err_poly = d;
+			d = fabs(est.v[k] - ans[k]);
+			if (d > err_libm)
+				err_libm = d;
+		}
+	}
+	int bad = 0;
+	for (int i = 0; i < N; i++){
+		// one at a time only uses the remainder loop
+		quat_slerpv_array(&r2[i], &a[i], &b[i], &t[i], 1);
+		bad += memcmp(&r1[i], &r2[i], sizeof(quat)) != 0;
+	}
+	quat_slerp_array(r1, a, b, 0.25f, N);
+	for (int i = 0; i < N; i++){
+		quat_slerpv_array(&r2[i], &a[i], &b[i], &(float){ 0.25f }, 1);
+		bad += memcmp(&r1[i], &r2[i], sizeof(quat)) != 0;
+	}
+	quat_nlerpv_array(r1, a, b, t, N);
+	quat_nlerp_array(r2, a, b, 0.25f, N);
+	for (int i = 0; i < N; i++){
+		quat q = quat_nlerp(a[i], b[i], t[i]);
+		bad += memcmp(&r1[i], &q, sizeof(quat)) != 0;
+		q = quat_nlerp(a[i], b[i], 0.25f);
+		bad += memcmp(&r2[i], &q, sizeof(quat)) != 0;
+	}
+	// out == a
+	memcpy(r1, a, sizeof(quat) * N);
+	quat_slerpv_array(r1, r1, b, t, N);
+	quat_slerpv_array(r2, a, b, t, N);
+	bad += memcmp(r1, r2, sizeof(quat) * N) != 0;
+	printf(
+		"Maximum difference from double precision slerp\n"
+		"----------------------------------------------\n"
+		"quat_slerp      : %g\n"
+		"quat_slerp_array: %g\n"
+		"\nMismatched results: %d\n",
+		err_libm, err_poly, bad
+	);
+	free(a);
+	free(b);
+	free(r1);
+	free(r2);
+	free(t);
+	return err_poly < 3e-7 && bad == 0 ? 0 : 1;
+}
+
+static int64_t ulp_diff(float a, float b){
+	int32_t x, y;
+	memcpy(&x, &a, sizeof(x));
+	memcpy(&y, &b, sizeof(y));
+	return x > y ? (int64_t)x - y : (int64_t)y - x;
+}
+
+static int chk_frsqrt(){
+	// num_frsqrt over every float in [1, 4), which covers every mantissa and exponent parity
+	int64_t err_rsqrt = 0;
+	for (uint32_t u = 0x3F800000; u < 0x40800000; u++){
+		float a;
+		memcpy(&a, &u, sizeof(a));
+		int64_t d = ulp_diff(num_frsqrt(a), (float)(1.0 / sqrt((double)a)));
+		if (d > err_rsqrt)
+			err_rsqrt = d;
+	}
+	// compare the fast and exact normals against a double precision normal
+	enum { N = 1000003 };
+	vec3 *a3 = malloc(sizeof(vec3) * N), *r3 = malloc(sizeof(vec3) * N);
+	vec4 *a4 = malloc(sizeof(vec4) * N), *r4 = malloc(sizeof(vec4) * N);
+	float *lanes = malloc(sizeof(float) * N * 7);
+	if (a3 == NULL || r3 == NULL || a4 == NULL || r4 == NULL || lanes == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	srand(1);
+	for (int i = 0; i < N; i++){
+		float s = i % 3 == 0 ? 1e-10f : i % 3 == 1 ? 1.0f : 1e10f;
+		a3[i] = vec3_new(rndf() * s, rndf() * s, rndf() * s);
+		a4[i] = vec4_new(rndf() * s, rndf() * s, rndf() * s, rndf() * s);
+	}
+	a3[0] = vec3_new(0.0f, 0.0f, 0.0f);
+	a4[0] = vec4_new(0.0f, 0.0f, 0.0f, 0.0f);
+	int64_t err_fast = 0, err_exact = 0;
+	for (int i = 0; i < N; i++){
+		double x = a3[i].v[0], y = a3[i].v[1], z = a3[i].v[2];
+		double len = sqrt(x * x + y * y + z * z);
+		if (len == 0)
+			continue;
+		vec3 f = vec3_fnormal(a3[i]), e = vec3_normal(a3[i]);
+		for (int k = 0; k < 3; k++){
+			float ans = (float)(a3[i].v[k] / len);
+			int64_t d = ulp_diff(f.v[k], ans);
+			if (d > err_fast)
+				err_fast = d;
+			d = ulp_diff(e.v[k], ans);
+			if (d > err_exact)
+				err_exact = d;
+		}
+	}
+	// the array and structure of arrays versions should match the per-vector versions exactly
+	int bad = 0;
+	vec3soa s3 = { lanes, lanes + N, lanes + N * 2 };
+	vec4soa s4 = { lanes + N * 3, lanes + N * 4, lanes + N * 5, lanes + N * 6 };
+	vec3_fnormal_array(r3, a3, N);
+	vec4_fnormal_array(r4, a4, N);
+	for (int i = 0; i < N; i++){
+		vec3 f3 = vec3_fnormal(a3[i]);
+		vec4 f4 = vec4_fnormal(a4[i]);
+		bad += memcmp(&r3[i], &f3, sizeof(vec3)) != 0;
+		bad += memcmp(&r4[i], &f4, sizeof(vec4)) != 0;
+	}
+	enum { NQ = 1027 };
+	static quat aq[NQ], rq[NQ];
+	for (int i = 0; i < NQ; i++)
+		aq[i] = quat_new(a4[i].v[0], a4[i].v[1], a4[i].v[2], a4[i].v[3]);
+	quat_fnormal_array(rq, aq, NQ);
+	for (int i = 0; i < NQ; i++){
+		quat fq = quat_fnormal(aq[i]);
+		bad += memcmp(&rq[i], &fq, sizeof(quat)) != 0;
+	}
+	quat_fnormal_array(aq, aq, NQ);
+	bad += memcmp(aq, rq, sizeof(quat) * NQ) != 0;
+	vec3soa_fromvec3(&s3, a3, N);
+	vec4soa_fromvec4(&s4, a4, N);
+	vec3soa_fnormal(&s3, &s3, N);
+	vec4soa_fnormal(&s4, &s4, N);
+	vec3soa_tovec3(a3, &s3, N);
+	vec4soa_tovec4(a4, &s4, N);
+	bad += memcmp(a3, r3, sizeof(vec3) * N) != 0;
+	bad += memcmp(a4, r4, sizeof(vec4) * N) != 0;
+	printf(
+		"Maximum ulp difference from double precision\n"
+		"--------------------------------------------\n"
+		"num_frsqrt  : %d\n"
+		"vec3_fnormal: %d\n"
+		"vec3_normal : %d\n"
+		"\nMismatched results: %d\n",
+		(int)err_rsqrt, (int)err_fast, (int)err_exact, bad
+	);
+	free(a3);
+	free(r3);
+	free(a4);
+	free(r4);
+	free(lanes);
+	return err_rsqrt <= 3 && err_fast <= 4 && bad == 0 ? 0 : 1;
+}
+
+static void ref_hierarchy(mat4 *out, hierarchy *h){
+	// recompute every node from scratch, the way a scene graph would without the hierarchy module
+	for (size_t i = 0; i < h->count; i++){
+		mat4 local;
+		mat4_rottrans(&local,
+			quat_new(h->rot.x[i], h->rot.y[i], h->rot.z[i], h->rot.w[i]),
+			vec3_new(h->pos.x[i], h->pos.y[i], h->pos.z[i]));
+		mat4_scale(&local, &local, vec3_new(h->scale.x[i], h->scale.y[i], h->scale.z[i]));
+		if (h->parent[i] < 0)
+			out[i] = local;
+		else
+			mat4_mul_affine(&out[i], &out[h->parent[i]], &local);
+	}
+}
+
+static void rnd_node(hierarchy *h, size_t i){
+	quat q = quat_normal(quat_new(rndf(), rndf(), rndf(), rndf()));
+	h->pos.x[i] = rndf();
+	h->pos.y[i] = rndf();
+	h->pos.z[i] = rndf();
+	h->rot.x[i] = q.v[0];
+	h->rot.y[i] = q.v[1];
+	h->rot.z[i] = q.v[2];
+	h->rot.w[i] = q.v[3];
+	h->scale.x[i] = 1.0f + rndf() * 0.05f;
+	h->scale.y[i] = 1.0f + rndf() * 0.05f;
+	h->scale.z[i] = 1.0f + rndf() * 0.05f;
+}
+
+static int chk_hierarchy(){
+	// incremental updates should match a full recompute bit for bit
+	const int N = 10000;
+	int *parent = malloc(sizeof(int) * N);
+	float *lanes = malloc(sizeof(float) * N * 10);
+	mat4 *world = malloc(sizeof(mat4) * N);
+	mat4 *ans = malloc(sizeof(mat4) * N);
+	unsigned char *dirty = calloc(N, 1);
+	if (parent == NULL || lanes == NULL || world == NULL || ans == NULL || dirty == NULL){
+		fprintf(stderr, "Out of memory\n");
+		return 1;
+	}
+	hierarchy h = {
+		N, parent,
+		{ lanes        , lanes + N    , lanes + N * 2 },
+		{ lanes + N * 3, lanes + N * 4, lanes + N * 5, lanes + N * 6 },
+		{ lanes + N * 7, lanes + N * 8, lanes + N * 9 },
+		world, dirty
+	};
+	srand(1);
+	for (int i = 0; i < N; i++){
+		// mostly shallow trees, with a few roots and some long chains
+		parent[i] = i == 0 || rand() % 100 == 0 ? -1 : rand() % 4 == 0 ? i - 1 : rand() % i;
+		rnd_node(&h, i);
+	}
+	int bad = 0;
+	hierarchy_updateall(&h);
+	ref_hierarchy(ans, &h);
+	bad += memcmp(world, ans, sizeof(mat4) * N) != 0;
+	for (int r = 0; r < 100; r++){
+		for (int j = 0; j < N / 40; j++){
+			int i = rand() % N;
+			rnd_node(&h, i);
+			dirty[i] = 1;
+		}
+		hierarchy_update(&h);
+		ref_hierarchy(ans, &h);
+		for (int i = 0; i < N; i++){
+			bad += memcmp(&world[i], &ans[i], sizeof(mat4)) != 0;
+			bad += dirty[i] != 0;
+		}
+	}
+	// a parent after its child is rejected
+	parent[N / 2] = N / 2;
+	dirty[N / 2] = 1;
+	bad += hierarchy_update(&h) != NULL;
+	printf("hierarchy_update %s (%d mismatches)\n", bad ? "FAIL" : "pass", bad);
+	free(parent);
+	free(lanes);
+	free(world);
+	free(ans);
+	free(dirty);
+	return bad ? 1 : 0;
+}
+
+static int chk_cull(){
+	// points inside the planes should be inside clip space, and the batched culling should match a
+	// per-object test bit for bit
+	enum { N = 10007 }; // not a multiple of 32, to exercise the remainder loop
+	static float lanes[N * 7];
+	static uint32_t mask[(N + 31) / 32 + 1];
+	vec3soa center = { lanes, lanes + N, lanes + N * 2 };
+	vec3soa bmax = { lanes + N * 3, lanes + N * 4, lanes + N * 5 };
+	float *radius = lanes + N * 6;
+	int bad = 0;
+	srand(1);
+	for (int r = 0; r < 100; r++){
+		mat4 view, proj, vp;
+		if (r & 1)
+			mat4_perspective(&proj, 0.5f + (rndf() + 10.0f) * 0.1f, 16.0f, 9.0f, 0.1f, 100.0f);
+		else
+			mat4_orthogonal(&proj, 20.0f + rndf(), 20.0f + rndf(), 0.1f, 50.0f);
+		mat4_lookat(&view, vec3_new(rndf(), rndf(), rndf()), vec3_new(rndf(), rndf(), rndf()),
+			vec3_new(0.0f, 1.0f, 0.0f));
+		mat4_mul(&vp, &proj, &view);
+		frustum f;
+		frustum_frommat4(&f, &vp);
+		for (int k = 0; k < 6; k++)
+			bad += num_abs(vec3_len(vec3_new(f.v[k].v[0], f.v[k].v[1], f.v[k].v[2])) - 1.0f) > 1e-5f;
+		for (int i = 0; i < N; i++){
+			center.x[i] = rndf() * 5.0f;
+			center.y[i] = rndf() * 5.0f;
+			center.z[i] = rndf() * 5.0f;
+			radius[i] = (rndf() + 10.0f) * 0.2f;
+			bmax.x[i] = center.x[i] + radius[i];
+			bmax.y[i] = center.y[i] + radius[i];
+			bmax.z[i] = center.z[i] + radius[i];
+			// compare against clip space, away from the edges where rounding could go either way
+			vec4 c = vec4_applymat4(vec4_new(center.x[i], center.y[i], center.z[i], 1.0f), &vp);
+			float w = num_abs(c.v[3]), e = w * 1e-4f;
+			float m = num_max(num_abs(c.v[0]), num_max(num_abs(c.v[1]), num_abs(c.v[2])));
+			if (c.v[3] > 0.0f && (m < w - e || m > w + e)){
+				int in = 1;
+				for (int k = 0; k < 6; k++){
+					vec4 p = f.v[k];
+					in &= p.v[0] * center.x[i] + p.v[1] * center.y[i] + p.v[2] * center.z[i] +
+						p.v[3] >= 0.0f;
+				}
+				bad += in != (m < w);
+			}
+		}
+		// spheres
+		mask[(N + 31) / 32] = 0xDEADBEEF; // guard
+		frustum_cullspheres(mask, &f, &center, radius, N);
+		for (int i = 0; i < N; i++){
+			int vis = 1;
+			for (int k = 0; k < 6; k++){
+				vec4 p = f.v[k];
+				vis &= p.v[0] * center.x[i] + p.v[1] * center.y[i] + p.v[2] * center.z[i] +
+					p.v[3] >= -radius[i];
+			}
+			bad += (int)((mask[i / 32] >> (i % 32)) & 1) != vis;
+		}
+		bad += (mask[N / 32] >> (N % 32)) != 0;
+		bad += mask[(N + 31) / 32] != 0xDEADBEEF;
+		// boxes, tested by the corner furthest along each normal
+		frustum_cullaabbs(mask, &f, &center, &bmax, N);
+		for (int i = 0; i < N; i++){
+			int vis = 1;
+			for (int k = 0; k < 6; k++){
+				vec4 p = f.v[k];
+				float
+					x = p.v[0] >= 0.0f ? bmax.x[i] : center.x[i],
+					y = p.v[1] >= 0.0f ? bmax.y[i] : center.y[i],
+					z = p.v[2] >= 0.0f ? bmax.z[i] : center.z[i];
+				vis &= p.v[0] * x + p.v[1] * y + p.v[2] * z + p.v[3] >= 0.0f;
+			}
+			bad += (int)((mask[i / 32] >> (i % 32)) & 1) != vis;
+		}
+		bad += (mask[N / 32] >> (N % 32)) != 0;
+		bad += mask[(N + 31) / 32] != 0xDEADBEEF;
+#ifdef NVQM_SSE2
+		// each kernel directly, since the public functions only use the fastest one
+		static uint32_t mask2[N / 32];
+		float *px[6], *py[6], *pz[6];
+		for (int k = 0; k < 6; k++){
+			px[k] = center.x;
+			py[k] = center.y;
+			pz[k] = center.z;
+		}
+		frustum_cullspheres(mask, &f, &center, radius, N);
+		frustum_cull_sse2(mask2, &f, px, py, pz, radius, N / 32);
+		bad += memcmp(mask, mask2, sizeof(mask2)) != 0;
+#ifdef NVQM_DISPATCH
+		if (cpu_features() & CPU_AVX){
+			frustum_cull_avx(mask2, &f, px, py, pz, radius, N / 32);
+			bad += memcmp(mask, mask2, sizeof(mask2)) != 0;
+		}
+#endif
+#endif
+	}
+	printf("frustum culling %s (%d mismatches)\n", bad ? "FAIL" : "pass", bad);
+	return bad ? 1 : 0;
+}
+
+static int chk_sqrt(){
+	// every non-negative input, and the negatives mirror them (XINTMIN is skipped because the
+	// original recursed forever on it)
+	int64_t bad = 0;
+	int64_t dot = (int64_t)XINTMAX / 75;
 	printf("_________________________________ Progress ________________________________\n");
-	for (int64_t i = a_min; i <= a_max; i += step){
+	for (int64_t i = 0; i <= XINTMAX; i++){
 		if (i % dot == 0){
-			//printf(".");
+			printf(".");
 			fflush(stdout);
 		}
 		xint x = (xint)i;
-		for (int64_t j = b_min; j <= b_max; j += step){
-			xint y = (xint)j;
-			xint est = xint_pow(i, j);
-			xint ans = xint_fromfloat(num_pow(xint_tofloat(x), xint_tofloat(j)));
-			int diff = est - ans;
-			if (diff < 0)
-				diff = -diff;
-			if (diff > max_err)
-				max_err = diff;
+		xint ans = ref_xint_sqrt(x);
+		bad += xint_sqrt(x) != ans;
+		bad += xint_sqrt(-x) != -ans;
+	}
+	printf("\n\nxint_sqrt %s (%lld mismatches)\n", bad ? "FAIL" : "pass", (long long)bad);
+	return bad ? 1 : 0;
+}
+
+static int chk_rsqrt(){
+	// xint_rsqrt should be correctly rounded for every positive input, and normalizing through it
+	// should be no worse than the old xint_div(XINT1, xint_sqrt(len))
+	double err = 0;
+	int64_t bad = 0;
+	int64_t dot = (int64_t)XINTMAX / 75;
+	printf("_________________________________ Progress ________________________________\n");
+	for (int64_t i = 1; i <= XINTMAX; i++){
+		if (i % dot == 0){
+			printf(".");
+			fflush(stdout);
+		}
+		double d = num_abs(xint_rsqrt((xint)i) - 16777216.0 / sqrt((double)i));
+		if (d > err)
+			err = d;
+		bad += d > 0.5 + 1e-6;
+	}
+	bad += xint_rsqrt(0) != XINTMAX;
+	bad += xint_rsqrt(-XINT1) != XINTMAX;
+	double err_new = 0, err_old = 0;
+	srand(1);
+	for (int i = 0; i < 10000000; i++){
+		// components up to 64 so the squared length stays in range
+		int sh = rand() % 10;
+		xvec3 a = xvec3_new(
+			(xint)((rand() % 0x20000 - 0x10000) << 6) >> sh,
+			(xint)((rand() % 0x20000 - 0x10000) << 6) >> sh,
+			(xint)((rand() % 0x20000 - 0x10000) << 6) >> sh);
+		xint len = xvec3_len2(a);
+		if (len < XINT1 / 64) // below a length of 1/8 the squared length has too little precision
+			continue;
+		xvec3 n = xvec3_normal(a);
+		xint inv = xint_div(XINT1, xint_sqrt(len));
+		xvec3 o = xvec3_new(xint_mul(a.v[0], inv), xint_mul(a.v[1], inv), xint_mul(a.v[2], inv));
+		double l = sqrt((double)a.v[0] * a.v[0] + (double)a.v[1] * a.v[1] + (double)a.v[2] * a.v[2]);
+		for (int j = 0; j < 3; j++){
+			double ans = a.v[j] / l * XINT1;
+			double dn = num_abs(n.v[j] - ans), dn_old = num_abs(o.v[j] - ans);
+			if (dn > err_new)
+				err_new = dn;
+			if (dn_old > err_old)
+				err_old = dn_old;
 		}
 	}
 	printf("\n\n"
 		"Results\n"
 		"-----------------------------------\n"
-		"Error Test   : pow(i, j)\n"
-		"Range `i`    : %f to %f\n"
-		"Range `j`    : %f to %f\n"
-		"Step         : %f\n"
-		"Maximum Error: +-%f\n"
-		"               +-%d / %d\n",
-		xint_tofloat(a_min), xint_tofloat(a_max),
-		xint_tofloat(b_min), xint_tofloat(b_max),
-		xint_tofloat(step),
-		xang_todouble(max_err), max_err, XINT1
+		"xint_rsqrt max error  : %g units (%lld not correctly rounded)\n"
+		"xvec3_normal max error: %g units\n"
+		"  with xint_div/sqrt  : %g units\n",
+		err, (long long)bad, err_new, err_old
+	);
+	return bad ? 1 : 0;
+}
+
+static xint rnd_xint(int bits){
+	// a random xint with a magnitude below 2^bits
+	return (xint)(((uint32_t)rand() << 16 ^ (uint32_t)rand()) & ((UINT32_C(1) << bits) - 1)) *
+		(rand() & 1 ? -1 : 1);
+}
+
+static int chk_xdot(){
+	// xint_dot4 and xmat4_mul should be the exact sum of products shifted down once, and be more
+	// accurate than adding xint_mul results (with -DNVQM_XINT_ROUND_EACH, they should match that)
+	int64_t bad = 0;
+	double err_new = 0, err_old = 0;
+	srand(1);
+	for (int i = 0; i < 1000000; i++){
+		xmat4 a, b, res;
+		for (int j = 0; j < 16; j++){
+			a.v[j] = rnd_xint(20);
+			b.v[j] = rnd_xint(20);
+		}
+		xmat4_mul(&res, &a, &b);
+		for (int c = 0; c < 4; c++){
+			for (int r = 0; r < 4; r++){
+				int64_t sum = 0;
+				xint old = 0;
+				for (int k = 0; k < 4; k++){
+					sum += (int64_t)b.v[c * 4 + k] * a.v[k * 4 + r];
+					old = xint_add(old, xint_mul(b.v[c * 4 + k], a.v[k * 4 + r]));
+				}
+#ifdef NVQM_XINT_ROUND_EACH
+				bad += res.v[c * 4 + r] != old;
+#else
+				bad += res.v[c * 4 + r] != (xint)(sum >> 16);
+#endif
+				double ans = (double)sum / XINT1;
+				double dn = num_abs(res.v[c * 4 + r] - ans), dold = num_abs(old - ans);
+				err_new = dn > err_new ? dn : err_new;
+				err_old = dold > err_old ? dold : err_old;
+			}
+		}
+		// wrapping past the 32 bit range should behave like xint_add
+		xint x = rnd_xint(31), y = rnd_xint(31);
+		xint wrap = xint_add(xint_mul(x, y), xint_mul(y, x));
+		bad += xint_dot2(x, y, y, x) != wrap && xint_dot2(x, y, y, x) != xint_add(wrap, 1);
+	}
+	printf(
+		"Results\n"
+		"-----------------------------------\n"
+		"xmat4_mul max error    : %g units\n"
+		"  with xint_mul per term: %g units\n"
+		"xint_dot/xmat4_mul %s (%lld mismatches)\n",
+		err_new, err_old, bad ? "FAIL" : "pass", (long long)bad
+	);
+	return bad ? 1 : 0;
+}
+
+static xlong rnd_xlong(int bits){
+	// a random xlong with a magnitude below 2^bits (bits <= 63)
+	uint64_t v = (uint64_t)(uint32_t)rnd_xint(31) << 33 ^ (uint64_t)(uint32_t)rnd_xint(31) << 2 ^
+		(uint64_t)(rand() & 3);
+	v &= (UINT64_C(1) << bits) - 1;
+	return rand() & 1 ? -(xlong)v : (xlong)v;
+}
+
+static void mul128(uint64_t *hi, uint64_t *lo, xlong a, xlong b){
+	// the signed 128 bit product, from the unsigned one
+	*hi = x_umulhi((uint64_t)a, (uint64_t)b) - (a < 0 ? (uint64_t)b : 0) - (b < 0 ? (uint64_t)a : 0);
+	*lo = (uint64_t)a * (uint64_t)b;
+}
+
+static int chk_xlong(){
+	// xlong_mul, xlong_div, and xlong_sqrt are exact (checked with 128 bit products), and the wide
+	// vector and matrix functions work at scales where the xint versions overflow
+	int64_t bad = 0;
+	double err_dist = 0, err_det3 = 0, err_det4 = 0;
+	int64_t xint_wrong = 0;
+	srand(1);
+	for (int i = 0; i < 2000000; i++){
+		xlong a = rnd_xlong(1 + i % 63), b = rnd_xlong(1 + (i / 63) % 63);
+		uint64_t hi, lo;
+		// xlong_mul is bits 32 to 95 of the product
+		mul128(&hi, &lo, a, b);
+		bad += xlong_mul(a, b) != (xlong)(hi << 32 | lo >> 32);
+		// xlong_div: |q| * |b| <= |a| * 2^32 < (|q| + 1) * |b|, when the quotient fits
+		uint64_t ua = a < 0 ? 0 - (uint64_t)a : (uint64_t)a, ub = b < 0 ? 0 - (uint64_t)b : (uint64_t)b;
+		if (ub != 0 && (ua >> 31) < ub){
+			xlong q = xlong_div(a, b);
+			uint64_t uq = q < 0 ? 0 - (uint64_t)q : (uint64_t)q;
+			uint64_t nhi = ua >> 32, nlo = ua << 32;
+			mul128(&hi, &lo, (xlong)uq, (xlong)ub);
+			bad += hi > nhi || (hi == nhi && lo > nlo);
+			lo += ub;
+			hi += lo < ub;
+			bad += hi < nhi || (hi == nhi && lo <= nlo);
+			bad += q != 0 && (q < 0) != ((a < 0) != (b < 0));
+		}
+		// xlong_sqrt: r^2 <= |a| * 2^32 < (r + 1)^2
+		xlong r = xlong_sqrt(a);
+		uint64_t ur = r < 0 ? 0 - (uint64_t)r : (uint64_t)r;
+		bad += x_sqgt(ur, ua) || (ua != 0 && !x_sqgt(ur + 1, ua)) || (r < 0) != (a < 0);
+	}
+	for (int i = 0; i < 1000000; i++){
+		// positions up to 8192 units from the origin, where xvec3_dist2 overflows, but the squared
+		// distance still fits in an xlong
+		xvec3 p = xvec3_new(rnd_xint(29), rnd_xint(29), rnd_xint(29));
+		xvec3 q = xvec3_new(rnd_xint(29), rnd_xint(29), rnd_xint(29));
+		double dx = (double)p.v[0] - q.v[0], dy = (double)p.v[1] - q.v[1], dz = (double)p.v[2] - q.v[2];
+		double ans = sqrt(dx * dx + dy * dy + dz * dz) * XINT1;
+		double d = num_abs((double)xvec3_distl(p, q) - ans);
+		err_dist = d > err_dist ? d : err_dist;
+		int64_t ix = (int64_t)p.v[0] - q.v[0], iy = (int64_t)p.v[1] - q.v[1],
+			iz = (int64_t)p.v[2] - q.v[2];
+		bad += xvec3_dist2l(p, q) != ix * ix + iy * iy + iz * iz;
+		xint_wrong += num_abs((double)xvec3_dist(p, q) - ans / XINT1) > 2;
+		// determinants of matrices with entries up to 16
+		xmat4 m;
+		for (int j = 0; j < 16; j++)
+			m.v[j] = rnd_xint(20);
+		double m3 =
+			(double)m.v[0] * ((double)m.v[4] * m.v[8] - (double)m.v[5] * m.v[7]) -
+			(double)m.v[1] * ((double)m.v[3] * m.v[8] - (double)m.v[5] * m.v[6]) +
+			(double)m.v[2] * ((double)m.v[3] * m.v[7] - (double)m.v[4] * m.v[6]);
+		xmat3 m3x;
+		memcpy(m3x.v, m.v, sizeof(m3x.v));
+		d = num_abs((double)xmat3_detl(&m3x) - m3 / XINT1);
+		err_det3 = d > err_det3 ? d : err_det3;
+		double c[4][4], det4 = 0;
+		for (int r = 0; r < 4; r++){
+			for (int k = 0; k < 4; k++)
+				c[r][k] = (double)m.v[r * 4 + k] / XINT1;
+		}
+		for (int k = 0; k < 4; k++){
+			// cofactor expansion along the first row
+			int o[3], n = 0;
+			for (int j = 0; j < 4; j++){
+				if (j != k)
+					o[n++] = j;
+			}
+			double minor =
+				c[1][o[0]] * (c[2][o[1]] * c[3][o[2]] - c[2][o[2]] * c[3][o[1]]) -
+				c[1][o[1]] * (c[2][o[0]] * c[3][o[2]] - c[2][o[2]] * c[3][o[0]]) +
+				c[1][o[2]] * (c[2][o[0]] * c[3][o[1]] - c[2][o[1]] * c[3][o[0]]);
+			det4 += (k & 1 ? -1 : 1) * c[0][k] * minor;
+		}
+		d = num_abs((double)xmat4_detl(&m) - det4 * XLONG1);
+		err_det4 = d > err_det4 ? d : err_det4;
+	}
+	// the distance rounds down, and the double reference is a little off at this magnitude
+	bad += err_dist > 1.1 || err_det3 > 3.5 || err_det4 > 6.5;
+	printf(
+		"Results\n"
+		"-----------------------------------\n"
+		"xvec3_distl max error: %g xlong units (xvec3_dist off in %lld cases)\n"
+		"xmat3_detl max error : %g xlong units\n"
+		"xmat4_detl max error : %g xlong units\n"
+		"xlong functions %s (%lld mismatches)\n",
+		err_dist, (long long)xint_wrong, err_det3, err_det4, bad ? "FAIL" : "pass", (long long)bad
+	);
+	return bad ? 1 : 0;
+}
+
+static int chk_xdiv(){
+	// xint_div_by and xint_div_array should match xint_div bit for bit, for every kind of divisor
+	// and numerator
+	enum { N = 1003 };
+	static xint a[N], out[N];
+	static const xint edge[] = {
+		0, 1, -1, 2, -2, 3, XINT1, -XINT1, XINT1 + 1, XINTMAX, XINTMIN, XINTMAX - 1, XINTMIN + 1,
+		0x40000000, -0x40000000, 0x7FFF, 0x8000, 0x8001, 0x10001, 0x55555555, -0x55555555
+	};
+	const int ne = (int)(sizeof(edge) / sizeof(edge[0]));
+	int64_t bad = 0;
+	srand(1);
+	for (int k = 0; k < 200000; k++){
+		xint b = k < ne ? edge[k] : rnd_xint(1 + k % 31);
+		if (b == 0)
+			b = k < ne ? 1 : -1;
+		xrecip r = xrecip_new(b);
+		for (int i = 0; i < N; i++){
+			a[i] = i < ne ? edge[i] : rnd_xint(1 + i % 31);
+			bad += xint_div_by(a[i], &r) != xint_div(a[i], b);
+		}
+		xint_div_array(out, a, b, N);
+		for (int i = 0; i < N; i++)
+			bad += out[i] != xint_div(a[i], b);
+	}
+	// divisors across the whole range, with the edge case numerators
+	for (int64_t b = XINTMIN; b <= XINTMAX; b += 1 + (b & 0xFF)){
+		if (b == 0)
+			continue;
+		xrecip r = xrecip_new((xint)b);
+		for (int i = 0; i < ne; i++)
+			bad += xint_div_by(edge[i], &r) != xint_div(edge[i], (xint)b);
+	}
+	printf("xint_div_by/xint_div_array %s (%lld mismatches)\n", bad ? "FAIL" : "pass",
+		(long long)bad);
+	return bad ? 1 : 0;
+}
+
+static int chk_x2d(){
+	// xvec2_len and xvec2_dist are the xint_sqrt of xvec2_len2, and xmat3x2_invert stays accurate
+	// for transforms whose determinant overflowed as a plain int product (scale above ~0.7)
+	int64_t bad = 0;
+	double err_len = 0, err_inv = 0;
+	srand(1);
+	for (int i = 0; i < 1000000; i++){
+		// components below 64, so xvec2_len2 can't overflow
+		xvec2 a = xvec2_new(rnd_xint(22), rnd_xint(22));
+		xvec2 b = xvec2_new(rnd_xint(21), rnd_xint(21));
+		xint len = xvec2_len(a), dist = xvec2_dist(a, b);
+		bad += len != xint_sqrt(xvec2_len2(a));
+		bad += dist != xint_sqrt(xvec2_len2(xvec2_sub(a, b)));
+		double ans = sqrt((double)xvec2_len2(a) / XINT1) * XINT1;
+		double dl = num_abs(len - ans);
+		err_len = dl > err_len ? dl : err_len;
+		// xint_sqrt matches the original bitwise search, which never sets bit 0x20
+		bad += dl > 64;
+
+		// rotation, scale in [0.5, 2], and translation in [-50, 50]
+		float ang = rndf() * 0.314f;
+		vec2 scale = vec2_new(1.25f + rndf() * 0.075f, 1.25f + rndf() * 0.075f);
+		vec2 trans = vec2_new(rndf() * 5.0f, rndf() * 5.0f);
+		xmat3x2 m = xmat3x2_frommat3x2(
+			mat3x2_translate(mat3x2_scale(mat3x2_rotation(ang), scale), trans));
+		xmat3x2 inv = xmat3x2_invert(m);
+		double v[6], ref[6];
+		for (int k = 0; k < 6; k++)
+			v[k] = (double)m.v[k] / XINT1;
+		double det = v[0] * v[3] - v[1] * v[2];
+		ref[0] =  v[3] / det;
+		ref[1] = -v[1] / det;
+		ref[2] = -v[2] / det;
+		ref[3] =  v[0] / det;
+		ref[4] = (v[5] * v[2] - v[3] * v[4]) / det;
+		ref[5] = (v[1] * v[4] - v[5] * v[0]) / det;
+		for (int k = 0; k < 6; k++){
+			double di = num_abs((double)inv.v[k] / XINT1 - ref[k]) / (1 + num_abs(ref[k]));
+			err_inv = di > err_inv ? di : err_inv;
+			bad += di > 0.001;
+		}
+	}
+	printf(
+		"Results\n"
+		"-----------------------------------\n"
+		"xvec2_len max error     : %g units\n"
+		"xmat3x2_invert max error: %g (relative)\n"
+		"xvec2_len/xmat3x2_invert %s (%lld mismatches)\n",
+		err_len, err_inv, bad ? "FAIL" : "pass", (long long)bad
+	);
+	return bad ? 1 : 0;
+}
+
+static int chk_xarray_run(const char *hint){
+	// compare each fixed-point array function against the inline version, bit for bit, including
+	// values big enough to wrap around
+	enum { N = 10007 }; // odd size to exercise the remainder loops
+	static xvec3 a[N], b[N], out[N];
+	static xquat q[N], r[N], qout[N];
+	int64_t bad = 0;
+	srand(1);
+	for (int i = 0; i < N; i++){
+		int bits = i & 1 ? 31 : 18;
+		a[i] = xvec3_new(rnd_xint(bits), rnd_xint(bits), rnd_xint(bits));
+		b[i] = xvec3_new(rnd_xint(bits), rnd_xint(bits), rnd_xint(bits));
+		q[i] = xquat_new(rnd_xint(bits), rnd_xint(bits), rnd_xint(bits), rnd_xint(bits));
+		r[i] = xquat_new(rnd_xint(17), rnd_xint(17), rnd_xint(17), rnd_xint(17));
+	}
+	q[0] = xquat_new(XINTMIN, XINTMIN, XINTMIN, XINTMIN);
+	xint s = rnd_xint(20);
+	#define CHK(call, expect, n) do {                           \
+			call;                                               \
+			for (int i = 0; i < n; i++){                        \
+				xvec3 e = expect;                               \
+				bad += memcmp(&out[i], &e, sizeof(xvec3)) != 0; \
+			}                                                   \
+		} while (0)
+	CHK(xvec3_add_array(out, a, b, N), xvec3_add(a[i], b[i]), N);
+	CHK(xvec3_sub_array(out, a, b, N), xvec3_sub(a[i], b[i]), N);
+	CHK(xvec3_scale_array(out, a, s, N), xvec3_scale(a[i], s), N);
+	CHK(xvec3_applyquat_array(out, a, r[5], N), xvec3_applyquat(a[i], r[5]), N);
+	CHK(xvec3_applyquatv_array(out, a, q, N), xvec3_applyquat(a[i], q[i]), N);
+	CHK(xvec3_applyquatv_array(out, a, r, 13), xvec3_applyquat(a[i], r[i]), 13);
+	#undef CHK
+	xquat_mul_array(qout, q, r, N);
+	for (int i = 0; i < N; i++){
+		xquat e = xquat_mul(q[i], r[i]);
+		bad += memcmp(&qout[i], &e, sizeof(xquat)) != 0;
+	}
+	// out == a
+	memcpy(out, a, sizeof(a));
+	xvec3_applyquatv_array(out, out, q, N);
+	for (int i = 0; i < N; i++){
+		xvec3 e = xvec3_applyquat(a[i], q[i]);
+		bad += memcmp(&out[i], &e, sizeof(xvec3)) != 0;
+	}
+	memcpy(qout, q, sizeof(q));
+	xquat_mul_array(qout, qout, r, N);
+	for (int i = 0; i < N; i++){
+		xquat e = xquat_mul(q[i], r[i]);
+		bad += memcmp(&qout[i], &e, sizeof(xquat)) != 0;
+	}
+	printf("%-14s %s (%lld mismatches)\n", hint, bad ? "FAIL" : "pass", (long long)bad);
+	return bad ? 1 : 0;
+}
+
+static int chk_xarray(){
+	int res = chk_xarray_run("xarray");
+#ifdef NVQM_DISPATCH
+	// run again with each kernel forced, since the dispatch only picks the widest one
+	#define FORCE(k) (xint_scale_f = xint_scale_##k, xvec3_applyquat_f = xvec3_applyquat_##k, \
+		xvec3_applyquatv_f = xvec3_applyquatv_##k, xquat_mul_f = xquat_mul_##k)
+	FORCE(c);
+	res |= chk_xarray_run("xarray_c");
+	if (cpu_features() & CPU_SSE41){
+		FORCE(sse41);
+		res |= chk_xarray_run("xarray_sse41");
+	}
+	else
+		printf("xarray_sse41   skipped (CPU lacks SSE4.1)\n");
+	if (cpu_features() & CPU_AVX2){
+		FORCE(avx2);
+		res |= chk_xarray_run("xarray_avx2");
+	}
+	else
+		printf("xarray_avx2    skipped (CPU lacks AVX2)\n");
+	#undef FORCE
+#endif
+	return res;
+}
+
+static int chk_lut(){
+	// the table entries for sin, cos, and tan hash to the same value with the full tables and with
+	// -DNVQM_QUARTER_LUT, the functions give exactly the entries at table angles (also with
+	// -DNVQM_XANG16), and angles outside of [0, XANG360) wrap around
+	static const uint32_t full_hash = UINT32_C(0x4B23A89D);
+	uint32_t hash = UINT32_C(2166136261);
+	int64_t bad = 0;
+	for (uint32_t i = 0; i < XANG__LUT; i++){
+		xint v[3] = { xint_sin__at(i), xint_sin__at(i + XANG__LUT / 4), xint_tan__at(i >> 1) };
+		for (int j = 0; j < 3; j++)
+			hash = (hash ^ (uint32_t)v[j]) * UINT32_C(16777619); // FNV-1a, a word at a time
+		xang a = (xang)(i << XANG__SHIFT);
+		bad += xint_sin(a) != v[0] || xint_cos(a) != v[1] || xint_tan(a) != v[2];
+	}
+	for (xang a = 0; a < XANG360; a++){
+		xint v[3] = { xint_sin(a), xint_cos(a), xint_tan(a) };
+		bad += xint_sin(a - XANG360) != v[0] || xint_sin(a + XANG360 * 3) != v[0];
+		bad += xint_cos(a - XANG360) != v[1] || xint_tan(a - XANG360 * 2) != v[2];
+	}
+	bad += hash != full_hash;
+#ifdef NVQM_QUARTER_LUT
+	const char *lut = "quarter wave tables";
+#else
+	const char *lut = "full tables";
+#endif
+	printf("%s: hash 0x%08X, expected 0x%08X\nxint_sin/xint_cos/xint_tan %s (%lld mismatches)\n",
+		lut, hash, full_hash, bad ? "FAIL" : "pass", (long long)bad);
+	return bad ? 1 : 0;
+}
+
+static int err_xang(){
+	// sin and cos for every angle against the exact value, and the largest jump between neighboring
+	// angles, which is what shows up as jitter on slowly rotating objects
+	// compare with -DNVQM_XANG16
+	double max_err = 0, sum_err = 0;
+	int max_step = 0;
+	for (xang a = 0; a < XANG360; a++){
+		double r = xang_todouble(a);
+		double e1 = num_abs(xint_sin(a) - sin(r) * XINT1);
+		double e2 = num_abs(xint_cos(a) - cos(r) * XINT1);
+		max_err = e1 > max_err ? e1 : max_err;
+		max_err = e2 > max_err ? e2 : max_err;
+		sum_err += e1 + e2;
+		int step = xint_abs(xint_sin(a + 1) - xint_sin(a));
+		if (step > max_step)
+			max_step = step;
+	}
+	printf(
+		"Results\n"
+		"-----------------------------------\n"
+		"Angle Bits   : %d (%f degrees per step)\n"
+		"Maximum Error: +-%f / %d units\n"
+		"Average Error: +-%f / %d units\n"
+		"Largest Step : %d units between neighboring angles\n",
+		12 + XANG__SHIFT, 360.0 / XANG360, max_err, XINT1, sum_err / (2.0 * XANG360), XINT1,
+		max_step
 	);
 	return 0;
 }
@@ -169,9 +1549,9 @@ static int gen_sin_lut(){
 	char buf[100];
 	int pos = 4;
 	printf("\t");
-	for (int i = 0; i < XANG360; i++){
-		xint x = xint_fromfloat(num_sin(xang_tofloat(i)));
-		int sz = snprintf(buf, sizeof(buf), i == XANG360 - 1 ? "%d" : "%d, ", x);
+	for (int i = 0; i < XANG__LUT; i++){
+		xint x = xint_fromfloat(num_sin(xang_tofloat(i << XANG__SHIFT)));
+		int sz = snprintf(buf, sizeof(buf), i == XANG__LUT - 1 ? "%d" : "%d, ", x);
 		if (sz + pos > 101){
 			printf("\n\t%s", buf);
 			pos = sz + 4;
@@ -189,9 +1569,9 @@ static int gen_tan_lut(){
 	char buf[100];
 	int pos = 4;
 	printf("\t");
-	for (int i = 0; i < XANG180; i++){
-		xint x = xint_fromfloat(num_tan(xang_tofloat(i)));
-		int sz = snprintf(buf, sizeof(buf), i == XANG180 - 1 ? "%d" : "%d, ", x);
+	for (int i = 0; i < XANG__LUT / 2; i++){
+		xint x = xint_fromfloat(num_tan(xang_tofloat(i << XANG__SHIFT)));
+		int sz = snprintf(buf, sizeof(buf), i == XANG__LUT / 2 - 1 ? "%d" : "%d, ", x);
 		if (sz + pos > 101){
 			printf("\n\t%s", buf);
 			pos = sz + 4;
@@ -208,7 +1588,8 @@ static void print_help(){
 	printf(
 		"NVQM test suite\n\n"
 		"Please select a test via:\n"
-		"  $ ./test <testname> [params...]\n\n"
+		"  $ ./test <testname> [--threads N]\n\n"
+		"The err_ tests except err_pow and err_xang run on N threads, one per CPU by default.\n\n"
 		"Margin of Error Tests:\n\n"
 		"  Test Name     Tested Function   Correct Function\n"
 		"  ---------     ----------------  ----------------\n"
@@ -219,10 +1600,31 @@ static void print_help(){
 		"  err_cos   ->  xint_cos(i)       num_cos(i)\n"
 		"  err_exp   ->  xint_exp(i)       num_exp(i)\n"
 		"  err_log   ->  xint_log(i)       num_log(i)\n"
-		"  err_pow   ->  xint_pow(i, j)    num_pow(i, j)\n"
+		"  err_pow   ->  xint_pow(i, j)    pow(i, j)\n"
 		"  err_sin   ->  xint_sin(i)       num_sin(i)\n"
 		"  err_sqrt  ->  xint_sqrt(i)      num_sqrt(i)\n"
 		"  err_tan   ->  xint_tan(i)       num_tan(i)\n"
+		"  err_xang  ->  sin/cos error and step size for every angle, compare with -DNVQM_XANG16\n\n"
+		"Consistency Tests:\n\n"
+		"  Test Name         Description\n"
+		"  ---------         -----------\n"
+		"  chk_applymat4 ->  vec3_applymat4_array/affine_array match vec3_applymat4 bit for bit\n"
+		"  chk_mat4_mul  ->  SIMD mat4_mul kernels match the C version bit for bit\n"
+		"  chk_soa       ->  structure of arrays functions match the AoS versions\n"
+		"  chk_invert    ->  mat4_invert_affine/rigid/fast agree with mat4_invert\n"
+		"  chk_affine    ->  mat4_mul_affine and mat4x3 agree with the mat4 versions\n"
+		"  chk_slerp     ->  quat_slerp_array error, and array functions are consistent\n"
+		"  chk_frsqrt    ->  num_frsqrt and *_fnormal error, and array functions are consistent\n"
+		"  chk_hierarchy ->  hierarchy_update matches a full recompute\n"
+		"  chk_cull      ->  frustum planes match clip space, and batched culling matches per-object\n"
+		"  chk_sqrt      ->  xint_sqrt matches the original bitwise search for every input\n"
+		"  chk_rsqrt     ->  xint_rsqrt is correctly rounded for every input, and xvec3_normal error\n"
+		"  chk_lut       ->  sin/cos/tan give the same results with -DNVQM_QUARTER_LUT\n"
+		"  chk_xdot      ->  fixed-point sums of products are shifted down once, and their error\n"
+		"  chk_xarray    ->  fixed-point array functions and SIMD kernels match the inline versions\n"
+		"  chk_xdiv      ->  xint_div_by and xint_div_array match xint_div bit for bit\n"
+		"  chk_x2d       ->  xvec2_len/xvec2_dist use xint_sqrt, and xmat3x2_invert doesn't overflow\n"
+		"  chk_xlong     ->  xlong arithmetic is exact, and wide distances/determinants don't overflow\n"
 	);
 }
 
@@ -230,10 +1632,22 @@ static const char *testname;
 bool T(const char *test){ return strcmp(testname, test) == 0; }
 int main(int argc, char **argv){
 	testname = argv[1];
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	threads = cpus > 0 ? (int)cpus : 1;
+	for (int i = 2; i < argc; i++){
+		if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else{
+			fprintf(stderr, "Invalid option: %s\n", argv[i]);
+			return 1;
+		}
+	}
+	if (threads < 1)
+		threads = 1;
 	if (T("err_acos" )) return err_rang("acos" , xint_acos, num_acos,       -XINT1,         XINT1);
 	if (T("err_asin" )) return err_rang("asin" , xint_asin, num_asin,       -XINT1,         XINT1);
 	if (T("err_atan" )) return err_rang("atan" , xint_atan, num_atan,      XINTMIN,       XINTMAX);
-	//if (T("err_atan2")) return err_atan2();
+	if (T("err_atan2")) return err_atan2();
 	if (T("err_cos"  )) return err_aang("cos"  , xint_cos , num_cos ,            0,       XANG360);
 	if (T("err_exp"  )) return err_xint("exp"  , xint_exp , num_exp ,      XINTMIN,    0x000A65AF);
 	if (T("err_log"  )) return err_xint("log"  , xint_log , num_log ,            0,       XINTMAX);
@@ -241,6 +1655,24 @@ int main(int argc, char **argv){
 	if (T("err_sin"  )) return err_aang("sin"  , xint_sin , num_sin ,            0,       XANG360);
 	if (T("err_sqrt" )) return err_xint("sqrt" , xint_sqrt, num_sqrt,            0,       XINTMAX);
 	if (T("err_tan"  )) return err_aang("tan"  , xint_tan , num_tan ,            0,       XANG180);
+	if (T("err_xang" )) return err_xang();
+	if (T("chk_applymat4")) return chk_applymat4();
+	if (T("chk_mat4_mul")) return chk_mat4_mul();
+	if (T("chk_soa"     )) return chk_soa();
+	if (T("chk_invert"  )) return chk_invert();
+	if (T("chk_affine"  )) return chk_affine();
+	if (T("chk_slerp"   )) return chk_slerp();
+	if (T("chk_frsqrt"  )) return chk_frsqrt();
+	if (T("chk_hierarchy")) return chk_hierarchy();
+	if (T("chk_cull"     )) return chk_cull();
+	if (T("chk_sqrt"     )) return chk_sqrt();
+	if (T("chk_rsqrt"    )) return chk_rsqrt();
+	if (T("chk_lut"      )) return chk_lut();
+	if (T("chk_xdot"     )) return chk_xdot();
+	if (T("chk_xarray"   )) return chk_xarray();
+	if (T("chk_xdiv"     )) return chk_xdiv();
+	if (T("chk_x2d"      )) return chk_x2d();
+	if (T("chk_xlong"    )) return chk_xlong();
 	print_help();
 	fprintf(stderr, "Invalid test: %s\n", argv[1]);
 	return 1;